@@ -0,0 +1,927 @@
+#include "benchmark/benchmark.h"
+#include "../src/Orbital_elements_convertion.h"
+#include "../src/Orbital_maneuvers.h"
+#include "../src/Batch_convertion.h"
+#include "../src/Simd_convertion.h"
+#include "../src/Transfer_cost_matrix.h"
+#include "../src/Prepared_orbit.h"
+#include "../src/Bi_elliptic_optimization.h"
+#include "../src/Lambert.h"
+#include "../src/Porkchop.h"
+#include "../src/Kepler_propagation.h"
+#include "../src/Dense.h"
+#include "../src/QR.h"
+#include "../src/State_transition_matrix.h"
+#include "../src/Maneuver_planner.h"
+#include "../src/Combined_transfer.h"
+#include "../src/Catalog_stream.h"
+#include "../src/Orbit_catalog.h"
+#include "../src/Numerical_propagation.h"
+#include "../src/Low_thrust.h"
+#include "../src/Sequencing.h"
+#include "../src/Dual.h"
+#include "../tests/Counting_allocator.h"
+#include <random>
+#include <string>
+#include <fstream>
+#include <filesystem>
+
+
+/// Allocations are reported as allocs/op ///
+static void report(benchmark::State &state, std::size_t items_per_iteration, std::size_t allocations) {
+    state.SetItemsProcessed(state.iterations() * items_per_iteration);
+    state.counters["allocs/op"] = benchmark::Counter(static_cast<double>(allocations) / items_per_iteration,
+                                                     benchmark::Counter::kAvgIterations);
+}
+
+/// Random elliptic inclined orbits ///
+template<typename T>
+COE<T> random_COE(std::mt19937 &gen) {
+    std::uniform_real_distribution<double> radius(6600, 50000), ecc(0.1, 0.6), angle(0, 2 * M_PI), incl(0.1, 3);
+    COE<T> elem;
+    elem.e = ecc(gen);
+    elem.a = radius(gen);
+    elem.p = elem.a * (1 - elem.e * elem.e);
+    elem.i = incl(gen);
+    elem.W = angle(gen);
+    elem.w = angle(gen);
+    elem.nu = angle(gen);
+    elem.u = elem.lam_true = elem.w_true = 10;
+    elem.mu = 398600.4415;
+    elem.flag = 4;
+    return elem;
+}
+
+template<typename T>
+std::vector<std::pair<COE<T>, COE<T>>> random_pairs(std::size_t n) {
+    std::mt19937 gen(42);
+    std::vector<std::pair<COE<T>, COE<T>>> pairs;
+    pairs.reserve(n);
+    for (std::size_t k = 0; k < n; k++) {
+        COE<T> initial = random_COE<T>(gen);
+        pairs.emplace_back(initial, random_COE<T>(gen));
+    }
+    return pairs;
+}
+
+/**
+     * Timing of a maneuver function for one pair of orbits and for a batch of pairs
+     *
+     * state.range(0) - number of pairs, 1 for single evaluation
+     *
+     */
+template<typename T, typename Function>
+void run_maneuver(benchmark::State &state, Function function) {
+    auto pairs = random_pairs<T>(state.range(0));
+    std::size_t allocations = 0;
+    for (auto _: state) {
+        std::size_t before = allocation_count();
+        for (auto &[initial, final]: pairs) benchmark::DoNotOptimize(function(initial, final));
+        allocations += allocation_count() - before;
+    }
+    report(state, pairs.size(), allocations);
+}
+
+/// Random population of elliptic inclined orbits in columns ///
+template<typename T = double>
+struct Population {
+    std::vector<T> p, a, e, i, W, w, nu;
+    std::vector<int> flag;
+
+    explicit Population(std::size_t n) : p(n), a(n), e(n), i(n), W(n), w(n), nu(n), flag(n, 4) {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<double> radius(6600, 50000), ecc(0, 0.9), angle(0, 2 * M_PI), incl(0, M_PI);
+        for (std::size_t k = 0; k < n; k++) {
+            e[k] = ecc(gen);
+            a[k] = radius(gen);
+            p[k] = a[k] * (1 - e[k] * e[k]);
+            i[k] = incl(gen);
+            W[k] = angle(gen);
+            w[k] = angle(gen);
+            nu[k] = angle(gen);
+        }
+    }
+
+    COE_columns<const T> columns() const { return {p, a, e, i, W, w, nu, flag}; }
+};
+
+
+/// Conversions ///
+template<typename T>
+static void BM_RV2COE(benchmark::State &state) {
+    auto pairs = random_pairs<T>(state.range(0));
+    std::vector<std::pair<Vec3<T>, Vec3<T>>> states;
+    for (auto &[initial, final]: pairs) states.push_back(COE2RV(initial));
+    std::size_t allocations = 0;
+    for (auto _: state) {
+        std::size_t before = allocation_count();
+        for (auto &[r, v]: states) benchmark::DoNotOptimize(RV2COE(r, v, T(398600.4415)));
+        allocations += allocation_count() - before;
+    }
+    report(state, states.size(), allocations);
+}
+
+template<typename T>
+static void BM_COE2RV(benchmark::State &state) {
+    run_maneuver<T>(state, [](const COE<T> &initial, const COE<T> &) { return COE2RV(initial); });
+}
+
+template<typename T>
+static void BM_RV2COE_batch(benchmark::State &state) {
+    std::size_t n = state.range(0);
+    auto pairs = random_pairs<T>(n);
+    std::vector<T> x(n), y(n), z(n), vx(n), vy(n), vz(n);
+    for (std::size_t k = 0; k < n; k++) {
+        auto [r, v] = COE2RV(pairs[k].first);
+        x[k] = r[0], y[k] = r[1], z[k] = r[2], vx[k] = v[0], vy[k] = v[1], vz[k] = v[2];
+    }
+    std::vector<T> p(n), a(n), e(n), i(n), W(n), w(n), nu(n);
+    std::vector<int> flag(n);
+    COE_columns<T> elem{p, a, e, i, W, w, nu, flag};
+    bool robust = state.range(1);
+    std::size_t allocations = 0;
+    for (auto _: state) {
+        std::size_t before = allocation_count();
+        if (robust) RV2COE_robust(RV_columns<const T>{x, y, z, vx, vy, vz}, elem, T(398600.4415));
+        else RV2COE(RV_columns<const T>{x, y, z, vx, vy, vz}, elem, T(398600.4415));
+        allocations += allocation_count() - before;
+        benchmark::ClobberMemory();
+    }
+    report(state, n, allocations);
+    state.SetLabel(robust ? "robust" : "thresholds");
+}
+
+template<typename T>
+static void BM_COE2RV_batch(benchmark::State &state) {
+    std::size_t n = state.range(0);
+    auto pairs = random_pairs<T>(n);
+    std::vector<T> p(n), a(n), e(n), i(n), W(n), w(n), nu(n);
+    std::vector<int> flag(n);
+    COE_columns<T> elem{p, a, e, i, W, w, nu, flag};
+    for (std::size_t k = 0; k < n; k++) set_COE(elem, k, pairs[k].first);
+    std::vector<T> x(n), y(n), z(n), vx(n), vy(n), vz(n);
+    std::size_t allocations = 0;
+    for (auto _: state) {
+        std::size_t before = allocation_count();
+        COE2RV(COE_columns<const T>{p, a, e, i, W, w, nu, flag}, RV_columns<T>{x, y, z, vx, vy, vz}, T(398600.4415));
+        allocations += allocation_count() - before;
+        benchmark::ClobberMemory();
+    }
+    report(state, n, allocations);
+}
+
+template<typename T>
+static void BM_EQ2RV(benchmark::State &state) {
+    auto pairs = random_pairs<T>(state.range(0));
+    std::vector<Equinoctial<T>> orbits;
+    for (auto &[initial, final]: pairs) orbits.push_back(COE2EQ(initial));
+    std::size_t allocations = 0;
+    for (auto _: state) {
+        std::size_t before = allocation_count();
+        for (auto &eq: orbits) benchmark::DoNotOptimize(EQ2RV(eq));
+        allocations += allocation_count() - before;
+    }
+    report(state, orbits.size(), allocations);
+}
+
+template<typename T>
+static void BM_EQ2RV_batch(benchmark::State &state) {
+    std::size_t n = state.range(0);
+    auto pairs = random_pairs<T>(n);
+    std::vector<T> p(n), f(n), g(n), h(n), k(n), L(n);
+    std::vector<int> I(n);
+    for (std::size_t m = 0; m < n; m++) {
+        Equinoctial<T> eq = COE2EQ(pairs[m].first);
+        p[m] = eq.p, f[m] = eq.f, g[m] = eq.g, h[m] = eq.h, k[m] = eq.k, L[m] = eq.L, I[m] = eq.I;
+    }
+    std::vector<T> x(n), y(n), z(n), vx(n), vy(n), vz(n);
+    std::size_t allocations = 0;
+    for (auto _: state) {
+        std::size_t before = allocation_count();
+        EQ2RV(EQ_columns<const T>{p, f, g, h, k, L, I}, RV_columns<T>{x, y, z, vx, vy, vz}, T(398600.4415));
+        allocations += allocation_count() - before;
+        benchmark::ClobberMemory();
+    }
+    report(state, n, allocations);
+}
+
+/// Maneuvers ///
+template<typename T>
+static void BM_Hohmann_transfer(benchmark::State &state) {
+    run_maneuver<T>(state, [](const COE<T> &initial, const COE<T> &final) {
+        return Hohmann_transfer(initial, final);
+    });
+}
+
+template<typename T>
+static void BM_Edelbaum_transfer(benchmark::State &state) {
+    run_maneuver<T>(state, [](const COE<T> &initial, const COE<T> &final) {
+        return Edelbaum_transfer(initial, final);
+    });
+}
+
+template<typename T>
+static void BM_Bi_elliptic_transfer_circular_orbits(benchmark::State &state) {
+    run_maneuver<T>(state, [](const COE<T> &initial, const COE<T> &final) {
+        return Bi_elliptic_transfer_circular_orbits(initial, final, 3 * std::max(initial.a, final.a));
+    });
+}
+
+template<typename T>
+static void BM_Bi_elliptic_transfer_elliptic_orbits(benchmark::State &state) {
+    run_maneuver<T>(state, [](const COE<T> &initial, const COE<T> &final) {
+        return Bi_elliptic_transfer_elliptic_orbits(initial, final, 3 * std::max(initial.a, final.a));
+    });
+}
+
+template<typename T>
+static void BM_Two_impulse_transfer_elliptic_orbits(benchmark::State &state) {
+    run_maneuver<T>(state, [](const COE<T> &initial, const COE<T> &final) {
+        return Two_impulse_transfer_elliptic_orbits(initial, final);
+    });
+}
+
+template<typename T>
+static void BM_Inclination_only_transfer(benchmark::State &state) {
+    run_maneuver<T>(state, [](const COE<T> &initial, const COE<T> &final) {
+        return Inclination_only_transfer(initial, final);
+    });
+}
+
+template<typename T>
+static void BM_General_plane_change(benchmark::State &state) {
+    run_maneuver<T>(state, [](const COE<T> &initial, const COE<T> &final) {
+        COE<T> initial_ = initial; // General_plane_change changes true anomaly of initial orbit
+        return General_plane_change(initial_, final);
+    });
+}
+
+/// Maneuvers on prepared orbits ///
+template<typename T, typename Function>
+void run_prepared_maneuver(benchmark::State &state, Function function) {
+    auto pairs = random_pairs<T>(state.range(0));
+    std::vector<std::pair<Prepared_orbit<T>, Prepared_orbit<T>>> prepared;
+    for (auto &[initial, final]: pairs) prepared.emplace_back(Prepared_orbit<T>(initial), Prepared_orbit<T>(final));
+    std::size_t allocations = 0;
+    for (auto _: state) {
+        std::size_t before = allocation_count();
+        for (auto &[initial, final]: prepared) benchmark::DoNotOptimize(function(initial, final));
+        allocations += allocation_count() - before;
+    }
+    report(state, prepared.size(), allocations);
+}
+
+template<typename T>
+static void BM_Hohmann_transfer_prepared(benchmark::State &state) {
+    run_prepared_maneuver<T>(state, [](const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final) {
+        return Hohmann_transfer(initial, final);
+    });
+}
+
+template<typename T>
+static void BM_Edelbaum_transfer_prepared(benchmark::State &state) {
+    run_prepared_maneuver<T>(state, [](const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final) {
+        return Edelbaum_transfer(initial, final);
+    });
+}
+
+template<typename T>
+static void BM_Two_impulse_transfer_prepared(benchmark::State &state) {
+    run_prepared_maneuver<T>(state, [](const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final) {
+        return Two_impulse_transfer_elliptic_orbits(initial, final);
+    });
+}
+
+template<typename T>
+static void BM_Inclination_only_transfer_prepared(benchmark::State &state) {
+    run_prepared_maneuver<T>(state, [](const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final) {
+        return Inclination_only_transfer(initial, final);
+    });
+}
+
+template<typename T>
+static void BM_General_plane_change_prepared(benchmark::State &state) {
+    run_prepared_maneuver<T>(state, [](const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final) {
+        return General_plane_change(initial, final);
+    });
+}
+
+#define ORBITAL_MANEUVERS_BENCHMARK(name) \
+    BENCHMARK_TEMPLATE(name, float)->Arg(1)->Arg(1024); \
+    BENCHMARK_TEMPLATE(name, double)->Arg(1)->Arg(1024)
+
+ORBITAL_MANEUVERS_BENCHMARK(BM_RV2COE);
+ORBITAL_MANEUVERS_BENCHMARK(BM_COE2RV);
+BENCHMARK_TEMPLATE(BM_RV2COE_batch, float)->Args({1024, 0})->Args({1024, 1});
+BENCHMARK_TEMPLATE(BM_RV2COE_batch, double)->Args({1024, 0})->Args({1024, 1});
+BENCHMARK_TEMPLATE(BM_COE2RV_batch, float)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_COE2RV_batch, double)->Arg(1024);
+ORBITAL_MANEUVERS_BENCHMARK(BM_EQ2RV);
+BENCHMARK_TEMPLATE(BM_EQ2RV_batch, float)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_EQ2RV_batch, double)->Arg(1024);
+ORBITAL_MANEUVERS_BENCHMARK(BM_Hohmann_transfer);
+ORBITAL_MANEUVERS_BENCHMARK(BM_Edelbaum_transfer);
+ORBITAL_MANEUVERS_BENCHMARK(BM_Bi_elliptic_transfer_circular_orbits);
+ORBITAL_MANEUVERS_BENCHMARK(BM_Bi_elliptic_transfer_elliptic_orbits);
+ORBITAL_MANEUVERS_BENCHMARK(BM_Two_impulse_transfer_elliptic_orbits);
+ORBITAL_MANEUVERS_BENCHMARK(BM_Inclination_only_transfer);
+ORBITAL_MANEUVERS_BENCHMARK(BM_General_plane_change);
+ORBITAL_MANEUVERS_BENCHMARK(BM_Hohmann_transfer_prepared);
+ORBITAL_MANEUVERS_BENCHMARK(BM_Edelbaum_transfer_prepared);
+ORBITAL_MANEUVERS_BENCHMARK(BM_Two_impulse_transfer_prepared);
+ORBITAL_MANEUVERS_BENCHMARK(BM_Inclination_only_transfer_prepared);
+ORBITAL_MANEUVERS_BENCHMARK(BM_General_plane_change_prepared);
+
+/// Gradient of delta-v with respect to elements of both orbits, dual numbers and central finite differences ///
+static void BM_Delta_v_gradient(benchmark::State &state) {
+    auto pairs = random_pairs<double>(1024);
+    auto two_impulse = [](const auto &a, const auto &b) { return Two_impulse_transfer_elliptic_orbits(a, b); };
+    bool dual = state.range(0) == 0;
+    for (auto _: state) {
+        for (auto &[initial, final]: pairs) {
+            if (dual) {
+                benchmark::DoNotOptimize(Delta_v_gradient(two_impulse, initial, final));
+                continue;
+            }
+            std::array<double, 12> gradient;
+            for (int j = 0; j < 12; j++) {
+                COE<double> plus[2] = {initial, final}, minus[2] = {initial, final};
+                auto variable = [&](COE<double> &elem) -> double & {
+                    double *variables[6] = {&elem.a, &elem.e, &elem.i, &elem.W, &elem.w, &elem.nu};
+                    return *variables[j % 6];
+                };
+                const double h = j % 6 == 0 ? 1e-4 * variable(plus[j / 6]) : 1e-6;
+                variable(plus[j / 6]) += h;
+                variable(minus[j / 6]) -= h;
+                for (COE<double> &elem: {std::ref(plus[j / 6]), std::ref(minus[j / 6])})
+                    elem.p = elem.a * (1 - elem.e * elem.e);
+                gradient[j] = (two_impulse(plus[0], plus[1]) - two_impulse(minus[0], minus[1])) / (2 * h);
+            }
+            benchmark::DoNotOptimize(gradient);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * pairs.size());
+}
+
+BENCHMARK(BM_Delta_v_gradient)->Arg(0)->Arg(1);
+
+/// Optimal bi-elliptic transfer, loop of scalar Brent's searches and batch search per number of threads ///
+static void BM_Optimal_bi_elliptic_transfer_elliptic_orbits(benchmark::State &state) {
+    auto pairs = random_pairs<double>(1024);
+    std::vector<Prepared_orbit<double>> initial, final;
+    for (auto &[from, to]: pairs) {
+        initial.emplace_back(from);
+        final.emplace_back(to);
+    }
+    const unsigned n_threads = state.range(0);
+    Thread_pool pool(std::max(n_threads, 1u));
+    for (auto _: state) {
+        if (n_threads) {
+            benchmark::DoNotOptimize(Optimal_bi_elliptic_transfer_elliptic_orbits(initial, final, 1e6, pool));
+        } else {
+            for (std::size_t k = 0; k < initial.size(); k++)
+                benchmark::DoNotOptimize(Optimal_bi_elliptic_transfer_elliptic_orbits(initial[k], final[k], 1e6));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * initial.size());
+    state.SetLabel(n_threads ? "batch" : "scalar");
+}
+
+BENCHMARK(BM_Optimal_bi_elliptic_transfer_elliptic_orbits)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+/// Cost matrix per number of threads ///
+static void BM_Transfer_cost_matrix(benchmark::State &state) {
+    std::size_t n = 512;
+    auto pairs = random_pairs<double>(n);
+    std::vector<COE<double>> initial, final;
+    for (auto &[from, to]: pairs) {
+        initial.push_back(from);
+        final.push_back(to);
+    }
+    Thread_pool pool(state.range(0));
+    for (auto _: state) {
+        double sum = 0;
+        std::mutex sum_mutex;
+        Transfer_cost_matrix(initial, final, Maneuver::Two_impulse, [&](const Cost_tile<double> &tile) {
+            double tile_sum = 0;
+            for (double cost: tile.cost) tile_sum += cost;
+            std::lock_guard lock(sum_mutex);
+            sum += tile_sum;
+        }, pool);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+}
+
+BENCHMARK(BM_Transfer_cost_matrix)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+
+/// Lambert's problem, cold start and porkchop plot per number of threads ///
+static void BM_Lambert(benchmark::State &state) {
+    double mu = 398600.4415;
+    Vec3<double> r1(5000, 10000, 2100), r2(-14600, 2500, 7000);
+    double tof = 3600;
+    for (auto _: state) {
+        benchmark::DoNotOptimize(r1);
+        benchmark::DoNotOptimize(Lambert(r1, r2, tof, mu));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Lambert);
+
+static void BM_Porkchop(benchmark::State &state) {
+    double mu = 398600.4415;
+    auto circular = [mu](double radius, double phase) {
+        double n = std::sqrt(mu / (radius * radius * radius));
+        return [=](double t) {
+            return std::pair(Vec3<double>(radius * cos(n * t + phase), radius * sin(n * t + phase), 0),
+                             Vec3<double>(-n * radius * sin(n * t + phase), n * radius * cos(n * t + phase), 0));
+        };
+    };
+    auto departure_ephemeris = circular(7000, 0), arrival_ephemeris = circular(42164, 1);
+    std::vector<double> departure(256), tof(256);
+    for (std::size_t i = 0; i < departure.size(); i++) departure[i] = 60.0 * i;
+    for (std::size_t j = 0; j < tof.size(); j++) tof[j] = 3600 + 60.0 * j;
+
+    Thread_pool pool(state.range(0));
+    for (auto _: state)
+        benchmark::DoNotOptimize(Porkchop(departure_ephemeris, arrival_ephemeris, departure, tof, mu, pool));
+    state.SetItemsProcessed(state.iterations() * departure.size() * tof.size());
+}
+
+BENCHMARK(BM_Porkchop)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+/// Q-law low-thrust transfers of random circular orbits per number of threads ///
+static void BM_Qlaw_transfer(benchmark::State &state) {
+    double mu = 398600.4415;
+    std::mt19937 gen(23);
+    std::uniform_real_distribution<double> radius(6800, 12000), angle(0, 2 * M_PI), incl(0.1, 1.5), delta(-0.1, 0.1);
+    std::vector<Low_thrust_scenario<double>> scenarios(16);
+    for (auto &[initial, final, thruster]: scenarios) {
+        double i = incl(gen), W = angle(gen), a0 = radius(gen), a1 = radius(gen);
+        initial = {a0, a0, 0, i, W, 0, 0, 0, angle(gen), 10, mu, 2};
+        final = {a1, a1, 0, i + delta(gen), W + delta(gen), 0, 0, 0, 0, 10, mu, 2};
+        thruster = {.thrust = 1, .mass = 1000, .Isp = 3000};
+    }
+    Thread_pool pool(state.range(0));
+    std::size_t steps = 0;
+    for (auto _: state) {
+        auto transfers = Qlaw_transfer(scenarios, pool);
+        for (auto &transfer: transfers) steps += transfer.steps;
+        benchmark::DoNotOptimize(transfers.data());
+    }
+    state.SetItemsProcessed(state.iterations() * scenarios.size());
+    state.counters["steps/s"] = benchmark::Counter(static_cast<double>(steps), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_Qlaw_transfer)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+/// Sequencing of 100 targets with drifting nodes per number of threads: hit rate and evaluations of the oracle ///
+static void BM_Sequence_targets(benchmark::State &state) {
+    double mu = 398600.4415;
+    std::mt19937 gen(31);
+    std::uniform_real_distribution<double> radius(6900, 8000), angle(0, 2 * M_PI), incl(0.8, 1.0);
+    std::vector<COE<double>> orbits;
+    for (int k = 0; k < 100; k++) {
+        double a = radius(gen);
+        orbits.push_back({a, a, 0.001, incl(gen), angle(gen), angle(gen), angle(gen), 10, 10, 10, mu, 4});
+    }
+    Sequencing_options<double> options;
+    options.leg_time = 5 * 86400;
+    Thread_pool pool(state.range(0));
+    Sequencing_statistics statistics;
+    double delta_v = 0;
+    for (auto _: state) {
+        auto sequence = Sequence_targets(orbits, Drifting_transfer_cost<double>{}, pool, options);
+        statistics.lookups += sequence.statistics.lookups;
+        statistics.evaluations += sequence.statistics.evaluations;
+        statistics.seconds += sequence.statistics.seconds;
+        delta_v = sequence.delta_v;
+    }
+    state.counters["delta_v"] = delta_v;
+    state.counters["hit_rate"] = statistics.hit_rate();
+    state.counters["evals/s"] = statistics.evaluations_per_second();
+    state.counters["lookups/s"] = statistics.lookups_per_second();
+}
+
+BENCHMARK(BM_Sequence_targets)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/// Batch COE2RV per instruction set ///
+template<typename T>
+static void BM_COE2RV_simd(benchmark::State &state) {
+    auto level = static_cast<Simd_level>(state.range(0));
+    if (level > supported_simd_level()) {
+        state.SkipWithError("instruction set is not supported by CPU");
+        return;
+    }
+    std::size_t n = 4096;
+    Population<T> population(n);
+    std::size_t allocations = 0;
+    std::vector<T> x(n), y(n), z(n), vx(n), vy(n), vz(n);
+    RV_columns<T> rv{x, y, z, vx, vy, vz};
+    for (auto _: state) {
+        std::size_t before = allocation_count();
+        COE2RV_simd(population.columns(), rv, T(398600.4415), level);
+        allocations += allocation_count() - before;
+        benchmark::DoNotOptimize(x.data());
+        benchmark::ClobberMemory();
+    }
+    report(state, n, allocations);
+    state.SetLabel(level == Simd_level::scalar ? "scalar" : (level == Simd_level::avx2 ? "avx2" : "avx512"));
+}
+
+BENCHMARK_TEMPLATE(BM_COE2RV_simd, float)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK_TEMPLATE(BM_COE2RV_simd, double)->Arg(0)->Arg(1)->Arg(2);
+
+/// COE2RV of mixed types of orbits, runtime flag per orbit and partition by type ///
+static void BM_COE2RV_mixed_kinds(benchmark::State &state) {
+    std::size_t n = 4096;
+    std::mt19937 gen(42);
+    std::vector<COE<double>> catalog(n);
+    for (auto &elem: catalog) {
+        elem = random_COE<double>(gen);
+        elem.flag = 1 + gen() % 4;
+        elem.u = elem.lam_true = elem.nu;
+        elem.w_true = elem.w;
+    }
+    COE_partition<double> partition = Partition_by_kind(catalog);
+    std::vector<double> x(n), y(n), z(n), vx(n), vy(n), vz(n);
+    RV_columns<double> rv{x, y, z, vx, vy, vz};
+    bool partitioned = state.range(0);
+    for (auto _: state) {
+        if (partitioned) {
+            COE2RV(partition, rv);
+        } else {
+            for (std::size_t k = 0; k < n; k++) {
+                auto [r, v] = COE2RV(catalog[k]);
+                x[k] = r[0], y[k] = r[1], z[k] = r[2], vx[k] = v[0], vy[k] = v[1], vz[k] = v[2];
+            }
+        }
+        benchmark::DoNotOptimize(x.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetLabel(partitioned ? "partitioned" : "runtime flag");
+}
+
+BENCHMARK(BM_COE2RV_mixed_kinds)->Arg(0)->Arg(1);
+
+/// Kepler's equation solves per second, one by one and batch per instruction set ///
+static void BM_Eccentric_anomaly(benchmark::State &state) {
+    Population<> population(1024);
+    for (auto _: state) {
+        for (std::size_t k = 0; k < population.e.size(); k++)
+            benchmark::DoNotOptimize(Eccentric_anomaly(population.nu[k], population.e[k]));
+    }
+    state.SetItemsProcessed(state.iterations() * population.e.size());
+}
+
+BENCHMARK(BM_Eccentric_anomaly);
+
+static void BM_Kepler_propagation_batch(benchmark::State &state) {
+    auto level = static_cast<Simd_level>(state.range(0));
+    if (level > supported_simd_level()) {
+        state.SkipWithError("instruction set is not supported by CPU");
+        return;
+    }
+    std::size_t n = 1024, n_epochs = 64;
+    Population<> population(n);
+    std::vector<double> dt(n_epochs), nu(n * n_epochs);
+    for (std::size_t j = 0; j < n_epochs; j++) dt[j] = 600.0 * j;
+    for (auto _: state) {
+        Kepler_propagation(population.columns(), dt, nu, 398600.4415, level);
+        benchmark::DoNotOptimize(nu.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n * n_epochs);
+    state.SetLabel(level == Simd_level::scalar ? "scalar" : (level == Simd_level::avx2 ? "avx2" : "avx512"));
+}
+
+BENCHMARK(BM_Kepler_propagation_batch)->Arg(0)->Arg(1)->Arg(2);
+
+/// Numerical propagation with J2: integrator steps per second, one by one (-1) and batch per instruction set ///
+static void BM_Numerical_propagation(benchmark::State &state) {
+    const int mode = static_cast<int>(state.range(0));
+    const auto n = static_cast<std::size_t>(state.range(1));
+    auto level = static_cast<Simd_level>(std::max(mode, 0));
+    if (level > supported_simd_level()) {
+        state.SkipWithError("instruction set is not supported by CPU");
+        return;
+    }
+    std::mt19937 gen(19);
+    std::vector<double> x0(n), y0(n), z0(n), vx0(n), vy0(n), vz0(n), x(n), y(n), z(n), vx(n), vy(n), vz(n);
+    for (std::size_t k = 0; k < n; k++) {
+        auto [r, v] = COE2RV(random_COE<double>(gen));
+        x0[k] = r[0], y0[k] = r[1], z0[k] = r[2], vx0[k] = v[0], vy0[k] = v[1], vz0[k] = v[2];
+    }
+    const Force_model<double> model;
+    const double dt = 3600;
+    std::size_t steps = 0;
+    for (auto _: state) {
+        if (mode < 0) {
+            for (std::size_t k = 0; k < n; k++) {
+                auto solution = Numerical_propagation(Vec3<double>{x0[k], y0[k], z0[k]},
+                                                      Vec3<double>{vx0[k], vy0[k], vz0[k]}, dt, model);
+                steps += solution.steps + solution.rejected;
+                benchmark::DoNotOptimize(solution);
+            }
+        } else {
+            auto statistics = Numerical_propagation<double>({x0, y0, z0, vx0, vy0, vz0}, dt,
+                                                            {x, y, z, vx, vy, vz}, model, {}, level);
+            steps += statistics.steps + statistics.rejected;
+            benchmark::DoNotOptimize(x.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.counters["steps/s"] = benchmark::Counter(static_cast<double>(steps), benchmark::Counter::kIsRate);
+    state.SetLabel(mode < 0 ? "one by one" : (level == Simd_level::scalar ? "scalar" :
+                                               (level == Simd_level::avx2 ? "avx2" : "avx512")));
+}
+
+BENCHMARK(BM_Numerical_propagation)->ArgsProduct({{-1, 0, 1, 2}, {8, 64, 512}});
+
+/// Matrix products: blocked multiply_into against the naive triple loop, and fixed-size 6x6 ///
+static void BM_Dense_multiply(benchmark::State &state) {
+    int n = static_cast<int>(state.range(0));
+    bool blocked = state.range(1);
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> value(-1, 1);
+    Dense<double> a{n, n}, b{n, n}, c{n, n};
+    for (int i = 0; i < n; i++) for (int j = 0; j < n; j++) a(i, j) = value(gen), b(i, j) = value(gen);
+    for (auto _: state) {
+        if (blocked) multiply_into(a, b, c);
+        else {
+            for (int i = 0; i < n; i++) {
+                for (int k = 0; k < n; k++) {
+                    double sum = 0;
+                    for (int j = 0; j < n; j++) sum += a(i, j) * b(j, k);
+                    c(i, k) = sum;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(c.data());
+        benchmark::ClobberMemory();
+    }
+    state.counters["flops"] = benchmark::Counter(2.0 * n * n * n, benchmark::Counter::kIsIterationInvariantRate);
+    state.SetLabel(blocked ? "blocked" : "naive");
+}
+
+BENCHMARK(BM_Dense_multiply)->ArgsProduct({{6, 64, 256, 512}, {0, 1}});
+
+static void BM_Dense_fixed_covariance(benchmark::State &state) {
+    Dense<double, 6, 6> stm, covariance = Dense<double, 6, 6>::identity(), tmp, propagated;
+    for (int i = 0; i < 6; i++) for (int j = 0; j < 6; j++) stm(i, j) = std::sin(i + 2.0 * j);
+    std::size_t allocations = allocation_count();
+    for (auto _: state) {
+        multiply_into(stm, covariance, tmp);
+        multiply_into(tmp, stm.transposed(), propagated);
+        benchmark::DoNotOptimize(propagated.data());
+        benchmark::ClobberMemory();
+    }
+    report(state, 1, allocation_count() - allocations);
+}
+
+BENCHMARK(BM_Dense_fixed_covariance);
+
+/// Linear solve: blocked and unblocked QR against naive Gaussian elimination with partial pivoting ///
+static Dense<double> Gaussian_elimination(Dense<double> a, Dense<double> b) {
+    int n = a.get_height();
+    for (int c = 0; c < n; c++) {
+        int pivot = c;
+        for (int r = c + 1; r < n; r++) if (std::abs(a(r, c)) > std::abs(a(pivot, c))) pivot = r;
+        for (int j = 0; j < n; j++) std::swap(a(c, j), a(pivot, j));
+        for (int j = 0; j < b.get_width(); j++) std::swap(b(c, j), b(pivot, j));
+        for (int r = c + 1; r < n; r++) {
+            double f = a(r, c) / a(c, c);
+            for (int j = c; j < n; j++) a(r, j) -= f * a(c, j);
+            for (int j = 0; j < b.get_width(); j++) b(r, j) -= f * b(c, j);
+        }
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        for (int j = 0; j < b.get_width(); j++) {
+            for (int p = i + 1; p < n; p++) b(i, j) -= a(i, p) * b(p, j);
+            b(i, j) /= a(i, i);
+        }
+    }
+    return b;
+}
+
+static void BM_Linear_solve(benchmark::State &state) {
+    int n = static_cast<int>(state.range(0)), method = static_cast<int>(state.range(1));
+    std::mt19937 gen(12);
+    std::uniform_real_distribution<double> value(-1, 1);
+    Dense<double> a{n, n}, b{n, 1};
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) a(i, j) = value(gen);
+        b(i, 0) = value(gen);
+    }
+    for (auto _: state) {
+        if (method == 0) benchmark::DoNotOptimize(Gaussian_elimination(a, b));
+        else benchmark::DoNotOptimize(Least_squares(QR_factorization(a, method == 1 ? 1 : 32), b));
+    }
+    state.SetLabel(method == 0 ? "gauss" : (method == 1 ? "qr_unblocked" : "qr_blocked"));
+}
+
+BENCHMARK(BM_Linear_solve)->ArgsProduct({{6, 64, 256, 512}, {0, 1, 2}});
+
+static void BM_Least_squares(benchmark::State &state) {
+    int m = 2000, n = static_cast<int>(state.range(0));
+    std::mt19937 gen(12);
+    std::uniform_real_distribution<double> value(-1, 1);
+    Dense<double> a{m, n}, b{m, 1};
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++) a(i, j) = value(gen);
+        b(i, 0) = value(gen);
+    }
+    for (auto _: state) benchmark::DoNotOptimize(Least_squares(QR_factorization(a), b));
+}
+
+BENCHMARK(BM_Least_squares)->Arg(6)->Arg(64)->Arg(256);
+
+static void BM_Inverse_6x6(benchmark::State &state) {
+    Dense<double, 6, 6> stm;
+    for (int i = 0; i < 6; i++) for (int j = 0; j < 6; j++) stm(i, j) = std::sin(i + 2.0 * j) + (i == j ? 3 : 0);
+    for (auto _: state) {
+        benchmark::DoNotOptimize(stm);
+        benchmark::DoNotOptimize(Inverse(stm));
+    }
+}
+
+BENCHMARK(BM_Inverse_6x6);
+
+/// State transition matrices per second, from elements and from RV vectors, and covariance propagation ///
+static void BM_State_transition_matrix(benchmark::State &state) {
+    bool from_rv = state.range(0);
+    std::vector<COE<double>> elements(1024);
+    std::vector<std::pair<Vec3<double>, Vec3<double>>> rv(elements.size());
+    std::mt19937 gen(13);
+    for (std::size_t k = 0; k < elements.size(); k++) {
+        elements[k] = random_COE<double>(gen);
+        rv[k] = COE2RV(elements[k]);
+    }
+    std::size_t allocations = allocation_count();
+    for (auto _: state) {
+        for (std::size_t k = 0; k < elements.size(); k++) {
+            if (from_rv) benchmark::DoNotOptimize(State_transition_matrix(rv[k].first, rv[k].second, 3000.0,
+                                                                          398600.4415));
+            else benchmark::DoNotOptimize(State_transition_matrix(elements[k], 3000.0));
+        }
+    }
+    report(state, elements.size(), allocation_count() - allocations);
+    state.SetLabel(from_rv ? "rv" : "elements");
+}
+
+BENCHMARK(BM_State_transition_matrix)->Arg(0)->Arg(1);
+
+static void BM_Covariance_propagation(benchmark::State &state) {
+    std::size_t n = 1024;
+    std::mt19937 gen(13);
+    std::vector<Dense<double, 6, 6>> stm(n), covariance(n, Dense<double, 6, 6>::identity()), result(n);
+    for (std::size_t k = 0; k < n; k++) stm[k] = State_transition_matrix(random_COE<double>(gen), 3000.0).stm;
+    for (auto _: state) {
+        Covariance_propagation<double>(stm, covariance, result);
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_Covariance_propagation);
+
+/// Planner: plans per second with and without pruning, share of the searches, skipped by lower bounds ///
+static void BM_Plan_transfer(benchmark::State &state) {
+    Planner_options<double> options;
+    options.prune = state.range(0);
+    std::mt19937 gen(14);
+    std::uniform_real_distribution<double> radius(6600, 50000), angle(0, 2 * M_PI), incl(0, 0.5);
+    std::vector<Prepared_orbit<double>> initial, final;
+    for (int k = 0; k < 256; k++) { // coplanar elliptic and non-coplanar circular pairs
+        COE<double> elem1 = random_COE<double>(gen), elem2 = random_COE<double>(gen);
+        elem2.i = elem1.i, elem2.W = elem1.W;
+        if (k % 2) {
+            for (COE<double> *elem: {&elem1, &elem2}) {
+                elem->e = 0, elem->a = elem->p = radius(gen), elem->i = incl(gen), elem->u = angle(gen);
+                elem->flag = 2;
+            }
+        }
+        initial.emplace_back(elem1);
+        final.emplace_back(elem2);
+    }
+    Planner_statistics statistics;
+    for (auto _: state) {
+        for (std::size_t k = 0; k < initial.size(); k++)
+            benchmark::DoNotOptimize(Plan_transfer(initial[k], final[k], options, &statistics));
+    }
+    state.SetItemsProcessed(state.iterations() * initial.size());
+    state.counters["pruned"] = static_cast<double>(statistics.pruned) / static_cast<double>(statistics.searches);
+    state.SetLabel(options.prune ? "pruning" : "exhaustive");
+}
+
+BENCHMARK(BM_Plan_transfer)->Arg(0)->Arg(1);
+
+/// Combined transfer: pairs per second, one by one and in lockstep batch ///
+static void BM_Combined_transfer(benchmark::State &state) {
+    std::mt19937 gen(15);
+    std::vector<Prepared_orbit<double>> initial, final;
+    for (int k = 0; k < 1024; k++) {
+        initial.emplace_back(random_COE<double>(gen));
+        final.emplace_back(random_COE<double>(gen));
+    }
+    for (auto _: state) {
+        if (state.range(0)) benchmark::DoNotOptimize(Combined_transfer(initial, final));
+        else {
+            for (std::size_t k = 0; k < initial.size(); k++)
+                benchmark::DoNotOptimize(Combined_transfer(initial[k], final[k]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * initial.size());
+    state.SetLabel(state.range(0) ? "batch" : "scalar");
+}
+
+BENCHMARK(BM_Combined_transfer)->Arg(0)->Arg(1);
+
+/// Catalog stream: bytes per second of OEM text to Keplerian elements, getline and std::stod baseline ///
+static std::string OEM_file() {
+    static const std::string path = [] {
+        std::string path_ = (std::filesystem::temp_directory_path() / "benchmark_catalog.oem").string();
+        std::mt19937 gen(16);
+        std::FILE *oem = std::fopen(path_.c_str(), "w");
+        for (int k = 0; k < 200000; k++) {
+            COE<double> elem = random_COE<double>(gen);
+            auto [r, v] = COE2RV(elem);
+            std::fprintf(oem, "2024-01-01T00:00:00.000 %.16e %.16e %.16e %.16e %.16e %.16e\n", r[0], r[1], r[2],
+                         v[0], v[1], v[2]);
+        }
+        std::fclose(oem);
+        return path_;
+    }();
+    return path;
+}
+
+static void BM_Catalog_stream(benchmark::State &state) {
+    const std::string path = OEM_file();
+    Thread_pool pool(state.range(0));
+    double sum = 0;
+    for (auto _: state) {
+        Mapped_file file(path);
+        Convert_catalog(file, Catalog_format::OEM, 398600.4415, [&](const Catalog_chunk<double> &chunk) {
+            for (std::size_t k = 0; k < chunk.size; k++) sum += chunk.a[k];
+        }, pool);
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(path));
+    state.SetLabel(std::to_string(state.range(0)) + " threads");
+}
+
+BENCHMARK(BM_Catalog_stream)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_Catalog_getline(benchmark::State &state) {
+    const std::string path = OEM_file();
+    double sum = 0;
+    for (auto _: state) {
+        std::ifstream in(path);
+        std::string line, epoch;
+        while (std::getline(in, line)) {
+            std::size_t pos = line.find(' '), next;
+            std::vector<double> r(3), v(3);
+            for (int c = 0; c < 6; c++, pos += next) (c < 3 ? r[c] : v[c - 3]) = std::stod(line.substr(pos), &next);
+            sum += RV2COE(r, v, 398600.4415).a;
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(path));
+}
+
+BENCHMARK(BM_Catalog_getline)->Unit(benchmark::kMillisecond);
+
+/// Orbit catalog: startup from catalog file (open and one pass over a column) and from re-conversion of states ///
+static void BM_Orbit_catalog(benchmark::State &state) {
+    const std::size_t n = 200000;
+    std::mt19937 gen(17);
+    std::vector<double> x(n), y(n), z(n), vx(n), vy(n), vz(n), p(n), a(n), e(n), i(n), W(n), w(n), nu(n);
+    std::vector<int> flag(n);
+    for (std::size_t k = 0; k < n; k++) {
+        auto [r, v] = COE2RV(random_COE<double>(gen));
+        x[k] = r[0], y[k] = r[1], z[k] = r[2], vx[k] = v[0], vy[k] = v[1], vz[k] = v[2];
+    }
+    const std::string path = (std::filesystem::temp_directory_path() / "benchmark_catalog.orb").string();
+    RV2COE<double>({x, y, z, vx, vy, vz}, {p, a, e, i, W, w, nu, flag}, 398600.4415);
+    Write_orbit_catalog<double>(path, COE_columns<const double>{p, a, e, i, W, w, nu, flag}, 398600.4415);
+    double sum = 0;
+    for (auto _: state) {
+        if (state.range(0)) {
+            Orbit_catalog<double> catalog(path);
+            for (double a_: catalog.a()) sum += a_;
+        } else {
+            RV2COE<double>({x, y, z, vx, vy, vz}, {p, a, e, i, W, w, nu, flag}, 398600.4415);
+            for (double a_: a) sum += a_;
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetLabel(state.range(0) ? "catalog file" : "RV2COE");
+}
+
+BENCHMARK(BM_Orbit_catalog)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,351 @@
+#ifndef ORBITAL_MANEUVERS_BATCH_CONVERTION_H
+#define ORBITAL_MANEUVERS_BATCH_CONVERTION_H
+
+#include <span>
+#include <array>
+#include <vector>
+#include <variant>
+#include <cstddef>
+#include <algorithm>
+#include <numbers>
+#include <limits>
+#include <type_traits>
+#include "Orbital_elements_convertion.h"
+
+
+/**
+     * Structure of arrays of RV vectors
+     *
+     * @param:
+     * x, y, z - coordinates of R vectors
+     * vx, vy, vz - coordinates of V vectors
+     *
+     * T may be const-qualified for input columns, all columns have the same size
+     *
+     */
+template<typename T>
+struct RV_columns {
+    std::span<T> x, y, z;
+    std::span<T> vx, vy, vz;
+
+    std::size_t size() const { return x.size(); }
+};
+
+/**
+     * Structure of arrays of Keplerian elements
+     *
+     * Angles are stored so, that the conversion back to RV vectors does not depend on flag:
+     * W - right ascension (0 for equatorial orbits)
+     * w - argument of perigee for elliptic inclined orbits, true longitude of periapsis for elliptic equatorial orbits,
+     *     0 for circular orbits
+     * nu - true anomaly for elliptic orbits, argument of latitude for circular inclined orbits,
+     *      true longitude for circular equatorial orbits
+     * flag - type of orbit, same as in COE
+     *
+     * T may be const-qualified for input columns, all columns have the same size
+     *
+     */
+template<typename T>
+struct COE_columns {
+    std::span<T> p, a, e, i, W, w, nu;
+    std::span<std::conditional_t<std::is_const_v<T>, const int, int>> flag;
+
+    std::size_t size() const { return p.size(); }
+};
+
+/**
+     * Reading one element of Keplerian elements columns
+     *
+     * @param: Keplerian elements columns, index of element, gravitational parameter
+     * @return Structure of Keplerian elements, undefined elements are assigned to 10 as in RV2COE
+     *
+     */
+template<typename T>
+COE<std::remove_const_t<T>> get_COE(const COE_columns<T> &elem, std::size_t k, std::remove_const_t<T> mu) {
+    COE<std::remove_const_t<T>> res{elem.p[k], elem.a[k], elem.e[k], elem.i[k], 10, 10, 10, 10, 10, 10, mu, elem.flag[k]};
+    if (res.flag == 1) res.lam_true = elem.nu[k];
+    if (res.flag == 2) {
+        res.W = elem.W[k];
+        res.u = elem.nu[k];
+    }
+    if (res.flag == 3) {
+        res.w_true = elem.w[k];
+        res.nu = elem.nu[k];
+    }
+    if (res.flag == 4) {
+        res.W = elem.W[k];
+        res.w = elem.w[k];
+        res.nu = elem.nu[k];
+    }
+    return res;
+}
+
+/**
+     * Writing one element of Keplerian elements columns
+     *
+     * @param: Keplerian elements columns, index of element, Structure of Keplerian elements
+     *
+     */
+template<typename T>
+void set_COE(const COE_columns<T> &elem, std::size_t k, const COE<T> &value) {
+    elem.p[k] = value.p;
+    elem.a[k] = value.a;
+    elem.e[k] = value.e;
+    elem.i[k] = value.i;
+    elem.flag[k] = value.flag;
+    elem.W[k] = (value.flag == 2 || value.flag == 4) ? value.W : 0;
+    elem.w[k] = value.flag == 3 ? value.w_true : (value.flag == 4 ? value.w : 0);
+    elem.nu[k] = value.flag == 1 ? value.lam_true : (value.flag == 2 ? value.u : value.nu);
+}
+
+namespace detail {
+    template<typename T>
+    inline T angle_from_cos(T cos_, bool flip) { // angle in [0, 2pi), cos_ is clamped against rounding
+        T angle = std::acos(std::clamp(cos_, T(-1), T(1)));
+        return flip ? 2 * std::numbers::pi_v<T> - angle : angle;
+    }
+}
+
+/**
+     * Batch conversion of RV vectors to Keplerian elements
+     *
+     * Classification of the orbit is the same as in RV2COE, but all branches are computed and
+     * selected by masks, so that the loop has no data-dependent control flow
+     * @param: RV vectors columns, output Keplerian elements columns, gravitational parameter
+     *
+     */
+template<typename T>
+void RV2COE(const RV_columns<const T> &rv, const COE_columns<T> &elem, T mu) {
+    const std::size_t n_ = rv.size();
+    for (std::size_t k = 0; k < n_; k++) {
+        const T rx = rv.x[k], ry = rv.y[k], rz = rv.z[k];
+        const T vx = rv.vx[k], vy = rv.vy[k], vz = rv.vz[k];
+
+        const T hx = ry * vz - rz * vy, hy = rz * vx - rx * vz, hz = rx * vy - ry * vx; // angular momentum
+        const T nx = -hy, ny = hx; // ascending node, z coordinate is 0
+        const T r_norm = std::sqrt(rx * rx + ry * ry + rz * rz);
+        const T v2 = vx * vx + vy * vy + vz * vz;
+        const T rv_ = rx * vx + ry * vy + rz * vz;
+        const T ex = (rx * (v2 - mu / r_norm) - vx * rv_) / mu; // eccentricity vector
+        const T ey = (ry * (v2 - mu / r_norm) - vy * rv_) / mu;
+        const T ez = (rz * (v2 - mu / r_norm) - vz * rv_) / mu;
+
+        const T h2 = hx * hx + hy * hy + hz * hz;
+        const T n_norm = std::sqrt(nx * nx + ny * ny);
+        const T e_norm = std::sqrt(ex * ex + ey * ey + ez * ez);
+
+        const bool elliptic = !(e_norm < T(1e-1));
+        const bool inclined = elliptic ? (n_norm > T(1e-4)) : (n_norm != 0);
+
+        // denominators are kept positive, values computed for undefined cases are masked out below
+        const T n_safe = std::max(n_norm, std::numeric_limits<T>::min());
+        const T e_safe = std::max(e_norm, std::numeric_limits<T>::min());
+
+        const T W = detail::angle_from_cos(nx / n_safe, ny < 0);
+        const T w = detail::angle_from_cos((nx * ex + ny * ey) / (n_safe * e_safe), ez < 0);
+        const T w_true = detail::angle_from_cos(ex / e_safe, ey < 0);
+        const T nu = detail::angle_from_cos((ex * rx + ey * ry + ez * rz) / (e_safe * r_norm), rv_ < 0);
+        const T u = detail::angle_from_cos((nx * rx + ny * ry) / (n_safe * r_norm), rz < 0);
+        const T lam_true = detail::angle_from_cos(rx / r_norm, ry < 0);
+
+        elem.p[k] = h2 / mu;
+        elem.a[k] = -mu / (2 * (v2 / 2 - mu / r_norm));
+        elem.e[k] = e_norm;
+        elem.i[k] = std::acos(std::clamp(hz / std::sqrt(h2), T(-1), T(1)));
+        elem.W[k] = inclined ? W : 0;
+        elem.w[k] = elliptic ? (inclined ? w : w_true) : 0;
+        elem.nu[k] = elliptic ? nu : (inclined ? u : lam_true);
+        elem.flag[k] = 1 + int(inclined) + 2 * int(elliptic);
+    }
+}
+
+/**
+     * Batch conversion of RV vectors to Keplerian elements without classification thresholds in the angles
+     *
+     * Same elements as RV2COE_robust, the type of orbit only selects, which angles are written to the columns,
+     * so the loop is straight-line code
+     * @param: RV vectors columns, output Keplerian elements columns, gravitational parameter, tolerance of EQ2COE
+     *
+     */
+template<typename T>
+void RV2COE_robust(const RV_columns<const T> &rv, const COE_columns<T> &elem, T mu,
+                   T tol = std::sqrt(std::numeric_limits<T>::epsilon())) {
+    const std::size_t n_ = rv.size();
+    for (std::size_t k = 0; k < n_; k++) {
+        const Equinoctial<T> eq = RV2EQ(Vec3<T>{rv.x[k], rv.y[k], rv.z[k]}, Vec3<T>{rv.vx[k], rv.vy[k], rv.vz[k]}, mu);
+        const auto q = detail::Angles_of(eq);
+        const bool elliptic = q.e > tol, inclined = q.sin_i > tol;
+        const T node = inclined ? eq.I * q.W : 0; // angles from axis f of the origins of w and nu in the columns
+        const T periapsis = elliptic ? q.lon_periapsis : node;
+
+        elem.p[k] = eq.p;
+        elem.a[k] = eq.p / (1 - q.e * q.e);
+        elem.e[k] = q.e;
+        elem.i[k] = q.i;
+        elem.W[k] = inclined ? q.W : 0;
+        elem.w[k] = elliptic ? detail::wrap_angle(periapsis - node) : 0;
+        elem.nu[k] = detail::wrap_angle(eq.L - periapsis);
+        elem.flag[k] = 1 + int(inclined) + 2 * int(elliptic);
+    }
+}
+
+/**
+     * Structure of arrays of modified equinoctial elements
+     *
+     * @param:
+     * p, f, g, h, k, L - elements as in Equinoctial
+     * I - retrograde factor
+     *
+     * T may be const-qualified for input columns, all columns have the same size
+     *
+     */
+template<typename T>
+struct EQ_columns {
+    std::span<T> p, f, g, h, k, L;
+    std::span<std::conditional_t<std::is_const_v<T>, const int, int>> I;
+
+    std::size_t size() const { return p.size(); }
+};
+
+/**
+     * Batch conversion of RV vectors to modified equinoctial elements
+     *
+     * @param: RV vectors columns, output equinoctial elements columns, gravitational parameter
+     *
+     */
+template<typename T>
+void RV2EQ(const RV_columns<const T> &rv, const EQ_columns<T> &eq, T mu) {
+    const std::size_t n_ = rv.size();
+    for (std::size_t m = 0; m < n_; m++) {
+        const Equinoctial<T> res = RV2EQ(Vec3<T>{rv.x[m], rv.y[m], rv.z[m]}, Vec3<T>{rv.vx[m], rv.vy[m], rv.vz[m]}, mu);
+        eq.p[m] = res.p, eq.f[m] = res.f, eq.g[m] = res.g;
+        eq.h[m] = res.h, eq.k[m] = res.k, eq.L[m] = res.L;
+        eq.I[m] = res.I;
+    }
+}
+
+/**
+     * Batch conversion of modified equinoctial elements to RV vectors
+     *
+     * One sine and one cosine per orbit, the loop is straight-line code
+     * @param: equinoctial elements columns, output RV vectors columns, gravitational parameter
+     *
+     */
+template<typename T>
+void EQ2RV(const EQ_columns<const T> &eq, const RV_columns<T> &rv, T mu) {
+    const std::size_t n_ = eq.size();
+    for (std::size_t m = 0; m < n_; m++) {
+        const auto [r, v] = EQ2RV(Equinoctial<T>{eq.p[m], eq.f[m], eq.g[m], eq.h[m], eq.k[m], eq.L[m], mu, eq.I[m]});
+        rv.x[m] = r[0], rv.y[m] = r[1], rv.z[m] = r[2];
+        rv.vx[m] = v[0], rv.vy[m] = v[1], rv.vz[m] = v[2];
+    }
+}
+
+/**
+     * Batch conversion of Keplerian elements to RV vectors
+     *
+     * Angles in columns already account for the type of orbit, so the loop is straight-line code
+     * @param: Keplerian elements columns, output RV vectors columns, gravitational parameter
+     *
+     */
+template<typename T>
+void COE2RV(const COE_columns<const T> &elem, const RV_columns<T> &rv, T mu) {
+    const std::size_t n_ = elem.size();
+    for (std::size_t k = 0; k < n_; k++) {
+        const T p = elem.p[k], e = elem.e[k], nu = elem.nu[k];
+        const T cos_nu = std::cos(nu), sin_nu = std::sin(nu);
+        const T cos_W = std::cos(elem.W[k]), sin_W = std::sin(elem.W[k]);
+        const T cos_w = std::cos(elem.w[k]), sin_w = std::sin(elem.w[k]);
+        const T cos_i = std::cos(elem.i[k]), sin_i = std::sin(elem.i[k]);
+
+        const T r_p = p * cos_nu / (1 + e * cos_nu); // R and V vectors in perifocal coordinate system
+        const T r_q = p * sin_nu / (1 + e * cos_nu);
+        const T sqrt_mu_p = std::sqrt(mu / p);
+        const T v_p = -sqrt_mu_p * sin_nu;
+        const T v_q = sqrt_mu_p * (e + cos_nu);
+
+        const T Px = cos_W * cos_w - sin_W * sin_w * cos_i; // first two columns of the matrix of coordinate transformations
+        const T Py = sin_W * cos_w + cos_W * sin_w * cos_i;
+        const T Pz = sin_w * sin_i;
+        const T Qx = -cos_W * sin_w - sin_W * cos_w * cos_i;
+        const T Qy = -sin_W * sin_w + cos_W * cos_w * cos_i;
+        const T Qz = cos_w * sin_i;
+
+        rv.x[k] = Px * r_p + Qx * r_q;
+        rv.y[k] = Py * r_p + Qy * r_q;
+        rv.z[k] = Pz * r_p + Qz * r_q;
+        rv.vx[k] = Px * v_p + Qx * v_q;
+        rv.vy[k] = Py * v_p + Qy * v_q;
+        rv.vz[k] = Pz * v_p + Qz * v_q;
+    }
+}
+
+/**
+     * Keplerian elements partitioned by type of orbit
+     *
+     * Every type is stored contiguously with only its elements, index keeps positions of the orbits
+     * in the original sequence (index[kind - 1][k] for k-th orbit of the kind)
+     *
+     */
+template<typename T>
+struct COE_partition {
+    std::vector<COE<T, Orbit_kind::Circular_equatorial>> circular_equatorial;
+    std::vector<COE<T, Orbit_kind::Circular_inclined>> circular_inclined;
+    std::vector<COE<T, Orbit_kind::Elliptic_equatorial>> elliptic_equatorial;
+    std::vector<COE<T, Orbit_kind::Elliptic_inclined>> elliptic_inclined;
+    std::array<std::vector<std::size_t>, 4> index;
+
+    std::size_t size() const {
+        return circular_equatorial.size() + circular_inclined.size() + elliptic_equatorial.size() +
+               elliptic_inclined.size();
+    }
+};
+
+/**
+     * Partition of Keplerian elements by type of orbit
+     *
+     * @param: Keplerian elements
+     * @return COE_partition
+     *
+     */
+template<typename T>
+COE_partition<T> Partition_by_kind(const std::vector<COE<T>> &elem) {
+    COE_partition<T> res;
+    for (std::size_t k = 0; k < elem.size(); k++) {
+        std::visit([&](const auto &typed) {
+            using Typed = std::decay_t<decltype(typed)>;
+            if constexpr (Typed::kind == Orbit_kind::Circular_equatorial) res.circular_equatorial.push_back(typed);
+            if constexpr (Typed::kind == Orbit_kind::Circular_inclined) res.circular_inclined.push_back(typed);
+            if constexpr (Typed::kind == Orbit_kind::Elliptic_equatorial) res.elliptic_equatorial.push_back(typed);
+            if constexpr (Typed::kind == Orbit_kind::Elliptic_inclined) res.elliptic_inclined.push_back(typed);
+            res.index[int(Typed::kind) - 1].push_back(k);
+        }, to_typed(elem[k]));
+    }
+    return res;
+}
+
+/**
+     * Batch conversion of partitioned Keplerian elements to RV vectors
+     *
+     * Every type of orbit is converted by its own loop of straight-line code, RV vectors are written
+     * to the original positions of the orbits
+     * @param: partitioned Keplerian elements, output RV vectors columns of size elem.size()
+     *
+     */
+template<typename T>
+void COE2RV(const COE_partition<T> &elem, const RV_columns<T> &rv) {
+    auto convert = [&](const auto &orbits, const std::vector<std::size_t> &index) {
+        for (std::size_t k = 0; k < orbits.size(); k++) {
+            const auto [r, v] = COE2RV(orbits[k]);
+            const std::size_t m = index[k];
+            rv.x[m] = r[0], rv.y[m] = r[1], rv.z[m] = r[2];
+            rv.vx[m] = v[0], rv.vy[m] = v[1], rv.vz[m] = v[2];
+        }
+    };
+    convert(elem.circular_equatorial, elem.index[0]);
+    convert(elem.circular_inclined, elem.index[1]);
+    convert(elem.elliptic_equatorial, elem.index[2]);
+    convert(elem.elliptic_inclined, elem.index[3]);
+}
+
+#endif //ORBITAL_MANEUVERS_BATCH_CONVERTION_H
@@ -0,0 +1,149 @@
+#ifndef ORBITAL_MANEUVERS_BI_ELLIPTIC_OPTIMIZATION_H
+#define ORBITAL_MANEUVERS_BI_ELLIPTIC_OPTIMIZATION_H
+
+#include <thread>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstddef>
+#include "Orbital_maneuvers.h"
+#include "Prepared_orbit.h"
+#include "Solvers.h"
+#include "Thread_pool.h"
+
+
+/**
+     * Result of the search of the intermediate radius of bi-elliptic transfer
+     *
+     * @param:
+     * r_b - apogee radius of transfer orbits, that minimizes delta-v of bi-elliptic transfer
+     * delta_v - delta-v of bi-elliptic transfer with r_b
+     * direct_delta_v - delta-v of Hohmann transfer for circular orbits, of two impulse transfer for elliptic orbits
+     * (delta-v of elliptic orbits is the sum of magnitudes of the burns, Bi_elliptic_burns and Two_impulse_burns)
+     * use_bi_elliptic - true, if bi-elliptic transfer is cheaper than direct one
+     *
+     */
+template<typename T>
+struct Bi_elliptic_optimum {
+    T r_b;
+    T delta_v;
+    T direct_delta_v;
+    bool use_bi_elliptic;
+};
+
+/**
+     * Ratio of radii of circular orbits, below which Hohmann transfer is cheaper than any bi-elliptic one
+     *
+     * Root of the equation delta-v(Hohmann) = delta-v(bi-elliptic, r_b -> infinity), see Vallado
+     *
+     */
+template<typename T>
+inline constexpr T bi_elliptic_ratio_threshold = T(11.938765472645);
+
+/**
+     * Optimal bi-elliptic transfer for circular orbits
+     *
+     * Delta-v of bi-elliptic transfer between circular orbits has no interior minimum on [max(r1, r2), r_b_max]:
+     * it grows from Hohmann's value for radii ratio below bi_elliptic_ratio_threshold and has one maximum
+     * above it. So only the ends of the segment are compared and no search is needed
+     * @param: Keplerian elements of initial and final orbits, upper bound of apogee radius of transfer orbit
+     * @return Bi_elliptic_optimum
+     *
+     */
+template<typename T>
+Bi_elliptic_optimum<T> Optimal_bi_elliptic_transfer_circular_orbits(const COE<T> &initial, const COE<T> &final,
+                                                                   T r_b_max) {
+    T hohmann = Hohmann_transfer(initial, final);
+    T r_min = std::min(initial.a, final.a), r_max = std::max(initial.a, final.a);
+    if (r_max / r_min < bi_elliptic_ratio_threshold<T> || r_b_max <= r_max) return {r_max, hohmann, hohmann, false};
+
+    T delta_v = Bi_elliptic_transfer_circular_orbits(initial, final, r_b_max);
+    if (delta_v < hohmann) return {r_b_max, delta_v, hohmann, true};
+    return {r_max, hohmann, hohmann, false};
+}
+
+/**
+     * Optimal bi-elliptic transfer for elliptic orbits
+     *
+     * Brent's minimization of Bi_elliptic_burns over log(r_a) on [max(|r1|, |r2|), r_a_max], the ends of the segment
+     * are checked too. Direct transfer is Two_impulse_burns
+     * @param: prepared initial and final orbits, upper bound of apogee radius of transfer orbit,
+     * relative tolerance of r_a
+     * @return Bi_elliptic_optimum
+     *
+     */
+template<typename T>
+Bi_elliptic_optimum<T> Optimal_bi_elliptic_transfer_elliptic_orbits(const Prepared_orbit<T> &initial,
+                                                                   const Prepared_orbit<T> &final, T r_a_max,
+                                                                   T tol = T(1e-8)) {
+    T direct = Two_impulse_burns(initial, final);
+    T r_low = std::max(initial.r_norm, final.r_norm);
+    r_a_max = std::max(r_a_max, r_low);
+    auto delta_v = [&](T log_r) { return Bi_elliptic_burns(initial, final, std::exp(log_r)); };
+
+    auto [log_r, best] = Brent_minimize(delta_v, std::log(r_low), std::log(r_a_max), tol);
+    T r_a = std::exp(log_r);
+    for (T end: {r_low, r_a_max}) {
+        T end_delta_v = Bi_elliptic_burns(initial, final, end);
+        if (end_delta_v < best) best = end_delta_v, r_a = end;
+    }
+    return {r_a, best, direct, best < direct};
+}
+
+template<typename T>
+Bi_elliptic_optimum<T> Optimal_bi_elliptic_transfer_elliptic_orbits(const COE<T> &initial, const COE<T> &final,
+                                                                   T r_a_max, T tol = T(1e-8)) {
+    return Optimal_bi_elliptic_transfer_elliptic_orbits(Prepared_orbit<T>(initial), Prepared_orbit<T>(final),
+                                                        r_a_max, tol);
+}
+
+/**
+     * Optimal bi-elliptic transfer for many pairs of circular orbits
+     *
+     * @param: Keplerian elements of initial and final orbits of pairs, upper bound of apogee radius of transfer orbit
+     * @return Bi_elliptic_optimum of every pair
+     *
+     */
+template<typename T>
+std::vector<Bi_elliptic_optimum<T>> Optimal_bi_elliptic_transfer_circular_orbits(const std::vector<COE<T>> &initial,
+                                                                                const std::vector<COE<T>> &final,
+                                                                                T r_b_max) {
+    std::vector<Bi_elliptic_optimum<T>> result(initial.size());
+    for (std::size_t k = 0; k < initial.size(); k++)
+        result[k] = Optimal_bi_elliptic_transfer_circular_orbits(initial[k], final[k], r_b_max);
+    return result;
+}
+
+/**
+     * Optimal bi-elliptic transfer for many pairs of elliptic orbits
+     *
+     * Pairs are spread over the threads of the pool in blocks of pairs, every pair is searched by the scalar Brent's
+     * search, so results are the same as the ones of the loop over pairs. Every pair uses gravitational parameter
+     * of its initial orbit
+     * @param: prepared initial and final orbits of pairs, upper bound of apogee radius of transfer orbit,
+     * thread pool, relative tolerance of r_a
+     * @return Bi_elliptic_optimum of every pair
+     *
+     */
+template<typename T>
+std::vector<Bi_elliptic_optimum<T>> Optimal_bi_elliptic_transfer_elliptic_orbits(
+        const std::vector<Prepared_orbit<T>> &initial, const std::vector<Prepared_orbit<T>> &final, T r_a_max,
+        Thread_pool &pool, T tol = T(1e-8)) {
+    const std::size_t n = initial.size(), block = 64; // a block takes ~0.1 ms, so handing it out costs nothing
+    std::vector<Bi_elliptic_optimum<T>> result(n);
+    pool.parallel_for((n + block - 1) / block, [&](std::size_t task, unsigned) {
+        for (std::size_t k = task * block; k < std::min(n, (task + 1) * block); k++)
+            result[k] = Optimal_bi_elliptic_transfer_elliptic_orbits(initial[k], final[k], r_a_max, tol);
+    });
+    return result;
+}
+
+template<typename T>
+std::vector<Bi_elliptic_optimum<T>> Optimal_bi_elliptic_transfer_elliptic_orbits(
+        const std::vector<Prepared_orbit<T>> &initial, const std::vector<Prepared_orbit<T>> &final, T r_a_max,
+        T tol = T(1e-8)) {
+    Thread_pool pool(std::thread::hardware_concurrency());
+    return Optimal_bi_elliptic_transfer_elliptic_orbits(initial, final, r_a_max, pool, tol);
+}
+
+#endif //ORBITAL_MANEUVERS_BI_ELLIPTIC_OPTIMIZATION_H
@@ -0,0 +1,271 @@
+#ifndef ORBITAL_MANEUVERS_CATALOG_STREAM_H
+#define ORBITAL_MANEUVERS_CATALOG_STREAM_H
+
+#include <array>
+#include <vector>
+#include <string>
+#include <charconv>
+#include <system_error>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <cstddef>
+#include <numbers>
+#include <algorithm>
+#include <utility>
+#include "Batch_convertion.h"
+#include "Simd_convertion.h"
+#include "Kepler_propagation.h"
+#include "Thread_pool.h"
+#include "Mapped_file.h"
+
+
+/**
+     * Formats of state catalogs
+     *
+     * OEM - CCSDS Orbit Ephemeris Message in text form, data lines "epoch x y z vx vy vz", km and km/s,
+     *       header, metadata, comments and covariance lines are skipped
+     * TLE - two-line element sets, only the second lines are used. Mean elements are taken as osculating ones
+     *
+     */
+enum class Catalog_format {
+    OEM,
+    TLE
+};
+
+/**
+     * Chunk of a catalog in structure of arrays
+     *
+     * Columns grow, when a chunk has more records than any chunk before it, and are reused for the next chunks
+     * @param:
+     * x, y, z, vx, vy, vz - RV vectors
+     * p, a, e, i, W, w, nu, flag - Keplerian elements, layout of COE_columns
+     * size - number of records in the chunk
+     *
+     */
+template<typename T>
+struct Catalog_chunk {
+    std::vector<T> x, y, z, vx, vy, vz;
+    std::vector<T> p, a, e, i, W, w, nu;
+    std::vector<int> flag;
+    std::size_t size = 0;
+
+    std::size_t capacity() const { return x.size(); }
+
+    // room for one more record
+    void reserve_next() {
+        if (size < capacity()) return;
+        const std::size_t capacity_ = std::max<std::size_t>(2 * capacity(), 1024);
+        for (std::vector<T> *column: {&x, &y, &z, &vx, &vy, &vz, &p, &a, &e, &i, &W, &w, &nu})
+            column->resize(capacity_);
+        flag.resize(capacity_);
+    }
+
+    RV_columns<T> rv() {
+        return {{x.data(), size}, {y.data(), size}, {z.data(), size},
+                {vx.data(), size}, {vy.data(), size}, {vz.data(), size}};
+    }
+
+    COE_columns<T> elem() {
+        return {{p.data(), size}, {a.data(), size}, {e.data(), size}, {i.data(), size}, {W.data(), size},
+                {w.data(), size}, {nu.data(), size}, {flag.data(), size}};
+    }
+};
+
+namespace detail {
+    // number after spaces and tabs, pos is moved past it
+    template<typename T>
+    inline bool Parse_number(const char *&pos, const char *end, T &value) {
+        while (pos < end && (*pos == ' ' || *pos == '\t')) pos++;
+        auto [ptr, ec] = std::from_chars(pos, end, value);
+        if (ec != std::errc()) return false;
+        pos = ptr;
+        return true;
+    }
+
+    // end of the line, that starts at pos
+    inline const char *Line_end(const char *pos, const char *end) {
+        const void *newline = std::memchr(pos, '\n', end - pos);
+        return newline ? static_cast<const char *>(newline) : end;
+    }
+
+    /**
+     * Parsing of OEM data lines, that start in [pos, range_end), into RV columns of the chunk
+     *
+     * A data line starts with an epoch, that contains 'T', followed by six numbers
+     * @param: start of the first line, end of the range, end of the text, chunk
+     *
+     */
+    template<typename T>
+    void Parse_OEM(const char *pos, const char *range_end, const char *end, Catalog_chunk<T> &chunk) {
+        chunk.size = 0;
+        while (pos < range_end) {
+            const char *line_end = Line_end(pos, end), *it = pos;
+            pos = line_end + (line_end < end);
+            while (it < line_end && (*it == ' ' || *it == '\t')) it++;
+            const char *epoch = it;
+            while (it < line_end && *it != ' ' && *it != '\t') it++;
+            if (epoch == it || *epoch < '0' || *epoch > '9' || !std::memchr(epoch, 'T', it - epoch)) continue;
+            chunk.reserve_next();
+            const std::size_t k = chunk.size;
+            chunk.size += Parse_number(it, line_end, chunk.x[k]) && Parse_number(it, line_end, chunk.y[k]) &&
+                          Parse_number(it, line_end, chunk.z[k]) && Parse_number(it, line_end, chunk.vx[k]) &&
+                          Parse_number(it, line_end, chunk.vy[k]) && Parse_number(it, line_end, chunk.vz[k]);
+        }
+    }
+
+    // fixed-width field of a TLE line, columns [begin, end) counting from 0
+    template<typename T>
+    inline bool Parse_field(const char *line, std::size_t begin, std::size_t end, T &value) {
+        const char *pos = line + begin;
+        return Parse_number(pos, line + end, value);
+    }
+
+    /**
+     * Parsing of TLE second lines, that start in [pos, range_end), into Keplerian elements columns of the chunk
+     *
+     * Mean motion gives semi-major axis by Kepler's third law, mean anomaly gives true anomaly. Elements are
+     * stored as elliptic inclined, the type of orbit is found by the conversion stage
+     * @param: start of the first line, end of the range, end of the text, chunk, gravitational parameter
+     *
+     */
+    template<typename T>
+    void Parse_TLE(const char *pos, const char *range_end, const char *end, Catalog_chunk<T> &chunk, T mu) {
+        const T deg = std::numbers::pi_v<T> / 180, rev_per_day = 2 * std::numbers::pi_v<T> / 86400;
+        chunk.size = 0;
+        while (pos < range_end) {
+            const char *line = pos, *line_end = Line_end(pos, end);
+            pos = line_end + (line_end < end);
+            if (line_end - line < 63 || line[0] != '2' || line[1] != ' ') continue;
+            chunk.reserve_next();
+            const std::size_t k = chunk.size;
+            long e_digits = 0;
+            T mean_anomaly = 0, mean_motion = 0;
+            if (!Parse_field(line, 8, 16, chunk.i[k]) || !Parse_field(line, 17, 25, chunk.W[k]) ||
+                !Parse_field(line, 26, 33, e_digits) || !Parse_field(line, 34, 42, chunk.w[k]) ||
+                !Parse_field(line, 43, 51, mean_anomaly) || !Parse_field(line, 52, 63, mean_motion))
+                continue;
+            const T e = T(e_digits) * T(1e-7), n = mean_motion * rev_per_day; // implied decimal point
+            chunk.e[k] = e;
+            chunk.a[k] = std::cbrt(mu / (n * n));
+            chunk.p[k] = chunk.a[k] * (1 - e * e);
+            chunk.i[k] *= deg;
+            chunk.W[k] *= deg;
+            chunk.w[k] *= deg;
+            chunk.nu[k] = True_anomaly(mean_anomaly * deg, e);
+            chunk.flag[k] = 4;
+            chunk.size++;
+        }
+    }
+
+    // start of the first line, that starts at or after pos
+    inline const char *Line_start(const char *begin, const char *pos, const char *end) {
+        if (pos == begin || pos[-1] == '\n') return pos;
+        const char *line_end = Line_end(pos, end);
+        return line_end + (line_end < end);
+    }
+}
+
+/**
+     * Streaming conversion of a state catalog to Keplerian elements
+     *
+     * The file is memory-mapped and cut into chunks of chunk_bytes, a chunk holds the lines, that start in its
+     * bytes, so chunks are independent. A step of the pipeline is one Thread_pool::parallel_for: every worker parses
+     * a chunk of the current group straight into its SoA columns by std::from_chars and converts it by batch RV2COE,
+     * while one more task passes the chunks of the previous group to the sink, so parsing, conversion and writing
+     * overlap on two groups of buffers. TLE chunks are brought to RV vectors by COE2RV_simd first, so both formats
+     * get the same classification
+     * @param: mapped file, format, gravitational parameter, sink(const Catalog_chunk<T> &), which receives
+     *         the chunks in order of the file and reads chunk.elem(), thread pool, bytes per chunk
+     * @return number of records
+     *
+     */
+template<typename T, typename Sink>
+std::size_t Convert_catalog(const Mapped_file &file, Catalog_format format, T mu, Sink &&sink, Thread_pool &pool,
+                            std::size_t chunk_bytes = 1 << 22) {
+    const char *begin = file.data(), *end = file.data() + file.size();
+    const std::size_t n_chunks = (file.size() + chunk_bytes - 1) / chunk_bytes, group = pool.size();
+    std::vector<Catalog_chunk<T>> chunks(2 * group); // chunk c of the file goes to chunks[c % (2 group)]
+    std::size_t records = 0;
+    for (std::size_t first = 0; first < n_chunks + group; first += group) { // first chunk of the current group
+        pool.parallel_for(group + 1, [&](std::size_t task, unsigned) {
+            if (task == group) { // sink of the previous group
+                for (std::size_t c = first - std::min(first, group); c < std::min(first, n_chunks); c++)
+                    sink(std::as_const(chunks[c % (2 * group)]));
+                return;
+            }
+            const std::size_t c = first + task;
+            if (c >= n_chunks) return;
+            Catalog_chunk<T> &chunk = chunks[c % (2 * group)];
+            const char *range_begin = detail::Line_start(begin, begin + c * chunk_bytes, end);
+            const char *range_end = begin + std::min(file.size(), (c + 1) * chunk_bytes);
+            if (format == Catalog_format::OEM) {
+                detail::Parse_OEM(range_begin, range_end, end, chunk);
+            } else {
+                detail::Parse_TLE(range_begin, range_end, end, chunk, mu);
+                COE_columns<T> elem = chunk.elem();
+                COE2RV_simd<T>({elem.p, elem.a, elem.e, elem.i, elem.W, elem.w, elem.nu, elem.flag}, chunk.rv(), mu);
+            }
+            RV_columns<T> rv = chunk.rv();
+            RV2COE<T>({rv.x, rv.y, rv.z, rv.vx, rv.vy, rv.vz}, chunk.elem(), mu);
+        });
+        for (std::size_t c = first; c < std::min(first + group, n_chunks); c++) records += chunks[c % (2 * group)].size;
+    }
+    return records;
+}
+
+/**
+     * Sink of Convert_catalog, that appends Keplerian elements columns to raw binary files
+     *
+     * Column c goes to file prefix + "." + name of c (p, a, e, i, W, w, nu, flag), so every file is a plain array,
+     * that can be memory-mapped back. Errors are thrown as std::system_error
+     *
+     */
+template<typename T>
+class COE_column_files {
+private:
+    std::array<std::FILE *, 8> files_{};
+
+    void write(int c, const void *data, std::size_t bytes) {
+        if (bytes && std::fwrite(data, 1, bytes, files_[c]) != bytes)
+            throw std::system_error(errno, std::generic_category(), "fwrite");
+    }
+
+public:
+    static constexpr std::array<const char *, 8> names{"p", "a", "e", "i", "W", "w", "nu", "flag"};
+
+    explicit COE_column_files(const std::string &prefix) {
+        for (int c = 0; c < 8; c++) {
+            const std::string path = prefix + "." + names[c];
+            files_[c] = std::fopen(path.c_str(), "wb");
+            if (!files_[c]) {
+                int error = errno;
+                close();
+                throw std::system_error(error, std::generic_category(), path);
+            }
+            std::setvbuf(files_[c], nullptr, _IOFBF, 1 << 20);
+        }
+    }
+
+    COE_column_files(const COE_column_files &) = delete;
+
+    COE_column_files &operator=(const COE_column_files &) = delete;
+
+    ~COE_column_files() { close(); }
+
+    void close() {
+        for (std::FILE *&file: files_) {
+            if (file) std::fclose(file);
+            file = nullptr;
+        }
+    }
+
+    void operator()(const Catalog_chunk<T> &chunk) {
+        const std::array<const T *, 7> columns{chunk.p.data(), chunk.a.data(), chunk.e.data(), chunk.i.data(),
+                                               chunk.W.data(), chunk.w.data(), chunk.nu.data()};
+        for (int c = 0; c < 7; c++) write(c, columns[c], chunk.size * sizeof(T));
+        write(7, chunk.flag.data(), chunk.size * sizeof(int));
+    }
+};
+
+#endif //ORBITAL_MANEUVERS_CATALOG_STREAM_H
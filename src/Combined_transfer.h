@@ -0,0 +1,261 @@
+#ifndef ORBITAL_MANEUVERS_COMBINED_TRANSFER_H
+#define ORBITAL_MANEUVERS_COMBINED_TRANSFER_H
+
+#include <array>
+#include <tuple>
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <utility>
+#include <algorithm>
+#include "Orbital_maneuvers.h"
+#include "Prepared_orbit.h"
+
+
+/**
+     * Non-coplanar transfer with plane change split between the two burns
+     *
+     * @param:
+     * delta_v - delta-v of the transfer
+     * split - part of the plane change, done at the first burn, in [0, 1]
+     * delta_v1, delta_v2 - delta-v of the burns
+     *
+     */
+template<typename T>
+struct Split_transfer {
+    T delta_v;
+    T split;
+    T delta_v1;
+    T delta_v2;
+};
+
+namespace detail {
+    /**
+     * Burns of the transfer as functions of the turn angle of velocity
+     *
+     * delta_v_k = sqrt(c_k - 2 p_k cos(theta_k)), theta_1 = s alpha, theta_2 = (1 - s) alpha
+     * @param:
+     * alpha - angle between the planes of the orbits
+     * c1, p1, c2, p2 - coefficients of the burns
+     *
+     */
+    template<typename T>
+    struct Split_burns {
+        T alpha, c1, p1, c2, p2;
+
+        std::pair<T, T> delta_v(T s) const {
+            return {std::sqrt(std::max(c1 - 2 * p1 * std::cos(s * alpha), T(0))),
+                    std::sqrt(std::max(c2 - 2 * p2 * std::cos((1 - s) * alpha), T(0)))};
+        }
+
+        // first and second derivatives of delta_v1 + delta_v2 with respect to s
+        std::pair<T, T> derivatives(T s) const {
+            const T sin1 = std::sin(s * alpha), cos1 = std::cos(s * alpha);
+            const T sin2 = std::sin((1 - s) * alpha), cos2 = std::cos((1 - s) * alpha);
+            const T d1 = std::sqrt(std::max(c1 - 2 * p1 * cos1, T(0))), d2 = std::sqrt(std::max(c2 - 2 * p2 * cos2, T(0)));
+            const T a1 = alpha * p1 / d1, a2 = alpha * p2 / d2;
+            return {a1 * sin1 - a2 * sin2,
+                    alpha * (a1 * cos1 + a2 * cos2) - a1 * a1 * sin1 * sin1 / d1 - a2 * a2 * sin2 * sin2 / d2};
+        }
+
+        // initial guess, exact for small angles
+        T guess() const {
+            auto [d1, d2] = delta_v(T(0.5));
+            const T w1 = p1 / d1, w2 = p2 / d2;
+            return w1 + w2 > 0 ? w2 / (w1 + w2) : T(0.5);
+        }
+    };
+
+    /**
+     * Minimum of delta-v on [low, high] by Newton's method on its derivative, safeguarded by bisection
+     *
+     * Minimum is at the end, when the derivative does not change sign, otherwise the root is bracketed. Newton's
+     * step, that leaves the bracket or goes uphill, is replaced by bisection
+     * @param: burns, segment, tolerance of s, maximum number of iterations
+     * @return split
+     *
+     */
+    template<typename T>
+    T Split_root(const Split_burns<T> &burns, T low, T high, T tol, int max_iter) {
+        if (!(burns.derivatives(low).first < 0)) return low;
+        if (!(burns.derivatives(high).first > 0)) return high;
+        T s = std::clamp(burns.guess(), low, high);
+        for (int iter = 0; iter < max_iter; iter++) {
+            auto [g, g1] = burns.derivatives(s);
+            if (!std::isfinite(g)) break; // burn of zero delta-v, the split is exact
+            if (g < 0) low = s;
+            else high = s;
+            T next = s - g / g1;
+            if (!(g1 > 0 && next > low && next < high)) next = (low + high) / 2;
+            bool done = std::abs(next - s) < tol;
+            s = next;
+            if (done || high - low < tol) break;
+        }
+        return s;
+    }
+
+    /**
+     * Number of equal segments of [0, 1] with at most one minimum of delta-v in each
+     *
+     * delta_v_k is convex in its angle up to pi / 2, so for alpha <= pi / 2 the minimum is unique. For larger angles
+     * delta-v can have minima near both ends and a maximum between them, so [0, 1] is cut into pieces
+     *
+     */
+    template<typename T>
+    int Split_segments(const Split_burns<T> &burns) {
+        return burns.alpha > std::numbers::pi_v<T> / 2 ? 8 : 1;
+    }
+
+    // optimal part of the plane change, done by the first burn
+    template<typename T>
+    T Optimal_split(const Split_burns<T> &burns, T tol, int max_iter) {
+        if (!(burns.alpha > 0)) return T(0.5);
+        const int segments = Split_segments(burns);
+        T best = 0, best_delta_v = std::numeric_limits<T>::infinity();
+        for (int j = 0; j < segments; j++) {
+            const T s = Split_root(burns, T(j) / segments, T(j + 1) / segments, tol, max_iter);
+            auto [delta_v1, delta_v2] = burns.delta_v(s);
+            if (delta_v1 + delta_v2 < best_delta_v) best = s, best_delta_v = delta_v1 + delta_v2;
+        }
+        return best;
+    }
+
+    /**
+     * Coefficients of the burns, when the first burn is on the initial orbit in direction node_ of the line of nodes
+     * and the second one is on the final orbit in the opposite direction
+     *
+     * Transfer orbit has apsides at both burns. Radial velocity of the orbits is cancelled by the burns,
+     * tangential velocity is turned by the burn's part of the plane change
+     * @param: prepared initial and final orbits, unit vector along the line of nodes, angle between the planes
+     *
+     */
+    template<typename T>
+    Split_burns<T> Node_burns(const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final, const Vec3<T> &node_,
+                              T alpha) {
+        const T mu = initial.elem.mu;
+        auto at = [&](const Prepared_orbit<T> &orbit, const Vec3<T> &direction) { // |r|, v_r, v_t at the direction
+            const T p = orbit.elem.p, sqrt_mu_p = std::sqrt(mu / p);
+            const T e_cos = scalar(orbit.e_vec, direction);
+            const T e_sin = scalar(orbit.h_hat, cross_product(orbit.e_vec, direction));
+            return std::array<T, 3>{p / (1 + e_cos), sqrt_mu_p * e_sin, sqrt_mu_p * (1 + e_cos)};
+        };
+        auto [r1, v1r, v1t] = at(initial, node_);
+        auto [r2, v2r, v2t] = at(final, -node_);
+        const T a_t = (r1 + r2) / 2;
+        const T vt1 = std::sqrt(2 * mu / r1 - mu / a_t), vt2 = std::sqrt(2 * mu / r2 - mu / a_t);
+        return {alpha, v1r * v1r + v1t * v1t + vt1 * vt1, v1t * vt1, v2r * v2r + v2t * v2t + vt2 * vt2, v2t * vt2};
+    }
+
+    // burns for both directions of the line of nodes
+    template<typename T>
+    std::pair<Split_burns<T>, Split_burns<T>> Node_burns(const Prepared_orbit<T> &initial,
+                                                         const Prepared_orbit<T> &final) {
+        Vec3<T> node_ = cross_product(initial.h_hat, final.h_hat);
+        T node_norm = norm(node_);
+        node_ = node_norm > T(1e-12) ? node_ / node_norm : initial.r / initial.r_norm; // any direction for coplanar
+        const T alpha = Angle_between(initial.h_hat, final.h_hat);
+        return {Node_burns(initial, final, node_, alpha), Node_burns(initial, final, -node_, alpha)};
+    }
+
+    template<typename T>
+    Split_transfer<T> Split_solution(const Split_burns<T> &burns, T s) {
+        auto [delta_v1, delta_v2] = burns.delta_v(s);
+        return {delta_v1 + delta_v2, s, delta_v1, delta_v2};
+    }
+}
+
+/**
+     * Non-coplanar transfer with the plane change combined with the in-plane burns
+     *
+     * Burns are at the line of nodes, the first one on the initial orbit, the second one on the final orbit
+     * on the opposite side. Part s of the plane change is done by the first burn, the rest by the second one.
+     * Optimal s is the root of d(delta-v)/ds, found by Newton's method with analytic second derivative.
+     * Both directions of the line of nodes are tried
+     * @param: prepared initial and final orbits, tolerance of s, maximum number of iterations
+     * @return Split_transfer
+     *
+     */
+template<typename T>
+Split_transfer<T> Combined_transfer(const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final,
+                                    T tol = T(1e-12), int max_iter = 30) {
+    auto [ascending, descending] = detail::Node_burns(initial, final);
+    Split_transfer<T> first = detail::Split_solution(ascending, detail::Optimal_split(ascending, tol, max_iter));
+    Split_transfer<T> second = detail::Split_solution(descending, detail::Optimal_split(descending, tol, max_iter));
+    return first.delta_v <= second.delta_v ? first : second;
+}
+
+template<typename T>
+Split_transfer<T> Combined_transfer(const COE<T> &initial, const COE<T> &final, T tol = T(1e-12),
+                                    int max_iter = 30) {
+    return Combined_transfer(Prepared_orbit<T>(initial), Prepared_orbit<T>(final), tol, max_iter);
+}
+
+/**
+     * Combined transfer for many pairs of orbits
+     *
+     * Segments of the split of every pair and both directions of the line of nodes are solved in lockstep
+     * on structure of arrays: every iteration makes a safeguarded Newton step of every unfinished problem with the same
+     * straight-line arithmetic, so the inner loop has no data-dependent branches, finished problems are dropped from
+     * the list of active ones
+     * @param: prepared initial and final orbits of pairs, tolerance of s, maximum number of iterations
+     * @return Split_transfer of every pair
+     *
+     */
+template<typename T>
+std::vector<Split_transfer<T>> Combined_transfer(const std::vector<Prepared_orbit<T>> &initial,
+                                                 const std::vector<Prepared_orbit<T>> &final,
+                                                 T tol = T(1e-12), int max_iter = 30) {
+    std::vector<detail::Split_burns<T>> burns(2 * initial.size()); // 2k - ascending node of pair k, 2k + 1 - descending
+    std::vector<std::size_t> owner; // problem -> burns
+    std::vector<T> s, low, high;
+    std::vector<std::size_t> active;
+    for (std::size_t k = 0; k < initial.size(); k++) {
+        std::tie(burns[2 * k], burns[2 * k + 1]) = detail::Node_burns(initial[k], final[k]);
+        for (std::size_t b = 2 * k; b < 2 * k + 2; b++) {
+            if (!(burns[b].alpha > 0)) {
+                owner.push_back(b), s.push_back(T(0.5)), low.push_back(T(0.5)), high.push_back(T(0.5));
+                continue;
+            }
+            const int segments = detail::Split_segments(burns[b]);
+            for (int j = 0; j < segments; j++) {
+                const T low_ = T(j) / segments, high_ = T(j + 1) / segments;
+                const bool rising = !(burns[b].derivatives(low_).first < 0);
+                const bool falling = !(burns[b].derivatives(high_).first > 0);
+                if (!rising && !falling) active.push_back(s.size());
+                owner.push_back(b);
+                s.push_back(rising ? low_ : (falling ? high_ : std::clamp(burns[b].guess(), low_, high_)));
+                low.push_back(low_), high.push_back(high_);
+            }
+        }
+    }
+
+    for (int iter = 0; iter < max_iter && !active.empty(); iter++) {
+        std::size_t kept = 0;
+        for (std::size_t j: active) {
+            auto [g, g1] = burns[owner[j]].derivatives(s[j]);
+            const bool finite = std::isfinite(g);
+            const T low_ = g < 0 ? s[j] : low[j];
+            const T high_ = g < 0 ? high[j] : s[j];
+            const T newton = s[j] - g / g1;
+            const T next = g1 > 0 && newton > low_ && newton < high_ ? newton : (low_ + high_) / 2;
+            const bool done = !finite || std::abs(next - s[j]) < tol || high_ - low_ < tol;
+            low[j] = low_, high[j] = high_;
+            s[j] = finite ? next : s[j];
+            active[kept] = j;
+            kept += !done;
+        }
+        active.resize(kept);
+    }
+
+    std::vector<Split_transfer<T>> result(initial.size(), {std::numeric_limits<T>::infinity(), 0, 0, 0});
+    for (std::size_t j = 0; j < s.size(); j++) {
+        Split_transfer<T> candidate = detail::Split_solution(burns[owner[j]], s[j]);
+        Split_transfer<T> &best = result[owner[j] / 2];
+        if (candidate.delta_v < best.delta_v) best = candidate;
+    }
+    return result;
+}
+
+#endif //ORBITAL_MANEUVERS_COMBINED_TRANSFER_H
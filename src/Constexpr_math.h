@@ -0,0 +1,80 @@
+#ifndef ORBITAL_MANEUVERS_CONSTEXPR_MATH_H
+#define ORBITAL_MANEUVERS_CONSTEXPR_MATH_H
+
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <concepts>
+#include <type_traits>
+
+
+/**
+     * Math functions, that are usable in constant expressions
+     *
+     * In constant evaluation (std::is_constant_evaluated) they use their own implementations, at run time they call
+     * std functions, so run-time results and speed do not change. Functions are brought into the functions of the
+     * library by block-scope using-declarations: calls stay unqualified, so Dual still gets its own by ADL
+     *
+     */
+namespace constexpr_math {
+    namespace detail {
+        // Newton iterations from above on the argument scaled into [1/4, 4] by powers of 4, that are exact
+        template<typename T>
+        constexpr T Sqrt(T x) {
+            if (!(x >= 0)) return std::numeric_limits<T>::quiet_NaN();
+            if (x == 0 || x == std::numeric_limits<T>::infinity()) return x;
+            T scale = 1;
+            for (; x > 4; x /= 4) scale *= 2;
+            for (; x < T(0.25); x *= 4) scale /= 2;
+            T y = (1 + x) / 2; // >= sqrt(x), iterations decrease until rounding stops them
+            for (T next = (y + x / y) / 2; next < y; next = (y + x / y) / 2) y = next;
+            return y * scale;
+        }
+
+        // argument is reduced to [-pi / 4, pi / 4] by pi / 2 in two parts, quadrant selects sine or cosine series
+        template<typename T>
+        constexpr T Sin_cos(T x, bool cosine) {
+            if (!(x - x == 0)) return std::numeric_limits<T>::quiet_NaN();
+            const long double half_pi = std::numbers::pi_v<long double> / 2;
+            const T half_pi_hi = T(half_pi), half_pi_lo = T(half_pi - half_pi_hi);
+            const long long k = static_cast<long long>(x / half_pi_hi + (x < 0 ? T(-0.5) : T(0.5)));
+            const T r = (x - T(k) * half_pi_hi) - T(k) * half_pi_lo, r2 = r * r;
+            const int quadrant = int(((k % 4) + 4) % 4) + int(cosine);
+
+            const bool sine = quadrant % 2 == 0; // sin(r) for quadrants 0, 2 of sine and 3, 1 of cosine
+            T term = sine ? r : T(1), sum = term;
+            for (int n = 1; n <= 13; n++) { // terms up to r^27 / 27!
+                const int m = sine ? 2 * n : 2 * n - 1;
+                term *= -r2 / T(m * (m + 1));
+                sum += term;
+            }
+            return quadrant % 4 < 2 ? sum : -sum;
+        }
+    }
+
+    template<std::floating_point T>
+    constexpr T sqrt(T x) {
+        if (std::is_constant_evaluated()) return detail::Sqrt(x);
+        return std::sqrt(x);
+    }
+
+    template<std::floating_point T>
+    constexpr T sin(T x) {
+        if (std::is_constant_evaluated()) return detail::Sin_cos(x, false);
+        return std::sin(x);
+    }
+
+    template<std::floating_point T>
+    constexpr T cos(T x) {
+        if (std::is_constant_evaluated()) return detail::Sin_cos(x, true);
+        return std::cos(x);
+    }
+
+    template<std::floating_point T>
+    constexpr T abs(T x) {
+        if (std::is_constant_evaluated()) return x < 0 ? -x : x;
+        return std::abs(x);
+    }
+}
+
+#endif //ORBITAL_MANEUVERS_CONSTEXPR_MATH_H
@@ -3,15 +3,152 @@
 
 
 #include <vector>
+#include <array>
 #include <iostream>
 #include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include "Simd.h"
 
+inline constexpr int Dynamic = -1;
+
+/**
+     * Non-owning view of a matrix with arbitrary strides
+     *
+     * Transposed view swaps the strides, so transposition costs nothing
+     * @param:
+     * data - pointer to the element (0, 0)
+     * rows, cols - size
+     * row_stride, col_stride - distance between neighbouring rows and columns
+     *
+     */
 template<typename T>
+struct Matrix_view {
+    using value_type = std::remove_const_t<T>;
+
+    T *data;
+    int rows, cols;
+    std::ptrdiff_t row_stride, col_stride;
+
+    T &operator()(int i, int j) const { return data[i * row_stride + j * col_stride]; }
+
+    Matrix_view view() const { return *this; }
+
+    Matrix_view transposed() const { return {data, cols, rows, col_stride, row_stride}; }
+
+    Matrix_view block(int i, int j, int h, int w) const { return {&(*this)(i, j), h, w, row_stride, col_stride}; }
+
+    operator Matrix_view<const T>() const { return {data, rows, cols, row_stride, col_stride}; }
+};
+
+/**
+     * Dense matrix
+     *
+     * Dense<T> (R = C = Dynamic) keeps the elements in std::vector, Dense<T, R, C> keeps them in std::array
+     * and lives on the stack, which is used for 3x3 and 6x6 matrices of rotations, STM and covariance
+     *
+     */
+template<typename T, int R = Dynamic, int C = Dynamic>
 class Dense {
+    static_assert(R > 0 && C > 0, "Dense size is either positive or Dynamic in both dimensions");
+private:
+    std::array<T, R * C> matrix_{};
+public:
+    using value_type = T;
+
+    constexpr Dense() = default;
+
+    constexpr explicit Dense(const std::array<T, R * C> &input_) : matrix_(input_) {};
+
+    static constexpr Dense identity() requires (R == C) {
+        Dense res_;
+        for (int i = 0; i < R; i++) res_(i, i) = 1;
+        return res_;
+    }
+
+    constexpr T operator()(int i, int j) const { return matrix_[i * C + j]; }
+
+    constexpr T &operator()(int i, int j) { return matrix_[i * C + j]; }
+
+    static constexpr int get_height() { return R; }
+
+    static constexpr int get_width() { return C; }
+
+    T *data() { return matrix_.data(); }
+
+    const T *data() const { return matrix_.data(); }
+
+    Matrix_view<T> view() { return {matrix_.data(), R, C, C, 1}; }
+
+    Matrix_view<const T> view() const { return {matrix_.data(), R, C, C, 1}; }
+
+    Matrix_view<const T> transposed() const { return view().transposed(); }
+
+    template<int K>
+    constexpr Dense<T, R, K> operator*(const Dense<T, C, K> &mult_) const {
+        Dense<T, R, K> result_;
+        for (int i = 0; i < R; i++) {
+            for (int j = 0; j < C; j++) {
+                const T a_ = matrix_[i * C + j];
+                for (int k = 0; k < K; k++) result_(i, k) += a_ * mult_(j, k);
+            }
+        }
+        return result_;
+    }
+
+    constexpr Dense operator*(T mult_) const {
+        Dense result_ = *this;
+        for (T &x: result_.matrix_) x *= mult_;
+        return result_;
+    }
+
+    constexpr Dense operator+(const Dense &add_) const {
+        Dense result_ = *this;
+        return result_ += add_;
+    }
+
+    constexpr Dense operator-(const Dense &sub_) const {
+        Dense result_ = *this;
+        return result_ -= sub_;
+    }
+
+    constexpr Dense &operator+=(const Dense &add_) {
+        for (int k = 0; k < R * C; k++) matrix_[k] += add_.matrix_[k];
+        return *this;
+    }
+
+    constexpr Dense &operator-=(const Dense &sub_) {
+        for (int k = 0; k < R * C; k++) matrix_[k] -= sub_.matrix_[k];
+        return *this;
+    }
+
+    constexpr Dense<T, C, R> Transpose() const {
+        Dense<T, C, R> trans_;
+        for (int i = 0; i < R; i++) for (int j = 0; j < C; j++) trans_(j, i) = matrix_[i * C + j];
+        return trans_;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const Dense &output_) {
+        for (int i = 0; i < R; i++) {
+            for (int j = 0; j < C; j++) out << output_(i, j) << " ";
+            out << "\n";
+        }
+        return out;
+    }
+};
+
+template<typename T>
+void multiply_add(Matrix_view<const T> a, Matrix_view<const T> b, Matrix_view<T> c, T alpha, T beta);
+
+template<typename T>
+class Dense<T, Dynamic, Dynamic> {
 private:
     std::vector<T> matrix_;
     int h_, w_;
 public:
+    using value_type = T;
+
     Dense(int h_, int w_, const std::vector<T> input_) : h_(h_), w_(w_), matrix_(input_) {};
 
     Dense(int h_, int w_) : h_(h_), w_(w_) {
@@ -26,73 +163,69 @@ public:
 
     int get_width() const { return w_; }
 
-    Dense<T> operator*(const Dense<T> &mult_) {
-        std::vector<T> result_;
-        result_.reserve(h_ * mult_.w_);
-        for (int i = 0; i < h_; i++) {
-            for (int k = 0; k < mult_.w_; k++) {
-                T sum = static_cast<T>(0);
-                for (int j = 0; j < w_; j++) sum += matrix_[i * w_ + j] * mult_(j, k);
-                result_.push_back(sum);
-            }
-        }
-        return Dense<T>{h_, mult_.w_, result_};
+    T *data() { return matrix_.data(); }
+
+    const T *data() const { return matrix_.data(); }
+
+    Matrix_view<T> view() { return {matrix_.data(), h_, w_, w_, 1}; }
+
+    Matrix_view<const T> view() const { return {matrix_.data(), h_, w_, w_, 1}; }
+
+    Matrix_view<const T> transposed() const { return view().transposed(); }
+
+    Matrix_view<const T> column(int j) const { return {matrix_.data() + j, h_, 1, w_, 1}; }
+
+    Matrix_view<T> block(int i, int j, int h, int w) { return view().block(i, j, h, w); }
+
+    Matrix_view<const T> block(int i, int j, int h, int w) const { return view().block(i, j, h, w); }
+
+    Dense<T> operator*(const Dense<T> &mult_) const {
+        Dense<T> result_{h_, mult_.w_};
+        multiply_add<T>(view(), mult_.view(), result_.view(), 1, 0);
+        return result_;
     }
 
-    std::vector<T>  operator*(const std::vector<T> &mult_) const {
-        std::vector<T> result_;
-        result_.reserve(mult_.size());
+    std::vector<T> operator*(const std::vector<T> &mult_) const {
+        std::vector<T> result_(h_);
         for (int i = 0; i < h_; i++) {
             T sum = static_cast<T>(0);
-            for (int k = 0; k < mult_.size(); k++) {
-
-                sum += matrix_[i * w_ + k] * mult_[k];
-
-            }
-            result_.push_back(sum);
+            for (int k = 0; k < mult_.size(); k++) sum += matrix_[i * w_ + k] * mult_[k];
+            result_[i] = sum;
         }
         return result_;
     }
 
-    Dense<T> operator*(T mult_) {
-        std::vector<T> result_;
-        result_.reserve(h_ * w_);
-        for (int i = 0; i < h_; i++) for (int j = 0; j < w_; j++) result_.push_back(matrix_[i * w_ + j] * mult_);
-        return Dense<T>{h_, w_, result_};
+    Dense<T> operator*(T mult_) const {
+        Dense<T> result_ = *this;
+        for (T &x: result_.matrix_) x *= mult_;
+        return result_;
     }
 
-    Dense<T> operator+(const Dense<T> &add_) {
-        std::vector<T> result_;
-        result_.reserve(w_ * h_);
-        for (int i = 0; i < h_; i++) {
-            for (int j = 0; j < w_; j++) result_.push_back(matrix_[i * w_ + j] + add_(i, j));
-        }
-        return Dense<T>{h_, w_, result_};
+    Dense<T> operator+(const Dense<T> &add_) const {
+        Dense<T> result_ = *this;
+        result_ += add_;
+        return result_;
     }
 
-    Dense<T> operator+=(const Dense<T> &add_) {
+    Dense<T> &operator+=(const Dense<T> &add_) {
         for (int i = 0; i < h_; i++) {
             for (int j = 0; j < w_; j++) matrix_[i * w_ + j] += add_(i, j);
         }
         return *this;
     }
 
-    Dense<T> Transpose() {
-        std::vector<T> trans_;
-        trans_.reserve(h_ * w_);
+    Dense<T> Transpose() const {
+        Dense<T> trans_{w_, h_};
         for (int i = 0; i < w_; i++) {
-            for (int j = 0; j < h_; j++) {
-                trans_.push_back(matrix_[j * w_ + i]);
-            }
+            for (int j = 0; j < h_; j++) trans_(i, j) = matrix_[j * w_ + i];
         }
-        return Dense<T>{w_, h_, trans_};
+        return trans_;
     }
 
     Dense<T> get_column(int j) const { // getting the j column from matrix
-        std::vector<T> col_;
-        col_.reserve(h_);
-        for (int i = 0; i < h_; i++) col_.push_back(matrix_[i * w_ + j]);
-        return Dense<T>{h_, 1, col_};
+        Dense<T> col_{h_, 1};
+        for (int i = 0; i < h_; i++) col_(i, 0) = matrix_[i * w_ + j];
+        return col_;
     }
 
     T norm() const // only for vectors
@@ -130,5 +263,143 @@ public:
     }
 };
 
+namespace detail {
+    template<typename T, int MR, int NR>
+    void Gemm_kernel(std::size_t kc, const T *a, const T *b, T *c) { // portable micro-kernel, see Simd_kernel.h
+        T acc[MR * NR] = {};
+        for (std::size_t p = 0; p < kc; p++) {
+            for (int i = 0; i < MR; i++) {
+                const T a_ = a[p * MR + i];
+                for (int j = 0; j < NR; j++) acc[i * NR + j] += a_ * b[p * NR + j];
+            }
+        }
+        std::copy_n(acc, MR * NR, c);
+    }
+
+    template<typename T>
+    struct Gemm_kernel_info {
+        int mr, nr;
+        void (*kernel)(std::size_t, const T *, const T *, T *);
+    };
+
+    template<typename T>
+    Gemm_kernel_info<T> Select_gemm_kernel() {
+#if ORBITAL_MANEUVERS_X86_SIMD
+        if constexpr (std::is_same_v<T, double>) {
+            if (supported_simd_level() == Simd_level::avx512)
+                return {simd_avx512::gemm_mr, simd_avx512::gemm_nr, simd_avx512::Gemm_kernel};
+            if (supported_simd_level() == Simd_level::avx2)
+                return {simd_avx2::gemm_mr, simd_avx2::gemm_nr, simd_avx2::Gemm_kernel};
+        }
+#endif
+        return {4, 8, Gemm_kernel<T, 4, 8>};
+    }
+
+    // blocks of the matrix product: mc x kc block of a stays in L2 cache, kc x nc panel of b in L3 cache
+    inline constexpr int gemm_mc = 96, gemm_kc = 256, gemm_nc = 2048;
+}
+
+/**
+     * Fused matrix multiply-add c = alpha * a * b + beta * c
+     *
+     * Blocks of a and b are packed into contiguous micro-panels (this is where strides and transposition are resolved),
+     * micro-panels are multiplied by the register-blocked kernel of Simd_kernel.h for double on AVX2 / AVX-512,
+     * by the portable kernel otherwise. Packing buffers are kept per thread, so the steady state does not allocate.
+     * c must not overlap a or b
+     * @param: views of a, b and c, alpha, beta
+     *
+     */
+template<typename T>
+void multiply_add(Matrix_view<const T> a, Matrix_view<const T> b, Matrix_view<T> c, T alpha, T beta) {
+    const int m = c.rows, n = c.cols, k = a.cols;
+    if (beta != T(1)) {
+        for (int i = 0; i < m; i++) for (int j = 0; j < n; j++) c(i, j) = beta == T(0) ? T(0) : beta * c(i, j);
+    }
+    if (m == 0 || n == 0 || k == 0 || alpha == T(0)) return;
+
+    if (std::size_t(m) * n * k <= 8 * 8 * 8) { // packing does not pay off
+        for (int i = 0; i < m; i++) {
+            for (int p = 0; p < k; p++) {
+                const T a_ = alpha * a(i, p);
+                for (int j = 0; j < n; j++) c(i, j) += a_ * b(p, j);
+            }
+        }
+        return;
+    }
+
+    static const detail::Gemm_kernel_info<T> info = detail::Select_gemm_kernel<T>();
+    const int mr = info.mr, nr = info.nr;
+    const int mc_max = detail::gemm_mc / mr * mr, nc_max = detail::gemm_nc / nr * nr;
+    thread_local std::vector<T> packed_a, packed_b;
+    thread_local std::vector<T> tile;
+    packed_a.resize(std::max<std::size_t>(packed_a.size(), std::size_t(mc_max) * detail::gemm_kc));
+    packed_b.resize(std::max<std::size_t>(packed_b.size(), std::size_t(nc_max) * detail::gemm_kc));
+    tile.resize(std::max<std::size_t>(tile.size(), std::size_t(mr) * nr));
+
+    for (int jc = 0; jc < n; jc += nc_max) {
+        const int nc = std::min(nc_max, n - jc);
+        for (int pc = 0; pc < k; pc += detail::gemm_kc) {
+            const int kc = std::min(detail::gemm_kc, k - pc);
+
+            for (int jr = 0; jr < nc; jr += nr) { // kc x nr micro-panels of b, row by row, padded with zeros
+                T *dst = packed_b.data() + std::size_t(jr) * kc;
+                const int cols = std::min(nr, nc - jr);
+                for (int p = 0; p < kc; p++) {
+                    for (int j = 0; j < cols; j++) dst[p * nr + j] = b(pc + p, jc + jr + j);
+                    for (int j = cols; j < nr; j++) dst[p * nr + j] = 0;
+                }
+            }
+
+            for (int ic = 0; ic < m; ic += mc_max) {
+                const int mc = std::min(mc_max, m - ic);
+                for (int ir = 0; ir < mc; ir += mr) { // mr x kc micro-panels of a, column by column, scaled by alpha
+                    T *dst = packed_a.data() + std::size_t(ir) * kc;
+                    const int rows = std::min(mr, mc - ir);
+                    for (int p = 0; p < kc; p++) {
+                        for (int i = 0; i < rows; i++) dst[p * mr + i] = alpha * a(ic + ir + i, pc + p);
+                        for (int i = rows; i < mr; i++) dst[p * mr + i] = 0;
+                    }
+                }
+
+                for (int jr = 0; jr < nc; jr += nr) {
+                    const int cols = std::min(nr, nc - jr);
+                    for (int ir = 0; ir < mc; ir += mr) {
+                        const int rows = std::min(mr, mc - ir);
+                        info.kernel(kc, packed_a.data() + std::size_t(ir) * kc, packed_b.data() + std::size_t(jr) * kc,
+                                    tile.data());
+                        for (int i = 0; i < rows; i++) {
+                            for (int j = 0; j < cols; j++) c(ic + ir + i, jc + jr + j) += tile[i * nr + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+     * Fused matrix multiply-add c = alpha * a * b + beta * c on matrices and views
+     *
+     * @param: a, b, c - Dense of any size or Matrix_view, alpha, beta
+     *
+     */
+template<typename A, typename B, typename C>
+void multiply_add(const A &a, const B &b, C &&c, typename std::remove_cvref_t<C>::value_type alpha = 1,
+                  typename std::remove_cvref_t<C>::value_type beta = 1) {
+    using T = typename std::remove_cvref_t<C>::value_type;
+    multiply_add<T>(Matrix_view<const T>(a.view()), Matrix_view<const T>(b.view()), c.view(), alpha, beta);
+}
+
+/**
+     * Matrix product c = a * b into existing matrix, without allocation
+     *
+     * @param: a, b, c - Dense of any size or Matrix_view
+     *
+     */
+template<typename A, typename B, typename C>
+void multiply_into(const A &a, const B &b, C &&c) {
+    multiply_add(a, b, c, 1, 0);
+}
+
 
 #endif //ORBITAL_MANEUVERS_DENSE_H
@@ -0,0 +1,264 @@
+#ifndef ORBITAL_MANEUVERS_DUAL_H
+#define ORBITAL_MANEUVERS_DUAL_H
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <compare>
+#include <utility>
+#include <ostream>
+#include <type_traits>
+#include "Orbital_elements_convertion.h"
+
+
+/**
+     * Dual number of forward-mode automatic differentiation
+     *
+     * Value and its derivatives with respect to N variables. Arithmetic and math functions apply the chain rule,
+     * so one call of a template function on Dual gives the function and its gradient. Comparisons use values only.
+     * Functions of Vector.h, Orbital_elements_convertion.h, Orbital_maneuvers.h and Prepared_orbit (its maneuvers too)
+     * call math unqualified and work on Dual. Searches and solvers of the other headers (Bi_elliptic_optimization.h,
+     * Maneuver_planner.h, Combined_transfer.h, Low_thrust.h, Sequencing.h and others) call std:: math, keep
+     * branches and iteration counts, that are not differentiable, and are not instantiated with Dual
+     * @param:
+     * value - value of the function
+     * grad - derivatives with respect to the variables
+     *
+     */
+template<typename T, int N>
+struct Dual {
+    T value = 0;
+    std::array<T, N> grad{};
+
+    constexpr Dual() = default;
+
+    template<typename U> requires std::is_arithmetic_v<U>
+    constexpr Dual(U value_) : value(T(value_)) {}
+
+    constexpr Dual(T value_, const std::array<T, N> &grad_) : value(value_), grad(grad_) {}
+
+    constexpr Dual &operator+=(const Dual &other) { return *this = *this + other; }
+
+    constexpr Dual &operator-=(const Dual &other) { return *this = *this - other; }
+
+    constexpr Dual &operator*=(const Dual &other) { return *this = *this * other; }
+
+    constexpr Dual &operator/=(const Dual &other) { return *this = *this / other; }
+
+    friend constexpr Dual operator+(const Dual &a, const Dual &b) {
+        Dual res{a.value + b.value, a.grad};
+        for (int j = 0; j < N; j++) res.grad[j] += b.grad[j];
+        return res;
+    }
+
+    friend constexpr Dual operator-(const Dual &a, const Dual &b) {
+        Dual res{a.value - b.value, a.grad};
+        for (int j = 0; j < N; j++) res.grad[j] -= b.grad[j];
+        return res;
+    }
+
+    friend constexpr Dual operator-(const Dual &a) {
+        Dual res{-a.value, a.grad};
+        for (int j = 0; j < N; j++) res.grad[j] = -res.grad[j];
+        return res;
+    }
+
+    friend constexpr Dual operator*(const Dual &a, const Dual &b) {
+        Dual res{a.value * b.value, {}};
+        for (int j = 0; j < N; j++) res.grad[j] = a.grad[j] * b.value + a.value * b.grad[j];
+        return res;
+    }
+
+    friend constexpr Dual operator/(const Dual &a, const Dual &b) {
+        const T inv = 1 / b.value, value = a.value * inv;
+        Dual res{value, {}};
+        for (int j = 0; j < N; j++) res.grad[j] = (a.grad[j] - value * b.grad[j]) * inv;
+        return res;
+    }
+
+    friend constexpr bool operator==(const Dual &a, const Dual &b) { return a.value == b.value; }
+
+    friend constexpr auto operator<=>(const Dual &a, const Dual &b) { return a.value <=> b.value; }
+};
+
+// operations with numbers, that are constants of differentiation
+template<typename T, int N, typename U> requires std::is_arithmetic_v<U>
+constexpr Dual<T, N> operator+(const Dual<T, N> &a, U b) { return {a.value + T(b), a.grad}; }
+
+template<typename T, int N, typename U> requires std::is_arithmetic_v<U>
+constexpr Dual<T, N> operator+(U a, const Dual<T, N> &b) { return b + a; }
+
+template<typename T, int N, typename U> requires std::is_arithmetic_v<U>
+constexpr Dual<T, N> operator-(const Dual<T, N> &a, U b) { return {a.value - T(b), a.grad}; }
+
+template<typename T, int N, typename U> requires std::is_arithmetic_v<U>
+constexpr Dual<T, N> operator-(U a, const Dual<T, N> &b) { return -b + a; }
+
+template<typename T, int N, typename U> requires std::is_arithmetic_v<U>
+constexpr Dual<T, N> operator*(const Dual<T, N> &a, U b) {
+    Dual<T, N> res{a.value * T(b), a.grad};
+    for (int j = 0; j < N; j++) res.grad[j] *= T(b);
+    return res;
+}
+
+template<typename T, int N, typename U> requires std::is_arithmetic_v<U>
+constexpr Dual<T, N> operator*(U a, const Dual<T, N> &b) { return b * a; }
+
+template<typename T, int N, typename U> requires std::is_arithmetic_v<U>
+constexpr Dual<T, N> operator/(const Dual<T, N> &a, U b) { return a * (1 / T(b)); }
+
+template<typename T, int N, typename U> requires std::is_arithmetic_v<U>
+constexpr Dual<T, N> operator/(U a, const Dual<T, N> &b) { return Dual<T, N>(a) / b; }
+
+template<typename T, int N, typename U> requires std::is_arithmetic_v<U>
+constexpr bool operator==(const Dual<T, N> &a, U b) { return a.value == T(b); }
+
+template<typename T, int N, typename U> requires std::is_arithmetic_v<U>
+constexpr auto operator<=>(const Dual<T, N> &a, U b) { return a.value <=> T(b); }
+
+template<typename T, int N>
+std::ostream &operator<<(std::ostream &out, const Dual<T, N> &a) { return out << a.value; }
+
+namespace detail {
+    // f(x) with derivative df / dx at x
+    template<typename T, int N>
+    constexpr Dual<T, N> Chain(const Dual<T, N> &x, T f, T df) {
+        Dual<T, N> res{f, x.grad};
+        for (int j = 0; j < N; j++) res.grad[j] *= df;
+        return res;
+    }
+}
+
+/// Math functions, found by ADL from the unqualified calls of the library ///
+template<typename T, int N>
+Dual<T, N> sqrt(const Dual<T, N> &x) {
+    const T f = std::sqrt(x.value);
+    return detail::Chain(x, f, T(0.5) / f);
+}
+
+template<typename T, int N>
+Dual<T, N> sin(const Dual<T, N> &x) { return detail::Chain(x, std::sin(x.value), std::cos(x.value)); }
+
+template<typename T, int N>
+Dual<T, N> cos(const Dual<T, N> &x) { return detail::Chain(x, std::cos(x.value), -std::sin(x.value)); }
+
+template<typename T, int N>
+Dual<T, N> tan(const Dual<T, N> &x) {
+    const T f = std::tan(x.value);
+    return detail::Chain(x, f, 1 + f * f);
+}
+
+template<typename T, int N>
+Dual<T, N> asin(const Dual<T, N> &x) {
+    return detail::Chain(x, std::asin(x.value), 1 / std::sqrt(1 - x.value * x.value));
+}
+
+template<typename T, int N>
+Dual<T, N> acos(const Dual<T, N> &x) {
+    return detail::Chain(x, std::acos(x.value), -1 / std::sqrt(1 - x.value * x.value));
+}
+
+template<typename T, int N>
+Dual<T, N> atan(const Dual<T, N> &x) {
+    return detail::Chain(x, std::atan(x.value), 1 / (1 + x.value * x.value));
+}
+
+template<typename T, int N>
+Dual<T, N> atan2(const Dual<T, N> &y, const Dual<T, N> &x) {
+    const T r2 = x.value * x.value + y.value * y.value;
+    Dual<T, N> res{std::atan2(y.value, x.value), {}};
+    for (int j = 0; j < N; j++) res.grad[j] = (x.value * y.grad[j] - y.value * x.grad[j]) / r2;
+    return res;
+}
+
+template<typename T, int N>
+Dual<T, N> exp(const Dual<T, N> &x) {
+    const T f = std::exp(x.value);
+    return detail::Chain(x, f, f);
+}
+
+template<typename T, int N>
+Dual<T, N> log(const Dual<T, N> &x) { return detail::Chain(x, std::log(x.value), 1 / x.value); }
+
+template<typename T, int N, typename U> requires std::is_arithmetic_v<U>
+Dual<T, N> pow(const Dual<T, N> &x, U power) {
+    const T f = std::pow(x.value, T(power));
+    return detail::Chain(x, f, T(power) * std::pow(x.value, T(power) - 1));
+}
+
+template<typename T, int N>
+Dual<T, N> abs(const Dual<T, N> &x) { return std::signbit(x.value) ? -x : x; }
+
+template<typename T, int N>
+Dual<T, N> floor(const Dual<T, N> &x) { return {std::floor(x.value), {}}; }
+
+template<typename T, int N>
+bool signbit(const Dual<T, N> &x) { return std::signbit(x.value); }
+
+template<typename T, int N>
+bool isfinite(const Dual<T, N> &x) { return std::isfinite(x.value); }
+
+template<typename T, int N>
+bool isnan(const Dual<T, N> &x) { return std::isnan(x.value); }
+
+// constants and limits of dual numbers are the ones of T, specializations for program-defined types are allowed
+template<typename T, int N>
+inline constexpr Dual<T, N> std::numbers::pi_v<Dual<T, N>> = Dual<T, N>(std::numbers::pi_v<T>);
+
+template<typename T, int N>
+struct std::numeric_limits<Dual<T, N>> : std::numeric_limits<T> {
+    static constexpr Dual<T, N> epsilon() noexcept { return std::numeric_limits<T>::epsilon(); }
+
+    static constexpr Dual<T, N> min() noexcept { return std::numeric_limits<T>::min(); }
+
+    static constexpr Dual<T, N> max() noexcept { return std::numeric_limits<T>::max(); }
+
+    static constexpr Dual<T, N> lowest() noexcept { return std::numeric_limits<T>::lowest(); }
+
+    static constexpr Dual<T, N> infinity() noexcept { return std::numeric_limits<T>::infinity(); }
+
+    static constexpr Dual<T, N> quiet_NaN() noexcept { return std::numeric_limits<T>::quiet_NaN(); }
+};
+
+/**
+     * Keplerian elements as variables of differentiation
+     *
+     * Derivatives of a, e, i, W, w, nu are seeded at variables offset ... offset + 5. Dependent elements get
+     * the derivatives of their definitions: p = a (1 - e^2), u = w + nu, lam_true = W + w + nu, w_true = W + w.
+     * Values are kept as they are, mu is a constant
+     * @param: Keplerian elements, index of the first variable
+     * @return Keplerian elements of dual numbers
+     *
+     */
+template<int N, typename T>
+COE<Dual<T, N>> COE_variables(const COE<T> &elem, int offset) {
+    using D = Dual<T, N>;
+    auto variable = [&](T value, int index) {
+        D res(value);
+        res.grad[offset + index] = 1;
+        return res;
+    };
+    const D a = variable(elem.a, 0), e = variable(elem.e, 1), i = variable(elem.i, 2);
+    const D W = variable(elem.W, 3), w = variable(elem.w, 4), nu = variable(elem.nu, 5);
+    auto dependent = [](T value, const D &definition) { return D(value, definition.grad); };
+    return {dependent(elem.p, a * (1 - e * e)), a, e, i, W, w, nu, dependent(elem.u, w + nu),
+            dependent(elem.lam_true, W + w + nu), dependent(elem.w_true, W + w), D(elem.mu), elem.flag};
+}
+
+/**
+     * Delta-v of a transfer and its gradient with respect to the elements of both orbits in one pass
+     *
+     * Replaces 12 or 24 calls of finite differences
+     * @param: function(initial, final) of Keplerian elements, that returns delta-v, Keplerian elements of initial
+     * and final orbits
+     * @return delta-v, derivatives with respect to a, e, i, W, w, nu of initial and then of final orbit
+     *
+     */
+template<typename T, typename Function>
+std::pair<T, std::array<T, 12>> Delta_v_gradient(Function &&function, const COE<T> &initial, const COE<T> &final) {
+    const Dual<T, 12> delta_v = function(COE_variables<12>(initial, 0), COE_variables<12>(final, 6));
+    return {delta_v.value, delta_v.grad};
+}
+
+#endif //ORBITAL_MANEUVERS_DUAL_H
@@ -0,0 +1,219 @@
+#ifndef ORBITAL_MANEUVERS_KEPLER_PROPAGATION_H
+#define ORBITAL_MANEUVERS_KEPLER_PROPAGATION_H
+
+#include <span>
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+#include "Orbital_elements_convertion.h"
+#include "Batch_convertion.h"
+#include "Simd_convertion.h"
+
+
+/**
+     * Eccentric anomaly of elliptic orbit
+     *
+     * Markley's starter, F.L. Markley, Kepler equation solver, and two Halley iterations, which give
+     * full double precision for e < 1
+     * @param: mean anomaly, eccentricity
+     * @return eccentric anomaly, same revolution as mean anomaly
+     *
+     */
+template<typename T>
+T Eccentric_anomaly(T M, T e) {
+    const T pi = std::numbers::pi_v<T>;
+    T revolutions = std::round(M / (2 * pi));
+    M -= 2 * pi * revolutions; // [-pi, pi]
+    T aM = std::abs(M);
+
+    T alpha = (3 * pi * pi + T(1.6) * pi * (pi - aM) / (1 + e)) / (pi * pi - 6);
+    T d = 3 * (1 - e) + alpha * e;
+    T q = 2 * alpha * d * (1 - e) - aM * aM;
+    T r = 3 * alpha * d * (d - 1 + e) * aM + aM * aM * aM;
+    T w = std::cbrt(std::abs(r) + std::sqrt(std::max(q * q * q + r * r, T(0))));
+    w *= w;
+    T E = (2 * r * w / (w * w + w * q + q * q) + aM) / d;
+    if (M < 0) E = -E;
+
+    for (int iter = 0; iter < 2; iter++) { // Halley iterations
+        T sin_E = std::sin(E), cos_E = std::cos(E);
+        T f = E - e * sin_E - M;
+        T f1 = 1 - e * cos_E;
+        T f2 = e * sin_E;
+        E -= f / (f1 - f * f2 / (2 * f1));
+    }
+    return E + 2 * pi * revolutions;
+}
+
+/**
+     * Hyperbolic anomaly of hyperbolic orbit
+     *
+     * Halley iterations of M = e sinh(H) - H from H = ln(2|M| / e + 1.8)
+     * @param: mean anomaly, eccentricity, tolerance, maximum number of iterations
+     * @return hyperbolic anomaly
+     *
+     */
+template<typename T>
+T Hyperbolic_anomaly(T M, T e, T tol = 4 * std::numeric_limits<T>::epsilon(), int max_iter = 50) {
+    T H = std::copysign(std::log(2 * std::abs(M) / e + T(1.8)), M);
+    for (int iter = 0; iter < max_iter; iter++) {
+        T sinh_H = std::sinh(H), cosh_H = std::cosh(H);
+        T f = e * sinh_H - H - M;
+        T f1 = e * cosh_H - 1;
+        T f2 = e * sinh_H;
+        T delta = f / (f1 - f * f2 / (2 * f1));
+        H -= delta;
+        if (std::abs(delta) <= tol * std::max(T(1), std::abs(H))) break;
+    }
+    return H;
+}
+
+/**
+     * Mean anomaly
+     *
+     * M = E - e sin(E) for elliptic orbits, M = e sinh(H) - H for hyperbolic orbits,
+     * M = D + D^3 / 3, D = tan(nu / 2) for parabolic orbits (Barker's equation)
+     * @param: true anomaly, eccentricity
+     * @return mean anomaly
+     *
+     */
+template<typename T>
+T Mean_anomaly(T nu, T e) {
+    if (e < 1) {
+        T E = 2 * std::atan2(std::sqrt(1 - e) * std::sin(nu / 2), std::sqrt(1 + e) * std::cos(nu / 2));
+        return E - e * std::sin(E);
+    }
+    if (e > 1) {
+        T H = 2 * std::atanh(std::sqrt((e - 1) / (e + 1)) * std::tan(nu / 2));
+        return e * std::sinh(H) - H;
+    }
+    T D = std::tan(nu / 2);
+    return D + D * D * D / 3;
+}
+
+/**
+     * True anomaly
+     *
+     * @param: mean anomaly, eccentricity
+     * @return true anomaly, in [0, 2pi) for elliptic orbits, in (-pi, pi) for others
+     *
+     */
+template<typename T>
+T True_anomaly(T M, T e) {
+    const T pi = std::numbers::pi_v<T>;
+    if (e < 1) {
+        T E = Eccentric_anomaly(M, e);
+        T nu = 2 * std::atan2(std::sqrt(1 + e) * std::sin(E / 2), std::sqrt(1 - e) * std::cos(E / 2));
+        nu = std::fmod(nu, 2 * pi);
+        return nu < 0 ? nu + 2 * pi : nu;
+    }
+    if (e > 1) {
+        T H = Hyperbolic_anomaly(M, e);
+        return 2 * std::atan(std::sqrt((e + 1) / (e - 1)) * std::tanh(H / 2));
+    }
+    T B = T(1.5) * M; // root of D^3 + 3D - 3M = 0
+    T y = std::cbrt(B + std::sqrt(B * B + 1));
+    return 2 * std::atan(y - 1 / y);
+}
+
+/**
+     * Mean motion, rate of mean anomaly of Mean_anomaly
+     *
+     * @param: semilatus rectum, semimajor axis, eccentricity, gravitational parameter
+     * @return mean motion
+     *
+     */
+template<typename T>
+T Mean_motion(T p, T a, T e, T mu) {
+    if (e == 1) return 2 * std::sqrt(mu / (p * p * p));
+    T a_ = std::abs(a);
+    return std::sqrt(mu / (a_ * a_ * a_));
+}
+
+/**
+     * Two-body propagation of Keplerian elements
+     *
+     * Only the anomaly, that COE2RV uses for the type of orbit, is advanced: true longitude for circular equatorial,
+     * argument of latitude for circular inclined, true anomaly for elliptic orbits. Result goes to COE2RV as is
+     * @param: Keplerian elements, time step
+     * @return Keplerian elements after time step
+     *
+     */
+template<typename T>
+COE<T> Kepler_propagation(const COE<T> &elem, T dt) {
+    COE<T> res = elem;
+    T &anomaly = elem.flag == 1 ? res.lam_true : (elem.flag == 2 ? res.u : res.nu);
+    T M = Mean_anomaly(anomaly, elem.e) + Mean_motion(elem.p, elem.a, elem.e, elem.mu) * dt;
+    anomaly = True_anomaly(M, elem.e);
+    return res;
+}
+
+/**
+     * Keplerian elements columns of one epoch of batch propagation
+     *
+     * @param: Keplerian elements columns at initial epoch, true anomalies of batch Kepler_propagation, index of epoch
+     * @return columns, that share all elements with the initial ones but true anomaly and are accepted by COE2RV
+     *
+     */
+template<typename T>
+COE_columns<const T> Epoch_columns(const COE_columns<const T> &elem, std::span<const std::type_identity_t<T>> nu,
+                                  std::size_t epoch) {
+    COE_columns<const T> res = elem;
+    res.nu = nu.subspan(epoch * elem.size(), elem.size());
+    return res;
+}
+
+/**
+     * Batch two-body propagation of many orbits to many epochs
+     *
+     * Mean anomaly at epoch and mean motion are computed once per orbit. Elliptic orbits of every epoch are solved by
+     * straight-line Markley + Halley code, by SIMD kernels of Simd.h for double, hyperbolic and
+     * parabolic orbits are solved one by one afterwards
+     * @param: Keplerian elements columns, time steps, output true anomalies (elem.size() * dt.size(),
+     * nu[j * elem.size() + k] is orbit k at epoch j), gravitational parameter, instruction set
+     *
+     */
+template<typename T>
+void Kepler_propagation(const COE_columns<const T> &elem, std::span<const std::type_identity_t<T>> dt,
+                        std::span<std::type_identity_t<T>> nu, T mu,
+                        Simd_level level = supported_simd_level()) {
+    const T pi = std::numbers::pi_v<T>;
+    const std::size_t n_ = elem.size();
+    std::vector<T> M0(n_), n(n_), beta(n_);
+    std::vector<std::size_t> not_elliptic;
+    for (std::size_t k = 0; k < n_; k++) {
+        const T e = elem.e[k];
+        M0[k] = Mean_anomaly(elem.nu[k], e);
+        n[k] = Mean_motion(elem.p[k], elem.a[k], e, mu);
+        beta[k] = e < 1 ? std::sqrt((1 + e) / (1 - e)) : 0;
+        if (!(e < 1)) not_elliptic.push_back(k);
+    }
+#if ORBITAL_MANEUVERS_X86_SIMD
+    if (level > supported_simd_level()) level = supported_simd_level();
+#endif
+
+    for (std::size_t j = 0; j < dt.size(); j++) {
+        T *nu_ = nu.data() + j * n_;
+        std::size_t done = 0;
+#if ORBITAL_MANEUVERS_X86_SIMD
+        if constexpr (std::is_same_v<T, double>) {
+            if (level == Simd_level::avx512)
+                done = simd_avx512::Kepler_kernel(M0.data(), n.data(), elem.e.data(), beta.data(), dt[j], nu_, n_);
+            if (level == Simd_level::avx2)
+                done = simd_avx2::Kepler_kernel(M0.data(), n.data(), elem.e.data(), beta.data(), dt[j], nu_, n_);
+        }
+#endif
+        for (std::size_t k = done; k < n_; k++) {
+            T E = Eccentric_anomaly(M0[k] + n[k] * dt[j], elem.e[k]);
+            T anomaly = 2 * std::atan(beta[k] * std::sin(E) / (1 + std::cos(E)));
+            nu_[k] = anomaly < 0 ? anomaly + 2 * pi : anomaly;
+        }
+        for (std::size_t k: not_elliptic) nu_[k] = True_anomaly(M0[k] + n[k] * dt[j], elem.e[k]);
+    }
+}
+
+#endif //ORBITAL_MANEUVERS_KEPLER_PROPAGATION_H
@@ -0,0 +1,185 @@
+#ifndef ORBITAL_MANEUVERS_LAMBERT_H
+#define ORBITAL_MANEUVERS_LAMBERT_H
+
+#include <cmath>
+#include <numbers>
+#include <limits>
+#include <algorithm>
+#include "Vector.h"
+
+
+/**
+     * Solution of Lambert's problem
+     *
+     * @param:
+     * v1, v2 - velocities at the first and the second points
+     * x - Izzo's variable of the solution, may be used as the initial guess of a neighbouring problem
+     * iterations - number of Householder iterations
+     * converged - false, if there is no solution with the requested number of revolutions or iterations diverged
+     *
+     */
+template<typename T>
+struct Lambert_solution {
+    Vec3<T> v1, v2;
+    T x;
+    int iterations;
+    bool converged;
+};
+
+namespace detail {
+    template<typename T>
+    inline T Lambert_y(T x, T ll) { return std::sqrt(1 - ll * ll * (1 - x * x)); }
+
+    template<typename T>
+    inline T Lambert_hyp2f1b(T x) { // hypergeometric function 2F1(3, 1, 5/2, x)
+        if (x >= 1) return std::numeric_limits<T>::infinity();
+        T res = 1, term = 1;
+        for (int i = 0; i < 1000; i++) {
+            term = term * (3 + i) * (1 + i) / (T(2.5) + i) * x / (i + 1);
+            T res_old = res;
+            res += term;
+            if (res_old == res) break;
+        }
+        return res;
+    }
+
+    template<typename T>
+    inline T Lambert_tof(T x, T y, T ll, int M) { // non-dimensional time of flight
+        if (M == 0 && std::sqrt(T(0.6)) < x && x < std::sqrt(T(1.4))) { // series near parabola
+            T eta = y - ll * x;
+            T S_1 = (1 - ll - x * eta) / 2;
+            T Q = T(4) / 3 * Lambert_hyp2f1b(S_1);
+            return (eta * eta * eta * Q + 4 * ll * eta) / 2;
+        }
+        T psi;
+        if (x < 1) psi = std::acos(std::clamp(x * y + ll * (1 - x * x), T(-1), T(1)));
+        else psi = std::asinh((y - x * ll) * std::sqrt(x * x - 1));
+        return ((psi + M * std::numbers::pi_v<T>) / std::sqrt(std::abs(1 - x * x)) - x + ll * y) / (1 - x * x);
+    }
+
+    template<typename T>
+    inline void Lambert_tof_derivatives(T x, T y, T tof, T ll, T &d1, T &d2, T &d3) {
+        T ll2 = ll * ll, ll3 = ll2 * ll, ll5 = ll3 * ll2;
+        d1 = (3 * tof * x - 2 + 2 * ll3 * x / y) / (1 - x * x);
+        d2 = (3 * tof + 5 * x * d1 + 2 * (1 - ll2) * ll3 / (y * y * y)) / (1 - x * x);
+        d3 = (7 * x * d2 + 8 * d1 - 6 * (1 - ll2) * ll5 * x / (y * y * y * y * y)) / (1 - x * x);
+    }
+
+    template<typename T>
+    inline T Lambert_initial_guess(T tof, T ll, int M, bool low_path) {
+        const T pi = std::numbers::pi_v<T>;
+        if (M == 0) {
+            T tof_0 = std::acos(ll) + ll * std::sqrt(1 - ll * ll); // x = 0
+            T tof_1 = 2 * (1 - ll * ll * ll) / 3; // x = 1
+            if (tof >= tof_0) return std::pow(tof_0 / tof, T(2) / 3) - 1;
+            if (tof < tof_1) return T(2.5) * tof_1 / tof * (tof_1 - tof) / (1 - std::pow(ll, 5)) + 1;
+            return std::exp(std::log(T(2)) * std::log(tof / tof_0) / std::log(tof_1 / tof_0)) - 1;
+        }
+        T left = std::pow((M * pi + pi) / (8 * tof), T(2) / 3);
+        T right = std::pow(8 * tof / (M * pi), T(2) / 3);
+        T x_l = (left - 1) / (left + 1), x_r = (right - 1) / (right + 1);
+        return low_path ? std::max(x_l, x_r) : std::min(x_l, x_r);
+    }
+
+    template<typename T>
+    inline T Lambert_tof_min(T ll, int M, int max_iter, T tol) { // minimal time of flight with M revolutions
+        T x = T(0.1);
+        for (int i = 0; i < max_iter; i++) { // Halley iterations on the derivative of time of flight
+            T y = Lambert_y(x, ll);
+            T tof = Lambert_tof(x, y, ll, M);
+            T d1, d2, d3;
+            Lambert_tof_derivatives(x, y, tof, ll, d1, d2, d3);
+            T x_new = x - 2 * d1 * d2 / (2 * d2 * d2 - d1 * d3);
+            bool done = std::abs(x_new - x) < tol;
+            x = x_new;
+            if (done) break;
+        }
+        return Lambert_tof(x, Lambert_y(x, ll), ll, M);
+    }
+}
+
+/**
+     * Lambert's problem solver by D. Izzo, Revisiting Lambert's problem
+     *
+     * Finds the orbit, that connects two position vectors in given time of flight. Householder iterations
+     * start from x_guess, if it is given (finite), otherwise from Izzo's initial guess
+     * @param: R vectors of the first and the second points, time of flight, gravitational parameter,
+     * number of revolutions, prograde or retrograde motion, low or high path for multi-revolution solutions,
+     * initial guess, maximum number of iterations, tolerance
+     * @return Lambert_solution
+     *
+     */
+template<typename T>
+Lambert_solution<T> Lambert(const Vec3<T> &r1, const Vec3<T> &r2, T tof, T mu, int M = 0, bool prograde = true,
+                            bool low_path = true, T x_guess = std::numeric_limits<T>::quiet_NaN(),
+                            int max_iter = 35, T tol = T(1e-11)) {
+    const T pi = std::numbers::pi_v<T>;
+    Lambert_solution<T> solution{{0, 0, 0}, {0, 0, 0}, x_guess, 0, false};
+
+    Vec3<T> c = r2 - r1;
+    T c_norm = norm(c), r1_norm = norm(r1), r2_norm = norm(r2);
+    T s = (r1_norm + r2_norm + c_norm) / 2;
+    Vec3<T> i_r1 = r1 / r1_norm, i_r2 = r2 / r2_norm;
+    Vec3<T> i_h = cross_product(i_r1, i_r2);
+    i_h = i_h / norm(i_h);
+
+    T ll = std::sqrt(1 - std::min(T(1), c_norm / s));
+    Vec3<T> i_t1, i_t2;
+    if (i_h[2] < 0) { // transfer angle is greater than pi
+        ll = -ll;
+        i_t1 = cross_product(i_r1, i_h);
+        i_t2 = cross_product(i_r2, i_h);
+    } else {
+        i_t1 = cross_product(i_h, i_r1);
+        i_t2 = cross_product(i_h, i_r2);
+    }
+    if (!prograde) {
+        ll = -ll;
+        i_t1 = -i_t1;
+        i_t2 = -i_t2;
+    }
+
+    T tof_nd = std::sqrt(2 * mu / (s * s * s)) * tof; // non-dimensional time of flight
+    if (!(tof_nd > 0)) return solution;
+
+    int M_max = int(std::floor(tof_nd / pi));
+    T tof_00 = std::acos(ll) + ll * std::sqrt(1 - ll * ll);
+    if (M_max > 0 && tof_nd < tof_00 + M_max * pi && tof_nd < detail::Lambert_tof_min(ll, M_max, max_iter, tol))
+        M_max--;
+    if (M > M_max) return solution;
+
+    T x = std::isfinite(x_guess) ? x_guess : detail::Lambert_initial_guess(tof_nd, ll, M, low_path);
+    for (int i = 0; i < max_iter; i++) { // Householder iterations
+        T y = detail::Lambert_y(x, ll);
+        T tof_x = detail::Lambert_tof(x, y, ll, M);
+        T f = tof_x - tof_nd;
+        T d1, d2, d3;
+        detail::Lambert_tof_derivatives(x, y, tof_x, ll, d1, d2, d3);
+        T x_new = x - f * ((d1 * d1 - f * d2 / 2) / (d1 * (d1 * d1 - f * d2) + d3 * f * f / 6));
+        solution.iterations = i + 1;
+        if (!std::isfinite(x_new)) return solution;
+        bool done = std::abs(x_new - x) < tol;
+        x = x_new;
+        if (done) {
+            solution.converged = true;
+            break;
+        }
+    }
+    if (!solution.converged) return solution;
+
+    T y = detail::Lambert_y(x, ll);
+    T gamma = std::sqrt(mu * s / 2);
+    T rho = (r1_norm - r2_norm) / c_norm;
+    T sigma = std::sqrt(1 - rho * rho);
+    T v_r1 = gamma * ((ll * y - x) - rho * (ll * y + x)) / r1_norm;
+    T v_r2 = -gamma * ((ll * y - x) + rho * (ll * y + x)) / r2_norm;
+    T v_t1 = gamma * sigma * (y + ll * x) / r1_norm;
+    T v_t2 = gamma * sigma * (y + ll * x) / r2_norm;
+
+    solution.v1 = i_r1 * v_r1 + i_t1 * v_t1;
+    solution.v2 = i_r2 * v_r2 + i_t2 * v_t2;
+    solution.x = x;
+    return solution;
+}
+
+#endif //ORBITAL_MANEUVERS_LAMBERT_H
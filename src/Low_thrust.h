@@ -0,0 +1,246 @@
+#ifndef ORBITAL_MANEUVERS_LOW_THRUST_H
+#define ORBITAL_MANEUVERS_LOW_THRUST_H
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <numbers>
+#include <utility>
+#include "Orbital_elements_convertion.h"
+#include "Thread_pool.h"
+
+
+/**
+     * Electric propulsion of the spacecraft
+     *
+     * @param:
+     * thrust - thrust in N
+     * mass - initial mass in kg
+     * Isp - specific impulse in s
+     *
+     */
+template<typename T>
+struct Thruster {
+    T thrust = T(0.5);
+    T mass = 1000;
+    T Isp = 3000;
+};
+
+/**
+     * Q-law guidance and simulation parameters
+     *
+     * @param:
+     * weights - weights of p, f, g, h, k in Q, 0 leaves the element free
+     * tol - convergence tolerance of |p - p_T| / p_T and |f - f_T|, |g - g_T|, |h - h_T|, |k - k_T|
+     * steps_per_revolution - number of RK4 steps per orbital period
+     * max_time - time limit of the transfer in s
+     * n_threads - number of threads of the pool, created by the overload without pool, 0 is for all cores
+     *
+     */
+template<typename T>
+struct Qlaw_options {
+    std::array<T, 5> weights{1, 1, 1, 1, 1};
+    T tol = T(1e-3);
+    int steps_per_revolution = 64;
+    T max_time = T(3.15e8);
+    unsigned n_threads = 0;
+};
+
+/**
+     * Result of the simulated low-thrust transfer
+     *
+     * @param:
+     * delta_v - Isp g0 ln(m0 / m)
+     * time - time of flight
+     * mass - final mass
+     * final - modified equinoctial elements at the end
+     * steps - number of integration steps
+     * converged - false, if the target was not reached in max_time or the orbit became open
+     *
+     */
+template<typename T>
+struct Low_thrust_transfer {
+    T delta_v;
+    T time;
+    T mass;
+    Equinoctial<T> final;
+    std::size_t steps;
+    bool converged;
+};
+
+/**
+     * Low-thrust transfer scenario of a batch
+     *
+     */
+template<typename T>
+struct Low_thrust_scenario {
+    COE<T> initial;
+    COE<T> final;
+    Thruster<T> thruster;
+};
+
+namespace detail {
+    /**
+     * Gauss variational equations in modified equinoctial elements
+     *
+     * @param: p, f, g, h, k, L, gravitational parameter, retrograde factor
+     * @return rates of p, f, g, h, k, L per unit radial, tangential and normal acceleration, and Keplerian rate of L
+     *
+     */
+    template<typename T>
+    std::pair<std::array<std::array<T, 3>, 6>, T> Gauss_equations(const std::array<T, 6> &x, T mu, int I) {
+        const auto [p, f, g, h, k, L] = x;
+        const T sin_L = std::sin(L), cos_L = std::cos(L);
+        const T sqrt_p_mu = std::sqrt(p / mu);
+        const T w = 1 + f * cos_L + g * sin_L, s2 = 1 + h * h + k * k;
+        const T sigma = I * h * sin_L - k * cos_L;
+        std::array<std::array<T, 3>, 6> B{{
+                {0, 2 * p / w * sqrt_p_mu, 0},
+                {sqrt_p_mu * sin_L, sqrt_p_mu * ((w + 1) * cos_L + f) / w, -sqrt_p_mu * sigma * g / w},
+                {-sqrt_p_mu * cos_L, sqrt_p_mu * ((w + 1) * sin_L + g) / w, sqrt_p_mu * sigma * f / w},
+                {0, 0, I * sqrt_p_mu * s2 * cos_L / (2 * w)},
+                {0, 0, sqrt_p_mu * s2 * sin_L / (2 * w)},
+                {0, 0, sqrt_p_mu * sigma / w}}};
+        return {B, std::sqrt(mu * p) * (w / p) * (w / p)};
+    }
+
+    /**
+     * Q-law thrust direction
+     *
+     * Q = sum W_oe S_oe ((oe - oe_T) / oe_dot_xx)^2 over p, f, g, h, k, oe_dot_xx is the maximum rate of the element
+     * over thrust direction and true longitude (A.E. Petropoulos, 2005, equinoctial form of G. Varga, J. Perez, 2016).
+     * Direction is -grad Q B, the gradient is taken with frozen S_oe and oe_dot_xx
+     * @param: state, target, rates per unit acceleration, gravitational parameter, options
+     * @return unit radial, tangential and normal components, zeros at the target
+     *
+     */
+    template<typename T>
+    Vec3<T> Qlaw_direction(const std::array<T, 6> &x, const std::array<T, 6> &target,
+                           const std::array<std::array<T, 3>, 6> &B, T mu, const Qlaw_options<T> &options) {
+        const auto [p, f, g, h, k, L] = x;
+        const T sqrt_p_mu = std::sqrt(p / mu), e = std::sqrt(f * f + g * g), s2 = 1 + h * h + k * k;
+        const T dp = (p - target[0]) / (3 * target[0]);
+        const std::array<T, 5> scale{std::sqrt(1 + dp * dp * dp * dp), 1, 1, 1, 1};
+        const std::array<T, 5> rate_max{2 * p * sqrt_p_mu / (1 - e), 2 * sqrt_p_mu, 2 * sqrt_p_mu,
+                                        sqrt_p_mu * s2 / (2 * (std::sqrt(1 - g * g) + std::abs(f))),
+                                        sqrt_p_mu * s2 / (2 * (std::sqrt(1 - f * f) + std::abs(g)))};
+        Vec3<T> u{0, 0, 0};
+        for (int j = 0; j < 5; j++) {
+            const T dQ = 2 * options.weights[j] * scale[j] * (x[j] - target[j]) / (rate_max[j] * rate_max[j]);
+            u = u - Vec3<T>{B[j][0], B[j][1], B[j][2]} * dQ;
+        }
+        const T u_norm = norm(u);
+        return u_norm > 0 ? u / u_norm : u;
+    }
+
+    template<typename T>
+    bool Qlaw_converged(const std::array<T, 6> &x, const std::array<T, 6> &target, const Qlaw_options<T> &options) {
+        if (options.weights[0] != 0 && std::abs(x[0] - target[0]) > options.tol * target[0]) return false;
+        for (int j = 1; j < 5; j++)
+            if (options.weights[j] != 0 && std::abs(x[j] - target[j]) > options.tol) return false;
+        return true;
+    }
+}
+
+/**
+     * Low-thrust transfer by Q-law feedback guidance
+     *
+     * Modified equinoctial elements and mass are integrated by RK4 with continuous thrust along the Q-law direction,
+     * steps are a fraction of the current orbital period. Elements use the retrograde factor of the final orbit,
+     * so the initial orbit must not be equatorial with the opposite direction of motion.
+     * Observer is called after every step with time, elements and mass
+     * @param: Keplerian elements of initial and final orbits, thruster, options, observer
+     * @return Low_thrust_transfer
+     *
+     */
+template<typename T, typename Observer>
+Low_thrust_transfer<T> Qlaw_transfer(const COE<T> &initial, const COE<T> &final, const Thruster<T> &thruster,
+                                     const Qlaw_options<T> &options, Observer &&observer) {
+    using State = std::array<T, 6>;
+    const T mu = initial.mu, pi = std::numbers::pi_v<T>, g0 = T(9.80665);
+    const Equinoctial<T> target_ = COE2EQ(final);
+    const int I = target_.I;
+    const Equinoctial<T> start = COE2EQ(initial, I);
+    const State target{target_.p, target_.f, target_.g, target_.h, target_.k, target_.L};
+    const T mass_rate = thruster.thrust / (thruster.Isp * g0);
+
+    // derivative of elements and mass, acceleration in km/s^2
+    auto derivative = [&](const State &x, T mass, State &dx) {
+        const auto [B, L_rate] = detail::Gauss_equations(x, mu, I);
+        const Vec3<T> u = detail::Qlaw_direction(x, target, B, mu, options);
+        const T F = thruster.thrust / mass / 1000;
+        for (int j = 0; j < 6; j++) dx[j] = F * (B[j][0] * u[0] + B[j][1] * u[1] + B[j][2] * u[2]);
+        dx[5] += L_rate;
+        return norm(u) > 0 ? -mass_rate : T(0);
+    };
+
+    State x{start.p, start.f, start.g, start.h, start.k, start.L};
+    T mass = thruster.mass, t = 0;
+    Low_thrust_transfer<T> res{0, 0, mass, target_, 0, false};
+    while (t < options.max_time) {
+        if (detail::Qlaw_converged(x, target, options)) {
+            res.converged = true;
+            break;
+        }
+        const T e2 = x[1] * x[1] + x[2] * x[2];
+        if (!(x[0] > 0) || !(e2 < 1)) break;
+        const T a = x[0] / (1 - e2);
+        const T h = 2 * pi * std::sqrt(a * a * a / mu) / options.steps_per_revolution;
+
+        State k1, k2, k3, k4, y;
+        const T m1 = derivative(x, mass, k1);
+        for (int j = 0; j < 6; j++) y[j] = x[j] + h / 2 * k1[j];
+        const T m2 = derivative(y, mass + h / 2 * m1, k2);
+        for (int j = 0; j < 6; j++) y[j] = x[j] + h / 2 * k2[j];
+        const T m3 = derivative(y, mass + h / 2 * m2, k3);
+        for (int j = 0; j < 6; j++) y[j] = x[j] + h * k3[j];
+        const T m4 = derivative(y, mass + h * m3, k4);
+        for (int j = 0; j < 6; j++) x[j] += h / 6 * (k1[j] + 2 * k2[j] + 2 * k3[j] + k4[j]);
+        mass += h / 6 * (m1 + 2 * m2 + 2 * m3 + m4);
+        x[5] = detail::wrap_angle(x[5]);
+        t += h;
+        res.steps++;
+        observer(t, Equinoctial<T>{x[0], x[1], x[2], x[3], x[4], x[5], mu, I}, mass);
+    }
+    res.time = t;
+    res.mass = mass;
+    res.delta_v = thruster.Isp * g0 * std::log(thruster.mass / mass) / 1000;
+    res.final = {x[0], x[1], x[2], x[3], x[4], x[5], mu, I};
+    return res;
+}
+
+template<typename T>
+Low_thrust_transfer<T> Qlaw_transfer(const COE<T> &initial, const COE<T> &final, const Thruster<T> &thruster,
+                                     const Qlaw_options<T> &options = {}) {
+    return Qlaw_transfer(initial, final, thruster, options, [](T, const Equinoctial<T> &, T) {});
+}
+
+/**
+     * Low-thrust transfers of many scenarios by Q-law guidance
+     *
+     * Scenarios are independent and are spread over the threads of the pool
+     * @param: scenarios, thread pool, options
+     * @return transfers in the order of scenarios
+     *
+     */
+template<typename T>
+std::vector<Low_thrust_transfer<T>> Qlaw_transfer(const std::vector<Low_thrust_scenario<T>> &scenarios,
+                                                  Thread_pool &pool, const Qlaw_options<T> &options = {}) {
+    std::vector<Low_thrust_transfer<T>> transfers(scenarios.size());
+    pool.parallel_for(scenarios.size(), [&](std::size_t task, unsigned) {
+        const Low_thrust_scenario<T> &scenario = scenarios[task];
+        transfers[task] = Qlaw_transfer(scenario.initial, scenario.final, scenario.thruster, options);
+    });
+    return transfers;
+}
+
+template<typename T>
+std::vector<Low_thrust_transfer<T>> Qlaw_transfer(const std::vector<Low_thrust_scenario<T>> &scenarios,
+                                                  const Qlaw_options<T> &options = {}) {
+    Thread_pool pool(options.n_threads ? options.n_threads : std::thread::hardware_concurrency());
+    return Qlaw_transfer(scenarios, pool, options);
+}
+
+#endif //ORBITAL_MANEUVERS_LOW_THRUST_H
@@ -0,0 +1,268 @@
+#ifndef ORBITAL_MANEUVERS_MANEUVER_PLANNER_H
+#define ORBITAL_MANEUVERS_MANEUVER_PLANNER_H
+
+#include <cmath>
+#include <array>
+#include <limits>
+#include <cstddef>
+#include <algorithm>
+#include "Orbital_maneuvers.h"
+#include "Prepared_orbit.h"
+#include "Bi_elliptic_optimization.h"
+#include "Solvers.h"
+#include "Combined_transfer.h"
+
+
+/**
+     * Strategies of the planner
+     *
+     * Hohmann, Bi_elliptic - coplanar circular orbits
+     * Two_impulse - coplanar orbits (Two_impulse_burns), bi-elliptic one for elliptic orbits
+     * Inclination_only - orbits differ by inclination only
+     * Plane_change_then_transfer - General_plane_change and then two impulse transfer in the new plane
+     * Combined_plane_change - transfer between the line of nodes of non-coplanar orbits (Hohmann one for circular
+     *                         orbits), plane change is split between the two burns (Combined_transfer)
+     * Bi_elliptic_plane_change - bi-elliptic transfer between non-coplanar circular orbits, plane change is done
+     *                            at the apogee of transfer orbits
+     *
+     */
+enum class Transfer_strategy {
+    Hohmann,
+    Bi_elliptic,
+    Two_impulse,
+    Inclination_only,
+    Plane_change_then_transfer,
+    Combined_plane_change,
+    Bi_elliptic_plane_change
+};
+
+/**
+     * Cheapest transfer, found by the planner
+     *
+     * @param:
+     * strategy - strategy of the transfer
+     * delta_v - delta-v
+     * r_b - apogee radius of transfer orbits for bi-elliptic strategies, 0 for others
+     * split - part of the plane change, done at the first burn, for Combined_plane_change, 0 for others
+     *
+     */
+template<typename T>
+struct Transfer_plan {
+    Transfer_strategy strategy;
+    T delta_v;
+    T r_b = 0;
+    T split = 0;
+};
+
+/**
+     * Planner parameters
+     *
+     * @param:
+     * r_b_max_ratio - upper bound of apogee radius of bi-elliptic transfers in units of the larger radius of the orbits
+     * coplanar_tol - orbits with 1 - cos(angle between planes) below it are coplanar
+     * circular_tol - orbits with eccentricity below it are circular, 0.1 as in Classify_orbit
+     * shape_tol - orbits with a, e, W, w, that differ by less than it (relative for a), differ by inclination only
+     * tol - relative tolerance of the 1-D searches
+     * prune - skip the searches by lower bounds, false is for measuring of pruning
+     *
+     */
+template<typename T>
+struct Planner_options {
+    T r_b_max_ratio = 100;
+    T coplanar_tol = T(1e-9);
+    T circular_tol = T(0.1);
+    T shape_tol = T(1e-9);
+    T tol = T(1e-8);
+    bool prune = true;
+};
+
+/**
+     * Effectiveness of pruning, accumulated over calls of the planner
+     *
+     * @param:
+     * plans - number of planned transfers
+     * searches - number of candidates, that need a 1-D search
+     * pruned - number of them, skipped because their lower bound is not below the best delta-v found so far
+     *
+     */
+struct Planner_statistics {
+    std::size_t plans = 0;
+    std::size_t searches = 0;
+    std::size_t pruned = 0;
+};
+
+namespace detail {
+    /**
+     * Lower bound of Bi_elliptic_burns on [r_low, r_high]
+     *
+     * Speeds of the transfer orbits at |r1|, |r2| grow with r_a, speeds at r_a decrease, so each of them lies between
+     * its values at the ends, and each burn is bounded by the smallest change of speed over these ranges
+     *
+     */
+    template<typename T>
+    T Bi_elliptic_lower_bound(const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final, T r_low, T r_high) {
+        const T mu = initial.elem.mu;
+        const T r1 = initial.r_norm, r2 = final.r_norm;
+        auto speeds = [&](T r_a) { // v1h, v2h, v1ha, v2ha
+            const T p1h = 2 * r1 * r_a / (r1 + r_a), p2h = 2 * r2 * r_a / (r2 + r_a);
+            return std::array<T, 4>{std::sqrt(mu * p1h) / r1, std::sqrt(mu * p2h) / r2,
+                                    std::sqrt(mu * p1h) / r_a, std::sqrt(mu * p2h) / r_a};
+        };
+        const std::array<T, 4> low = speeds(r_low), high = speeds(r_high);
+        auto burn = [](T v_r, T v_t, T v_min, T v_max) { // to tangential speed in [v_min, v_max]
+            const T dv = std::max({T(0), v_min - v_t, v_t - v_max});
+            return std::sqrt(v_r * v_r + dv * dv);
+        };
+        return burn(initial.v_r, initial.v_t, low[0], high[0]) + std::max({T(0), high[3] - low[2], high[2] - low[3]}) +
+               burn(final.v_r, final.v_t, low[1], high[1]);
+    }
+
+    /**
+     * Check, whether a function can go below the value on a segment
+     *
+     * The segment is halved while the lower bound of a piece is below the value, up to depth times
+     * @param: lower bound of the function on a piece [x_low, x_high], segment, value, depth
+     * @return false, if the function is proven to be not below the value on the whole segment
+     *
+     */
+    template<typename T, typename Bound>
+    bool Bound_below(Bound &&bound, T x_low, T x_high, T value, int depth = 10) {
+        if (!(bound(x_low, x_high) < value)) return false;
+        if (depth == 0) return true;
+        T x_mid = (x_low + x_high) / 2;
+        return Bound_below(bound, x_low, x_mid, value, depth - 1) || Bound_below(bound, x_mid, x_high, value, depth - 1);
+    }
+
+    // burn, that changes speed from v_a to v_b and turns velocity by angle
+    template<typename T>
+    T Combined_burn(T v_a, T v_b, T angle) {
+        return std::sqrt(std::max(v_a * v_a + v_b * v_b - 2 * v_a * v_b * std::cos(angle), T(0)));
+    }
+}
+
+/**
+     * Cheapest transfer among all applicable strategies
+     *
+     * Closed-form strategies are evaluated first. Every strategy, that needs a 1-D search, has an analytic lower bound
+     * on a piece of the search interval, and the search is skipped, when detail::Bound_below proves, that delta-v is
+     * not below the best one found so far. On a piece each term of delta-v is bounded by its value at the end
+     * of the piece, where it is the smallest. For bi-elliptic transfer of elliptic orbits the terms are monotonic
+     * in r_a, see detail::Bi_elliptic_lower_bound; for bi-elliptic transfer with plane change the first and the last
+     * burns grow with r_b, the middle one is sqrt((v1b - v2b)^2 + 4 v1b v2b sin^2(alpha / 2)) and the speeds at apogee
+     * decrease with r_b. The split of plane change between the two burns is always solved for by detail::Optimal_split,
+     * its minimum is inside [0, 1] as a rule, so no bound would prune it.
+     * Plane change at one node followed by Hohmann transfer is never cheaper than the plane change combined with the
+     * Hohmann burn at the same radius, so it is not evaluated for circular orbits
+     * @param: prepared initial and final orbits, parameters, statistics to accumulate into
+     * @return Transfer_plan
+     *
+     */
+template<typename T>
+Transfer_plan<T> Plan_transfer(const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final,
+                               const Planner_options<T> &options = {}, Planner_statistics *statistics = nullptr) {
+    const COE<T> &e1 = initial.elem, &e2 = final.elem;
+    const T mu = e1.mu;
+    const T cos_alpha = std::clamp(scalar(initial.h_hat, final.h_hat), T(-1), T(1));
+    const bool coplanar = 1 - cos_alpha < options.coplanar_tol;
+    const bool circular = e1.e < options.circular_tol && e2.e < options.circular_tol;
+    Planner_statistics local;
+    Planner_statistics &stats = statistics ? *statistics : local;
+    stats.plans++;
+
+    Transfer_plan<T> best{Transfer_strategy::Two_impulse, std::numeric_limits<T>::infinity()};
+    auto candidate = [&](Transfer_plan<T> plan) { if (plan.delta_v < best.delta_v) best = plan; };
+    auto search_needed = [&](auto &&lower_bound, T x_low, T x_high) { // true, if the search can improve the plan
+        stats.searches++;
+        if (!options.prune || detail::Bound_below(lower_bound, x_low, x_high, best.delta_v)) return true;
+        stats.pruned++;
+        return false;
+    };
+
+    const T r_low = circular ? std::max(e1.a, e2.a) : std::max(initial.r_norm, final.r_norm);
+    const T r_b_max = options.r_b_max_ratio * r_low;
+
+    if (coplanar && circular) {
+        candidate({Transfer_strategy::Hohmann, Hohmann_transfer(initial, final)});
+        Bi_elliptic_optimum<T> optimum = Optimal_bi_elliptic_transfer_circular_orbits(e1, e2, r_b_max);
+        if (optimum.use_bi_elliptic) candidate({Transfer_strategy::Bi_elliptic, optimum.delta_v, optimum.r_b});
+        return best;
+    }
+
+    if (coplanar) {
+        candidate({Transfer_strategy::Two_impulse, Two_impulse_burns(initial, final)});
+        auto bound = [&](T log_low, T log_high) {
+            return detail::Bi_elliptic_lower_bound(initial, final, std::exp(log_low), std::exp(log_high));
+        };
+        if (search_needed(bound, std::log(r_low), std::log(r_b_max))) {
+            Bi_elliptic_optimum<T> optimum = Optimal_bi_elliptic_transfer_elliptic_orbits(initial, final, r_b_max,
+                                                                                          options.tol);
+            if (optimum.use_bi_elliptic) candidate({Transfer_strategy::Bi_elliptic, optimum.delta_v, optimum.r_b});
+        }
+        return best;
+    }
+
+    if (!circular) {
+        if (std::abs(e1.a - e2.a) < options.shape_tol * e1.a && std::abs(e1.e - e2.e) < options.shape_tol &&
+            std::abs(e1.W - e2.W) < options.shape_tol && std::abs(e1.w - e2.w) < options.shape_tol) {
+            candidate({Transfer_strategy::Inclination_only, Inclination_only_transfer(initial, final)});
+        }
+        // from the periapsis of the orbit after the plane change to the apoapsis of the final orbit
+        auto [delta_v1, r, v] = General_plane_change(initial, final);
+        const T p = scalar(cross_product(r, v), cross_product(r, v)) / mu;
+        const T e = norm((r * (scalar(v, v) - mu / norm(r)) - v * scalar(r, v)) / mu);
+        candidate({Transfer_strategy::Plane_change_then_transfer,
+                   delta_v1 + detail::Two_impulse_burns(mu, p / (1 + e), T(0), std::sqrt(mu / p) * (1 + e),
+                                                        e2.p / (1 - e2.e), T(0), std::sqrt(mu / e2.p) * (1 - e2.e))});
+        Split_transfer<T> combined = Combined_transfer(initial, final, options.tol, 50);
+        candidate({Transfer_strategy::Combined_plane_change, combined.delta_v, 0, combined.split});
+        return best;
+    }
+
+    // Hohmann burns with the plane change split between them
+    const T alpha = Angle_between(initial.h_hat, final.h_hat);
+    const T r1 = e1.a, r2 = e2.a, a_trans = (r1 + r2) / 2;
+    const T v1 = initial.sqrt_mu_a, v2 = final.sqrt_mu_a;
+    const T vt1 = std::sqrt(2 * mu / r1 - mu / a_trans), vt2 = std::sqrt(2 * mu / r2 - mu / a_trans);
+    auto split_delta_v = [&](T s) {
+        return detail::Combined_burn(v1, vt1, s * alpha) + detail::Combined_burn(vt2, v2, (1 - s) * alpha);
+    };
+    for (T s: {T(0), T(1)}) candidate({Transfer_strategy::Combined_plane_change, split_delta_v(s), 0, s});
+
+    const detail::Split_burns<T> burns{alpha, v1 * v1 + vt1 * vt1, v1 * vt1, vt2 * vt2 + v2 * v2, vt2 * v2};
+    const T s = detail::Optimal_split(burns, options.tol, 50); // the best split is inside as a rule
+    candidate({Transfer_strategy::Combined_plane_change, split_delta_v(s), 0, s});
+
+    // bi-elliptic transfer with the plane change at the apogee
+    auto bi_elliptic_burns = [&](T r_b) {
+        const T a1 = (r1 + r_b) / 2, a2 = (r2 + r_b) / 2;
+        return std::array<T, 4>{std::sqrt(2 * mu / r1 - mu / a1), std::sqrt(2 * mu / r_b - mu / a1),
+                                std::sqrt(2 * mu / r_b - mu / a2), std::sqrt(2 * mu / r2 - mu / a2)};
+    };
+    auto bi_elliptic_delta_v = [&](T log_r) {
+        auto [v1a, v1b, v2b, v2c] = bi_elliptic_burns(std::exp(log_r));
+        return (v1a - v1) + detail::Combined_burn(v1b, v2b, alpha) + (v2c - v2);
+    };
+    if (r_b_max <= r_low) return best;
+    const T sin_half = std::sin(alpha / 2);
+    auto bi_elliptic_bound = [&](T log_low, T log_high) { // the first and the last burns grow with r_b,
+        const std::array<T, 4> low = bi_elliptic_burns(std::exp(log_low)); // speeds at the apogee decrease
+        const std::array<T, 4> high = bi_elliptic_burns(std::exp(log_high));
+        const T dv = std::max({T(0), high[2] - low[1], high[1] - low[2]});
+        return (low[0] - v1) + (low[3] - v2) + std::sqrt(dv * dv + 4 * high[1] * high[2] * sin_half * sin_half);
+    };
+    if (search_needed(bi_elliptic_bound, std::log(r_low), std::log(r_b_max))) {
+        auto [log_r, delta_v] = Brent_minimize(bi_elliptic_delta_v, std::log(r_low), std::log(r_b_max), options.tol);
+        T end_delta_v = bi_elliptic_delta_v(std::log(r_b_max));
+        if (end_delta_v < delta_v) delta_v = end_delta_v, log_r = std::log(r_b_max);
+        candidate({Transfer_strategy::Bi_elliptic_plane_change, delta_v, std::exp(log_r)});
+    }
+    return best;
+}
+
+template<typename T>
+Transfer_plan<T> Plan_transfer(const COE<T> &initial, const COE<T> &final, const Planner_options<T> &options = {},
+                               Planner_statistics *statistics = nullptr) {
+    return Plan_transfer(Prepared_orbit<T>(initial), Prepared_orbit<T>(final), options, statistics);
+}
+
+#endif //ORBITAL_MANEUVERS_MANEUVER_PLANNER_H
@@ -0,0 +1,67 @@
+#ifndef ORBITAL_MANEUVERS_MAPPED_FILE_H
+#define ORBITAL_MANEUVERS_MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <cerrno>
+#include <cstddef>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/**
+     * Read-only memory-mapped file
+     *
+     * Contents are used in place without copies. For sequential reading pages are read by the kernel ahead
+     * of the reader (MADV_SEQUENTIAL), otherwise they are loaded on first access.
+     * Errors of open and mmap are thrown as std::system_error
+     *
+     */
+class Mapped_file {
+private:
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+
+public:
+    explicit Mapped_file(const std::string &path, bool sequential = true) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), path);
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), path);
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ > 0) {
+            void *map = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED) {
+                int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), path);
+            }
+            if (sequential) ::madvise(map, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char *>(map);
+        }
+        ::close(fd);
+    }
+
+    Mapped_file(const Mapped_file &) = delete;
+
+    Mapped_file &operator=(const Mapped_file &) = delete;
+
+    ~Mapped_file() {
+        if (data_) ::munmap(const_cast<char *>(data_), size_);
+    }
+
+    const char *data() const { return data_; }
+
+    std::size_t size() const { return size_; }
+
+    std::string_view view() const { return {data_, size_}; }
+};
+
+#endif //ORBITAL_MANEUVERS_MAPPED_FILE_H
@@ -0,0 +1,524 @@
+#ifndef ORBITAL_MANEUVERS_NUMERICAL_PROPAGATION_H
+#define ORBITAL_MANEUVERS_NUMERICAL_PROPAGATION_H
+
+#include <span>
+#include <array>
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include "Vector.h"
+#include "Batch_convertion.h"
+#include "Simd_convertion.h"
+
+
+/**
+     * Force model of numerical propagation
+     *
+     * Gravity of oblate planet (J2) and drag of exponential atmosphere, that rotates with the planet. Defaults are Earth,
+     * atmosphere is fitted at 400 km (D.A. Vallado, table 8-4)
+     * @param:
+     * mu - gravitational parameter
+     * J2 - second zonal harmonic, 0 for two-body motion
+     * R - equatorial radius
+     * drag - ballistic coefficient C_d A / m in m^2/kg, 0 without drag
+     * rho0 - density of the atmosphere at altitude h0 in kg/m^3
+     * h0 - reference altitude
+     * H - scale height
+     * omega - angular velocity of the planet around z axis
+     *
+     */
+template<typename T>
+struct Force_model {
+    T mu = T(398600.4415);
+    T J2 = T(1.08262668e-3);
+    T R = T(6378.137);
+    T drag = 0;
+    T rho0 = T(2.803e-12);
+    T h0 = 400;
+    T H = T(58.515);
+    T omega = T(7.292115e-5);
+};
+
+/**
+     * Parameters of adaptive step of Dormand-Prince 8(5,3) integrator
+     *
+     * @param:
+     * rtol, atol - relative and absolute tolerance of every component of the state, rtol is not less than 100 epsilon
+     * h_initial - first step, 0 - estimated from the state
+     * max_steps - maximum number of accepted and rejected steps of one orbit
+     *
+     */
+template<typename T>
+struct Integrator_options {
+    T rtol = T(1e-10);
+    T atol = T(1e-10);
+    T h_initial = 0;
+    std::size_t max_steps = 1000000;
+};
+
+/**
+     * Result of numerical propagation of one orbit
+     *
+     * @param:
+     * r, v - RV vectors after time step
+     * steps, rejected - numbers of accepted and rejected steps
+     * converged - false, if max_steps were done or the step became less than rounding of time
+     *
+     */
+template<typename T>
+struct Numerical_solution {
+    Vec3<T> r, v;
+    std::size_t steps;
+    std::size_t rejected;
+    bool converged;
+};
+
+/**
+     * Work of batch numerical propagation
+     *
+     * @param:
+     * steps, rejected - numbers of accepted and rejected steps of all orbits
+     * evaluations - number of evaluations of the force model for one orbit
+     * failed - number of orbits, that did not converge
+     *
+     */
+struct Propagation_statistics {
+    std::size_t steps = 0;
+    std::size_t rejected = 0;
+    std::size_t evaluations = 0;
+    std::size_t failed = 0;
+};
+
+namespace detail {
+    /**
+     * Dormand-Prince 8(5,3) tableau
+     *
+     * E. Hairer, S.P. Norsett, G. Wanner, Solving Ordinary Differential Equations I, code DOP853. 12 stages,
+     * b is the 8th order solution, e5 and e3 are the 5th and 3rd order error estimators
+     *
+     */
+    template<typename T>
+    struct Dop853 {
+        static constexpr int stages = 12;
+
+        static constexpr T a[stages][stages] = {
+                {},
+                {T(5.26001519587677318785587544488e-2)},
+                {T(1.97250569845378994544595329183e-2), T(5.91751709536136983633785987549e-2)},
+                {T(2.95875854768068491816892993775e-2), 0, T(8.87627564304205475450678981324e-2)},
+                {T(2.41365134159266685502369798665e-1), 0, T(-8.84549479328286085344864962717e-1),
+                 T(9.24834003261792003115737966543e-1)},
+                {T(3.7037037037037037037037037037e-2), 0, 0, T(1.70828608729473871279604482173e-1),
+                 T(1.25467687566822425016691814123e-1)},
+                {T(3.7109375e-2), 0, 0, T(1.70252211019544039314978060272e-1), T(6.02165389804559606850219397283e-2),
+                 T(-1.7578125e-2)},
+                {T(3.70920001185047927108779319836e-2), 0, 0, T(1.70383925712239993810214054705e-1),
+                 T(1.07262030446373284651809199168e-1), T(-1.53194377486244017527936158236e-2),
+                 T(8.27378916381402288758473766002e-3)},
+                {T(6.24110958716075717114429577812e-1), 0, 0, T(-3.36089262944694129406857109825),
+                 T(-8.68219346841726006818189891453e-1), T(2.75920996994467083049415600797e1),
+                 T(2.01540675504778934086186788979e1), T(-4.34898841810699588477366255144e1)},
+                {T(4.77662536438264365890433908527e-1), 0, 0, T(-2.48811461997166764192642586468),
+                 T(-5.90290826836842996371446475743e-1), T(2.12300514481811942347288949897e1),
+                 T(1.52792336328824235832596922938e1), T(-3.32882109689848629194453265587e1),
+                 T(-2.03312017085086261358222928593e-2)},
+                {T(-9.3714243008598732571704021658e-1), 0, 0, T(5.18637242884406370830023853209),
+                 T(1.09143734899672957818500254654), T(-8.14978701074692612513997267357),
+                 T(-1.85200656599969598641566180701e1), T(2.27394870993505042818970056734e1),
+                 T(2.49360555267965238987089396762), T(-3.0467644718982195003823669022)},
+                {T(2.27331014751653820792359768449), 0, 0, T(-1.05344954667372501984066689879e1),
+                 T(-2.00087205822486249909675718444), T(-1.79589318631187989172765950534e1),
+                 T(2.79488845294199600508499808837e1), T(-2.85899827713502369474065508674),
+                 T(-8.87285693353062954433549289258), T(1.23605671757943030647266201528e1),
+                 T(6.43392746015763530355970484046e-1)}};
+
+        static constexpr T b[stages] = {
+                T(5.42937341165687622380535766363e-2), 0, 0, 0, 0, T(4.45031289275240888144113950566),
+                T(1.89151789931450038304281599044), T(-5.8012039600105847814672114227),
+                T(3.1116436695781989440891606237e-1), T(-1.52160949662516078556178806805e-1),
+                T(2.01365400804030348374776537501e-1), T(4.47106157277725905176885569043e-2)};
+
+        static constexpr T e5[stages] = {
+                T(0.1312004499419488073250102996e-1), 0, 0, 0, 0, T(-0.1225156446376204440720569753e+1),
+                T(-0.4957589496572501915214079952), T(0.1664377182454986536961530415e+1),
+                T(-0.3503288487499736816886487290), T(0.3341791187130174790297318841),
+                T(0.8192320648511571246570742613e-1), T(-0.2235530786388629525884427845e-1)};
+
+        static constexpr T e3[stages] = { // b - bhh
+                b[0] - T(0.244094488188976377952755905512), 0, 0, 0, 0, b[5], b[6], b[7],
+                b[8] - T(0.733846688281611857341361741547), b[9], b[10],
+                b[11] - T(0.220588235294117647058823529412e-1)};
+    };
+
+    /**
+     * Gravity acceleration with J2
+     *
+     * @param: R vector, gravitational parameter, 1.5 J2 R^2
+     * @return acceleration
+     *
+     */
+    template<typename T>
+    inline Vec3<T> Gravity(T x, T y, T z, T mu, T j2) {
+        const T r2 = x * x + y * y + z * z;
+        const T mu_r3 = mu / (r2 * std::sqrt(r2));
+        const T q = j2 / r2;
+        const T c_xy = -mu_r3 * (1 + q * (1 - 5 * z * z / r2));
+        return {c_xy * x, c_xy * y, c_xy * z - 2 * mu_r3 * q * z};
+    }
+
+    /**
+     * Drag acceleration in exponential atmosphere, that rotates with the planet
+     *
+     * -rho |v_rel| v_rel C_d A / (2 m), 1000 converts m^2/kg * kg/m^3 to 1/km
+     * @param: RV vectors, force model
+     * @return acceleration
+     *
+     */
+    template<typename T>
+    inline Vec3<T> Drag(T x, T y, T z, T vx, T vy, T vz, const Force_model<T> &model) {
+        const T vx_ = vx + model.omega * y, vy_ = vy - model.omega * x; // velocity relative to the atmosphere
+        const T h = std::sqrt(x * x + y * y + z * z) - model.R;
+        const T rho = model.rho0 * std::exp((model.h0 - h) / model.H);
+        const T c = -T(500) * model.drag * rho * std::sqrt(vx_ * vx_ + vy_ * vy_ + vz * vz);
+        return {c * vx_, c * vy_, c * vz};
+    }
+
+    template<typename T>
+    inline std::array<T, 6> Derivative(const std::array<T, 6> &y, const Force_model<T> &model) {
+        Vec3<T> a = Gravity(y[0], y[1], y[2], model.mu, T(1.5) * model.J2 * model.R * model.R);
+        if (model.drag != 0) a = a + Drag(y[0], y[1], y[2], y[3], y[4], y[5], model);
+        return {y[3], y[4], y[5], a[0], a[1], a[2]};
+    }
+
+    /**
+     * Norm of the error of DOP853 step
+     *
+     * Hairer's combination of the 5th and 3rd order estimators, err5^2 / sqrt(err5^2 + 0.01 err3^2) per component,
+     * components are divided by atol + rtol max(|y|, |y_new|)
+     * @param: sums of squares of scaled err5 and err3, |h|, dimension of the state
+     * @return error norm, the step is accepted, if it is below 1
+     *
+     */
+    template<typename T>
+    inline T Error_norm(T err5, T err3, T h, int dimension) {
+        const T denominator = err5 + T(0.01) * err3;
+        return denominator > 0 ? h * err5 / std::sqrt(denominator * dimension) : 0;
+    }
+
+    /**
+     * Factor of the next step after accepted or rejected step
+     *
+     * 0.9 err^(-1/8) within [0.2, 10], not above 1 right after a rejection
+     * @param: error norm, whether the step is accepted, whether the previous step was rejected
+     * @return factor
+     *
+     */
+    template<typename T>
+    inline T Step_factor(T error, bool accepted, bool after_rejection) {
+        const T factor = error > 0 ? T(0.9) * std::pow(error, T(-0.125)) : T(10);
+        if (!accepted) return std::max(T(0.2), std::min(T(1), factor));
+        return std::min(after_rejection ? T(1) : T(10), std::max(T(0.2), factor));
+    }
+
+    /**
+     * First step from the state and its derivative
+     *
+     * h = 0.01 |y| / |f| in scaled norm (first part of Hairer's HINIT), not longer than the whole time step
+     * @param: sums of squares of scaled state and its derivative, |dt|
+     * @return |h|
+     *
+     */
+    template<typename T>
+    inline T Initial_step(T y2, T f2, T dt) {
+        const T h = (y2 < T(1e-10) || f2 < T(1e-10)) ? T(1e-6) : T(0.01) * std::sqrt(y2 / f2);
+        return std::min(h, dt);
+    }
+}
+
+/**
+     * Numerical propagation of RV vectors with J2 and drag
+     *
+     * Adaptive Dormand-Prince 8(5,3) on fixed-size state, no allocation per step. The last step ends exactly at dt,
+     * negative dt propagates backwards
+     * @param: RV vectors, time step, force model, integrator parameters
+     * @return Numerical_solution
+     *
+     */
+template<typename T>
+Numerical_solution<T> Numerical_propagation(const Vec3<T> &r0, const Vec3<T> &v0, T dt,
+                                            const Force_model<T> &model = {},
+                                            const Integrator_options<T> &options = {}) {
+    using Tableau = detail::Dop853<T>;
+    using State = std::array<T, 6>;
+    const T rtol = std::max(options.rtol, 100 * std::numeric_limits<T>::epsilon()), atol = options.atol;
+    const T direction = dt < 0 ? -1 : 1, span_ = std::abs(dt);
+
+    State y{r0[0], r0[1], r0[2], v0[0], v0[1], v0[2]};
+    std::array<State, Tableau::stages> K;
+    K[0] = detail::Derivative(y, model);
+    Numerical_solution<T> res{r0, v0, 0, 0, true};
+
+    T h = options.h_initial;
+    if (!(h > 0)) {
+        T y2 = 0, f2 = 0;
+        for (int c = 0; c < 6; c++) {
+            const T scale = atol + rtol * std::abs(y[c]);
+            y2 += y[c] * y[c] / (scale * scale), f2 += K[0][c] * K[0][c] / (scale * scale);
+        }
+        h = detail::Initial_step(y2, f2, span_);
+    }
+
+    T t = 0; // |time| from the start
+    bool after_rejection = false;
+    while (t < span_) {
+        if (res.steps + res.rejected >= options.max_steps ||
+            h < 16 * std::numeric_limits<T>::epsilon() * std::max(t, T(1))) {
+            res.converged = false;
+            break;
+        }
+        const bool last = h >= span_ - t;
+        const T h_ = last ? span_ - t : h;
+        const T step = direction * h_;
+
+        for (int s = 1; s < Tableau::stages; s++) {
+            State y_s = y;
+            for (int j = 0; j < s; j++) {
+                if (Tableau::a[s][j] == 0) continue;
+                for (int c = 0; c < 6; c++) y_s[c] += step * Tableau::a[s][j] * K[j][c];
+            }
+            K[s] = detail::Derivative(y_s, model);
+        }
+
+        State y_new = y;
+        T err5 = 0, err3 = 0;
+        for (int c = 0; c < 6; c++) {
+            T sum = 0, sum5 = 0, sum3 = 0;
+            for (int j = 0; j < Tableau::stages; j++) {
+                sum += Tableau::b[j] * K[j][c];
+                sum5 += Tableau::e5[j] * K[j][c];
+                sum3 += Tableau::e3[j] * K[j][c];
+            }
+            y_new[c] += step * sum;
+            const T scale = atol + rtol * std::max(std::abs(y[c]), std::abs(y_new[c]));
+            err5 += sum5 * sum5 / (scale * scale), err3 += sum3 * sum3 / (scale * scale);
+        }
+        const T error = detail::Error_norm(err5, err3, h_, 6);
+        const bool accepted = error < 1;
+        h = h_ * detail::Step_factor(error, accepted, after_rejection);
+        after_rejection = !accepted;
+        if (!accepted) {
+            res.rejected++;
+            continue;
+        }
+        res.steps++;
+        t = last ? span_ : t + h_;
+        y = y_new;
+        K[0] = detail::Derivative(y, model);
+    }
+    res.r = {y[0], y[1], y[2]};
+    res.v = {y[3], y[4], y[5]};
+    return res;
+}
+
+namespace detail {
+    /**
+     * Linear combination of columns, out = y + h * sum(c_j K_j) or sum(c_j K_j) without y
+     *
+     * @param: state column, step column, columns K_j, coefficients c_j, number of columns, output column, size,
+     * instruction set
+     *
+     */
+    template<typename T>
+    void Combination(const T *y, const T *h, const T *const *K, const T *c, int count, T *out, std::size_t n,
+                     Simd_level level) {
+        std::size_t done = 0;
+#if ORBITAL_MANEUVERS_X86_SIMD
+        if constexpr (std::is_same_v<T, double>) {
+            if (level == Simd_level::avx512) done = simd_avx512::Combination_kernel(y, h, K, c, count, out, n);
+            if (level == Simd_level::avx2) done = simd_avx2::Combination_kernel(y, h, K, c, count, out, n);
+        }
+#endif
+        for (std::size_t m = done; m < n; m++) {
+            T sum = 0;
+            for (int j = 0; j < count; j++) sum += c[j] * K[j][m];
+            out[m] = y ? y[m] + h[m] * sum : sum;
+        }
+    }
+
+    /**
+     * Derivative of the states of many orbits, stored as 6 columns of size n
+     *
+     * Gravity goes through J2_kernel of the instruction set, drag is added by scalar loop
+     * @param: pointer to the states (column c of orbit m at c * stride + m), stride, number of orbits, output derivatives
+     * of the same layout, force model, instruction set
+     *
+     */
+    template<typename T>
+    void Derivative_columns(const T *y, std::size_t stride, std::size_t n, T *dy, const Force_model<T> &model,
+                            Simd_level level) {
+        const T *x = y, *y_ = y + stride, *z = y + 2 * stride;
+        T *ax = dy + 3 * stride, *ay = dy + 4 * stride, *az = dy + 5 * stride;
+        std::copy_n(y + 3 * stride, n, dy);
+        std::copy_n(y + 4 * stride, n, dy + stride);
+        std::copy_n(y + 5 * stride, n, dy + 2 * stride);
+        const T j2 = T(1.5) * model.J2 * model.R * model.R;
+        std::size_t done = 0;
+#if ORBITAL_MANEUVERS_X86_SIMD
+        if constexpr (std::is_same_v<T, double>) {
+            if (level == Simd_level::avx512) done = simd_avx512::J2_kernel(x, y_, z, model.mu, j2, ax, ay, az, n);
+            if (level == Simd_level::avx2) done = simd_avx2::J2_kernel(x, y_, z, model.mu, j2, ax, ay, az, n);
+        }
+#endif
+        for (std::size_t m = done; m < n; m++) {
+            const Vec3<T> a = Gravity(x[m], y_[m], z[m], model.mu, j2);
+            ax[m] = a[0], ay[m] = a[1], az[m] = a[2];
+        }
+        if (model.drag == 0) return;
+        for (std::size_t m = 0; m < n; m++) {
+            const Vec3<T> a = Drag(x[m], y_[m], z[m], dy[m], dy[stride + m], dy[2 * stride + m], model);
+            ax[m] += a[0], ay[m] += a[1], az[m] += a[2];
+        }
+    }
+}
+
+/**
+     * Batch numerical propagation of many orbits by the same time step
+     *
+     * Orbits are integrated in lockstep on structure of arrays: every iteration makes one step of every unfinished
+     * orbit with its own step size, stages evaluate the force model for all of them by SIMD kernels. Finished orbits
+     * are swapped out of the active columns, so the columns stay dense. No allocation after the start.
+     * RV vectors of orbits, that did not converge, are NaN
+     * @param: RV vectors columns, time step, output RV vectors columns, force model, integrator parameters,
+     * instruction set
+     * @return Propagation_statistics
+     *
+     */
+template<typename T>
+Propagation_statistics Numerical_propagation(const RV_columns<const T> &rv0, T dt, const RV_columns<T> &rv,
+                                             const Force_model<T> &model = {},
+                                             const Integrator_options<T> &options = {},
+                                             Simd_level level = supported_simd_level()) {
+    using Tableau = detail::Dop853<T>;
+    const T rtol = std::max(options.rtol, 100 * std::numeric_limits<T>::epsilon()), atol = options.atol;
+    const T direction = dt < 0 ? -1 : 1, span_ = std::abs(dt);
+    const std::size_t n = rv0.size();
+#if ORBITAL_MANEUVERS_X86_SIMD
+    if (level > supported_simd_level()) level = supported_simd_level();
+#endif
+
+    // column c of orbit in slot m is at [c * n + m], stage s at K[(s * 6 + c) * n + m]
+    std::vector<T> y(6 * n), y_s(6 * n), y_new(6 * n), K(Tableau::stages * 6 * n);
+    std::vector<T> t(n, 0), h(n, options.h_initial), h_(n), sum5(n), sum3(n), err5(n), err3(n);
+    std::array<const T *, Tableau::stages> columns;
+    std::array<T, Tableau::stages> coefficients;
+    std::vector<std::size_t> owner(n), steps(n, 0);
+    std::vector<char> after_rejection(n, 0);
+    for (std::size_t m = 0; m < n; m++) {
+        const std::array<T, 6> state{rv0.x[m], rv0.y[m], rv0.z[m], rv0.vx[m], rv0.vy[m], rv0.vz[m]};
+        for (int c = 0; c < 6; c++) y[c * n + m] = state[c];
+        owner[m] = m;
+    }
+    Propagation_statistics statistics;
+    detail::Derivative_columns(y.data(), n, n, K.data(), model, level);
+    statistics.evaluations++;
+    for (std::size_t m = 0; m < n; m++) {
+        if (h[m] > 0) continue;
+        T y2 = 0, f2 = 0;
+        for (int c = 0; c < 6; c++) {
+            const T y_ = y[c * n + m], f = K[c * n + m], scale = atol + rtol * std::abs(y_);
+            y2 += y_ * y_ / (scale * scale), f2 += f * f / (scale * scale);
+        }
+        h[m] = detail::Initial_step(y2, f2, span_);
+    }
+
+    auto write = [&](std::size_t m, bool converged) {
+        const std::size_t k = owner[m];
+        const T nan = std::numeric_limits<T>::quiet_NaN();
+        rv.x[k] = converged ? y[m] : nan, rv.y[k] = converged ? y[n + m] : nan;
+        rv.z[k] = converged ? y[2 * n + m] : nan, rv.vx[k] = converged ? y[3 * n + m] : nan;
+        rv.vy[k] = converged ? y[4 * n + m] : nan, rv.vz[k] = converged ? y[5 * n + m] : nan;
+        statistics.failed += !converged;
+    };
+    auto move = [&](std::size_t from, std::size_t to) { // slot from -> slot to
+        for (int c = 0; c < 6; c++) y[c * n + to] = y[c * n + from];
+        t[to] = t[from], h[to] = h[from], owner[to] = owner[from], steps[to] = steps[from];
+        after_rejection[to] = after_rejection[from];
+    };
+
+    std::size_t active = n;
+    if (!(span_ > 0)) {
+        for (std::size_t m = 0; m < n; m++) write(m, true);
+        active = 0;
+    }
+    while (active > 0) {
+        for (std::size_t m = 0; m < active; m++) h_[m] = direction * std::min(h[m], span_ - t[m]);
+
+        for (int s = 1; s < Tableau::stages; s++) {
+            for (int c = 0; c < 6; c++) {
+                int count = 0;
+                for (int j = 0; j < s; j++) {
+                    if (Tableau::a[s][j] == 0) continue;
+                    coefficients[count] = Tableau::a[s][j], columns[count++] = K.data() + (j * 6 + c) * n;
+                }
+                detail::Combination(y.data() + c * n, h_.data(), columns.data(), coefficients.data(), count,
+                                    y_s.data() + c * n, active, level);
+            }
+            detail::Derivative_columns(y_s.data(), n, active, K.data() + s * 6 * n, model, level);
+        }
+        statistics.evaluations += Tableau::stages - 1;
+
+        std::fill_n(err5.begin(), active, T(0));
+        std::fill_n(err3.begin(), active, T(0));
+        for (int c = 0; c < 6; c++) {
+            for (int j = 0; j < Tableau::stages; j++) columns[j] = K.data() + (j * 6 + c) * n;
+            const T *y_ = y.data() + c * n;
+            T *y_new_ = y_new.data() + c * n;
+            detail::Combination(y_, h_.data(), columns.data(), Tableau::b, Tableau::stages, y_new_, active, level);
+            detail::Combination<T>(nullptr, nullptr, columns.data(), Tableau::e5, Tableau::stages, sum5.data(),
+                                   active, level);
+            detail::Combination<T>(nullptr, nullptr, columns.data(), Tableau::e3, Tableau::stages, sum3.data(),
+                                   active, level);
+            for (std::size_t m = 0; m < active; m++) {
+                const T scale = atol + rtol * std::max(std::abs(y_[m]), std::abs(y_new_[m]));
+                const T inv2 = 1 / (scale * scale);
+                err5[m] += sum5[m] * sum5[m] * inv2, err3[m] += sum3[m] * sum3[m] * inv2;
+            }
+        }
+
+        std::size_t kept = 0;
+        for (std::size_t m = 0; m < active; m++) {
+            const T step = std::abs(h_[m]);
+            const T error_ = detail::Error_norm(err5[m], err3[m], step, 6);
+            const bool accepted = error_ < 1;
+            h[m] = step * detail::Step_factor(error_, accepted, bool(after_rejection[m]));
+            after_rejection[m] = !accepted;
+            if (accepted) {
+                t[m] = step >= span_ - t[m] ? span_ : t[m] + step;
+                for (int c = 0; c < 6; c++) y[c * n + m] = y_new[c * n + m];
+                steps[m]++, statistics.steps++;
+            } else {
+                steps[m]++, statistics.rejected++;
+            }
+            const bool stuck = steps[m] >= options.max_steps ||
+                               h[m] < 16 * std::numeric_limits<T>::epsilon() * std::max(t[m], T(1));
+            if (t[m] >= span_ || stuck) {
+                write(m, t[m] >= span_);
+                continue;
+            }
+            if (kept != m) move(m, kept);
+            kept++;
+        }
+        active = kept;
+        if (active == 0) break;
+        // derivative at the new states, orbits after rejected steps get the same values again
+        detail::Derivative_columns(y.data(), n, active, K.data(), model, level);
+        statistics.evaluations++;
+    }
+    return statistics;
+}
+
+#endif //ORBITAL_MANEUVERS_NUMERICAL_PROPAGATION_H
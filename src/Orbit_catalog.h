@@ -0,0 +1,215 @@
+#ifndef ORBITAL_MANEUVERS_ORBIT_CATALOG_H
+#define ORBITAL_MANEUVERS_ORBIT_CATALOG_H
+
+#include <span>
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <algorithm>
+#include <type_traits>
+#include "Batch_convertion.h"
+#include "Mapped_file.h"
+
+
+/**
+     * Header of columnar orbit catalog file
+     *
+     * File layout: 64-byte header, then columns p, a, e, i, W, w, nu of size scalars of scalar_bytes (4 or 8)
+     * and column flag of size bytes. Every column starts at a multiple of 64 bytes, the gaps are zeros,
+     * angles are stored as in COE_columns. Numbers are in native byte order, byte_order tells it
+     * @param:
+     * magic - "ORBCAT" and two zero bytes
+     * version - version of the format
+     * byte_order - 0x01020304 written in native byte order
+     * scalar_bytes - 4 for float columns, 8 for double ones
+     * size - number of orbits
+     * mu - gravitational parameter
+     * epoch - epoch of the elements, not interpreted
+     *
+     */
+struct Orbit_catalog_header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t scalar_bytes;
+    std::uint32_t reserved0;
+    std::uint64_t size;
+    double mu;
+    double epoch;
+    std::uint64_t reserved[2];
+};
+
+static_assert(sizeof(Orbit_catalog_header) == 64);
+
+namespace detail {
+    inline constexpr char catalog_magic[8] = {'O', 'R', 'B', 'C', 'A', 'T', 0, 0};
+    inline constexpr std::uint32_t catalog_version = 1;
+    inline constexpr std::uint32_t catalog_byte_order = 0x01020304;
+
+    inline std::size_t Catalog_padded(std::size_t bytes) { return (bytes + 63) / 64 * 64; }
+
+    // offset of column c (0 - 6 for p ... nu, 7 for flag) in the file
+    inline std::size_t Catalog_column_offset(int c, std::size_t size, std::size_t scalar_bytes) {
+        return sizeof(Orbit_catalog_header) + c * Catalog_padded(size * scalar_bytes);
+    }
+
+    inline std::size_t Catalog_file_size(std::size_t size, std::size_t scalar_bytes) {
+        return Catalog_column_offset(7, size, scalar_bytes) + Catalog_padded(size);
+    }
+}
+
+/**
+     * Writing of columnar orbit catalog file
+     *
+     * Columns are converted to Storage (float or double) in blocks and written one after another
+     * @param: path, Keplerian elements columns, gravitational parameter, epoch
+     *
+     */
+template<typename Storage, typename T>
+void Write_orbit_catalog(const std::string &path, const COE_columns<const T> &elem, T mu, double epoch = 0) {
+    static_assert(std::is_same_v<Storage, float> || std::is_same_v<Storage, double>);
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file) throw std::system_error(errno, std::generic_category(), path);
+    auto write = [&](const void *data, std::size_t bytes) {
+        if (bytes && std::fwrite(data, 1, bytes, file) != bytes) {
+            int error = errno;
+            std::fclose(file);
+            throw std::system_error(error, std::generic_category(), path);
+        }
+    };
+    const std::size_t n = elem.size();
+    const std::array<char, 64> zeros{};
+    auto pad = [&](std::size_t bytes) { write(zeros.data(), detail::Catalog_padded(bytes) - bytes); };
+
+    Orbit_catalog_header header{};
+    std::memcpy(header.magic, detail::catalog_magic, sizeof(header.magic));
+    header.version = detail::catalog_version;
+    header.byte_order = detail::catalog_byte_order;
+    header.scalar_bytes = sizeof(Storage);
+    header.size = n;
+    header.mu = double(mu);
+    header.epoch = epoch;
+    write(&header, sizeof(header));
+
+    constexpr std::size_t block = 4096;
+    std::array<Storage, block> buffer;
+    for (std::span<const T> column: {elem.p, elem.a, elem.e, elem.i, elem.W, elem.w, elem.nu}) {
+        for (std::size_t k0 = 0; k0 < n; k0 += block) {
+            const std::size_t m = std::min(block, n - k0);
+            for (std::size_t k = 0; k < m; k++) buffer[k] = Storage(column[k0 + k]);
+            write(buffer.data(), m * sizeof(Storage));
+        }
+        pad(n * sizeof(Storage));
+    }
+    std::array<std::uint8_t, block> flags;
+    for (std::size_t k0 = 0; k0 < n; k0 += block) {
+        const std::size_t m = std::min(block, n - k0);
+        for (std::size_t k = 0; k < m; k++) flags[k] = std::uint8_t(elem.flag[k0 + k]);
+        write(flags.data(), m);
+    }
+    pad(n);
+    if (std::fclose(file) != 0) throw std::system_error(errno, std::generic_category(), path);
+}
+
+/**
+     * Memory-mapped columnar orbit catalog
+     *
+     * Opening checks the header and the size of the file and touches no column, so it does not depend
+     * on the number of orbits. Columns are spans into the mapping, flags are stored in one byte each
+     * @param: Storage - float or double, must match scalar_bytes of the file
+     *
+     */
+template<typename Storage>
+class Orbit_catalog {
+private:
+    Mapped_file file_;
+    Orbit_catalog_header header_;
+
+    const char *column_data(int c) const {
+        return file_.data() + detail::Catalog_column_offset(c, size(), sizeof(Storage));
+    }
+
+    std::span<const Storage> column(int c) const {
+        return {reinterpret_cast<const Storage *>(column_data(c)), size()};
+    }
+
+public:
+    /**
+     * Opening of catalog file
+     *
+     * Errors of the file are thrown as std::system_error, wrong format as std::runtime_error
+     * @param: path
+     *
+     */
+    explicit Orbit_catalog(const std::string &path) : file_(path, false), header_{} {
+        static_assert(std::is_same_v<Storage, float> || std::is_same_v<Storage, double>);
+        if (file_.size() < sizeof(header_)) throw std::runtime_error(path + ": not an orbit catalog");
+        std::memcpy(&header_, file_.data(), sizeof(header_));
+        if (std::memcmp(header_.magic, detail::catalog_magic, sizeof(header_.magic)) != 0)
+            throw std::runtime_error(path + ": not an orbit catalog");
+        if (header_.version != detail::catalog_version || header_.byte_order != detail::catalog_byte_order)
+            throw std::runtime_error(path + ": unsupported version or byte order");
+        if (header_.scalar_bytes != sizeof(Storage))
+            throw std::runtime_error(path + ": columns are of " + std::to_string(header_.scalar_bytes) + " bytes");
+        // size is bounded by the file before the multiplications, so a forged size can not overflow them
+        if (header_.size > (file_.size() - sizeof(header_)) / (7 * sizeof(Storage) + 1) ||
+            file_.size() < detail::Catalog_file_size(header_.size, sizeof(Storage)))
+            throw std::runtime_error(path + ": file is truncated");
+    }
+
+    std::size_t size() const { return header_.size; }
+
+    double mu() const { return header_.mu; }
+
+    double epoch() const { return header_.epoch; }
+
+    std::span<const Storage> p() const { return column(0); }
+
+    std::span<const Storage> a() const { return column(1); }
+
+    std::span<const Storage> e() const { return column(2); }
+
+    std::span<const Storage> i() const { return column(3); }
+
+    std::span<const Storage> W() const { return column(4); }
+
+    std::span<const Storage> w() const { return column(5); }
+
+    std::span<const Storage> nu() const { return column(6); }
+
+    std::span<const std::uint8_t> flag() const {
+        return {reinterpret_cast<const std::uint8_t *>(column_data(7)), size()};
+    }
+
+    /**
+     * Columns for batch functions
+     *
+     * Scalar columns are the mapping itself, only flags are widened to int into flag_buffer
+     * @param: buffer for flags
+     * @return Keplerian elements columns
+     *
+     */
+    COE_columns<const Storage> columns(std::vector<int> &flag_buffer) const {
+        std::span<const std::uint8_t> flags = flag();
+        flag_buffer.assign(flags.begin(), flags.end());
+        return {p(), a(), e(), i(), W(), w(), nu(), flag_buffer};
+    }
+
+    // Keplerian elements of orbit k
+    COE<Storage> operator[](std::size_t k) const {
+        const std::array<int, 1> flag_{flag()[k]};
+        const COE_columns<const Storage> elem{p().subspan(k, 1), a().subspan(k, 1), e().subspan(k, 1),
+                                              i().subspan(k, 1), W().subspan(k, 1), w().subspan(k, 1),
+                                              nu().subspan(k, 1), flag_};
+        return get_COE(elem, 0, Storage(mu()));
+    }
+};
+
+#endif //ORBITAL_MANEUVERS_ORBIT_CATALOG_H
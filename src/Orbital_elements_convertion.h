@@ -3,10 +3,28 @@
 
 #include <iostream>
 #include <math.h>
+#include <variant>
+#include <numbers>
+#include <utility>
+#include <limits>
 #include "Vector.h"
 #include "Dense.h"
 
 
+/**
+     * Type of orbit, values coincide with COE::flag
+     *
+     * Any - type is known at runtime only, COE<T> keeps all elements and flag
+     *
+     */
+enum class Orbit_kind {
+    Any = 0,
+    Circular_equatorial = 1,
+    Circular_inclined = 2,
+    Elliptic_equatorial = 3,
+    Elliptic_inclined = 4
+};
+
 /**
      * Structure of Keplerian elements
      *
@@ -17,15 +35,17 @@
      * i - inclination
      * W - right ascension (for inclined orbits)
      * w - argument of perigee (for elliptic inclined orbits)
-     * nu - true anomaly (for now optional)
+     * nu - true anomaly (for elliptic orbits)
      * u - argument of latitude (for circular inclined orbits)
      * lam_true - true longitude (for circular equatorial orbits)
      * w_true - true longitude of periapsis (for elliptic equatorial orbits)
      * mu - gravitational parameter
      * flag - determines type of orbit:1 - circular equatorial, 2 - circular inclined, 3 - elliptic equatorial, 4 - elliptic inclined
      *
+     * COE<T, Kind> with Kind other than Any keeps only the elements, defined for this type of orbit
+     *
      */
-template<typename T>
+template<typename T, Orbit_kind Kind = Orbit_kind::Any>
 struct COE {
     T p;
     T a;
@@ -41,120 +61,458 @@ struct COE {
     int flag = 0;
 };
 
+// Keplerian elements in other precision
+template<typename U, typename T>
+constexpr COE<U> COE_cast(const COE<T> &elem) {
+    return {U(elem.p), U(elem.a), U(elem.e), U(elem.i), U(elem.W), U(elem.w), U(elem.nu), U(elem.u),
+            U(elem.lam_true), U(elem.w_true), U(elem.mu), elem.flag};
+}
+
 /**
-     * Function that converts RV vectors to Keplerian elements
+     * Structure of modified equinoctial elements
      *
-     * If a Keplerian element is not defined for this type of orbit, it is assigned to 10
-     * @param: RV vectors
-     * @return Structure of Keplerian elements
+     * Elements have no singularities for circular and equatorial orbits, so they need no flag
+     * @param:
+     * p - semilatus rectum
+     * f, g - e * cos(w + I * W), e * sin(w + I * W)
+     * h, k - tan(i / 2)^I * cos(W), tan(i / 2)^I * sin(W)
+     * L - true longitude, w + I * W + nu
+     * mu - gravitational parameter
+     * I - retrograde factor: 1, or -1 for retrograde orbits, that keeps h and k finite for i = pi
      *
      */
 template<typename T>
-COE<T> RV2COE(const std::vector<T> &r, const std::vector<T> &v, T mu) {
-    std::vector<T> h = cross_product(r, v); // angular momentum vector(vector perpendicular to orbit plane)
-    std::vector<T> n = cross_product(std::vector<T>{0, 0, 1}, h); // ascending node
-    std::vector<T> e = (r * (scalar(v, v) - mu / norm(r)) - v * scalar(r, v)) / mu; // eccentricity vector, which points to perigee
+struct Equinoctial {
+    T p;
+    T f;
+    T g;
+    T h;
+    T k;
+    T L;
+    T mu;
+    int I = 1;
+};
+
+template<typename T>
+struct COE<T, Orbit_kind::Circular_equatorial> {
+    static constexpr Orbit_kind kind = Orbit_kind::Circular_equatorial;
+    T p;
+    T a;
+    T e;
+    T i;
+    T lam_true;
+    T mu;
+};
+
+template<typename T>
+struct COE<T, Orbit_kind::Circular_inclined> {
+    static constexpr Orbit_kind kind = Orbit_kind::Circular_inclined;
+    T p;
+    T a;
+    T e;
+    T i;
+    T W;
+    T u;
+    T mu;
+};
+
+template<typename T>
+struct COE<T, Orbit_kind::Elliptic_equatorial> {
+    static constexpr Orbit_kind kind = Orbit_kind::Elliptic_equatorial;
+    T p;
+    T a;
+    T e;
+    T i;
+    T w_true;
+    T nu;
+    T mu;
+};
+
+template<typename T>
+struct COE<T, Orbit_kind::Elliptic_inclined> {
+    static constexpr Orbit_kind kind = Orbit_kind::Elliptic_inclined;
+    T p;
+    T a;
+    T e;
+    T i;
+    T W;
+    T w;
+    T nu;
+    T mu;
+};
+
+/**
+     * Keplerian elements of any type of orbit, the type is the index of the alternative plus 1
+     *
+     */
+template<typename T>
+using COE_variant = std::variant<COE<T, Orbit_kind::Circular_equatorial>, COE<T, Orbit_kind::Circular_inclined>,
+        COE<T, Orbit_kind::Elliptic_equatorial>, COE<T, Orbit_kind::Elliptic_inclined>>;
+
+/**
+     * Conversion of Keplerian elements of known type to the structure with all elements
+     *
+     * @param: Keplerian elements of known type
+     * @return Structure of Keplerian elements, undefined elements are assigned to 10
+     *
+     */
+template<typename T, Orbit_kind Kind>
+requires (Kind != Orbit_kind::Any)
+COE<T> to_runtime(const COE<T, Kind> &elem) {
+    COE<T> res{elem.p, elem.a, elem.e, elem.i, 10, 10, 10, 10, 10, 10, elem.mu, int(Kind)};
+    if constexpr (Kind == Orbit_kind::Circular_equatorial) res.lam_true = elem.lam_true;
+    if constexpr (Kind == Orbit_kind::Circular_inclined) res.W = elem.W, res.u = elem.u;
+    if constexpr (Kind == Orbit_kind::Elliptic_equatorial) res.w_true = elem.w_true, res.nu = elem.nu;
+    if constexpr (Kind == Orbit_kind::Elliptic_inclined) res.W = elem.W, res.w = elem.w, res.nu = elem.nu;
+    return res;
+}
+
+template<typename T>
+COE<T> to_runtime(const COE_variant<T> &elem) {
+    return std::visit([](const auto &typed) { return to_runtime(typed); }, elem);
+}
+
+/**
+     * Conversion of the structure with all elements to Keplerian elements of its type
+     *
+     * Flag other than 1, 2, 3 is treated as elliptic inclined orbit
+     * @param: Structure of Keplerian elements
+     * @return Keplerian elements of known type
+     *
+     */
+template<typename T>
+constexpr COE_variant<T> to_typed(const COE<T> &elem) {
+    switch (elem.flag) {
+        case 1:
+            return COE<T, Orbit_kind::Circular_equatorial>{elem.p, elem.a, elem.e, elem.i, elem.lam_true, elem.mu};
+        case 2:
+            return COE<T, Orbit_kind::Circular_inclined>{elem.p, elem.a, elem.e, elem.i, elem.W, elem.u, elem.mu};
+        case 3:
+            return COE<T, Orbit_kind::Elliptic_equatorial>{elem.p, elem.a, elem.e, elem.i, elem.w_true, elem.nu,
+                                                           elem.mu};
+        default:
+            return COE<T, Orbit_kind::Elliptic_inclined>{elem.p, elem.a, elem.e, elem.i, elem.W, elem.w, elem.nu,
+                                                         elem.mu};
+    }
+}
+
+/**
+     * Function that converts RV vectors to Keplerian elements of known type
+     *
+     * Only the angles of this type of orbit are computed, the type is not checked
+     * @param: RV vectors, gravitational parameter
+     * @return Keplerian elements of type Kind
+     *
+     */
+template<Orbit_kind Kind, typename T>
+requires (Kind != Orbit_kind::Any)
+COE<T, Kind> RV2COE(const Vec3<T> &r, const Vec3<T> &v, T mu) {
+    const T pi = std::numbers::pi_v<T>;
+    Vec3<T> h = cross_product(r, v); // angular momentum vector(vector perpendicular to orbit plane)
+    Vec3<T> n = cross_product(Vec3<T>{0, 0, 1}, h); // ascending node
+    Vec3<T> e = (r * (scalar(v, v) - mu / norm(r)) - v * scalar(r, v)) / mu; // eccentricity vector, which points to perigee
     T ksi = scalar(v, v) / 2 - mu / norm(r);
     T a = -mu / (2 * ksi);
     T p = scalar(h, h) / mu;
     T i = acos(h[2] / norm(h));
-    T w_true, W, w, lam_true, u, nu;
-    int flag = 0;
 
-    if (norm(e) < 1e-1) { // circular case
-        nu = acos(
-                r[0] / norm(r)); // let's consider, that in circular case true anomaly is the angle between I axis and r
-        if (scalar(r, v) < 0) nu = 2 * M_PI - nu;
-        if (norm(n) == 0) // circular equatorial case
-        {
-            lam_true = r[0] / norm(r);
-            if (r[1] < 0) lam_true = 2 * M_PI - lam_true;
-
-            W = 10;
-            w = 10;
-            u = 10;
-            w_true = 10;
-            flag = 1;
-
-        } else // circular inclined case
-        {
-            u = acos(scalar(n, r) / (norm(n) * norm(r)));
-            if (r[2] < 0) u = 2 * M_PI - u;
-            W = acos(n[0] / norm(n));
-            if (n[1] < 0) W = 2 * M_PI - W;
-            w = 10;
-            w_true = 10;
-            lam_true = 10;
-            flag = 2;
-        }
-    } else // elliptic case
-    {
-        nu = acos(scalar(e, r) / (norm(e) * norm(r)));
-        if (scalar(r, v) < 0) nu = 2 * M_PI - nu;
-        if (norm(n) <= 1e-4) // elliptic equatorial case
-        {
-            w_true = acos(e[0] / norm(e));
-            if (e[1] < 0) w_true = 2 * M_PI - w_true;
-            W = 10;
-            w = 10;
-            lam_true = 10;
-            u = 10;
-            flag = 3;
-
-
-        } else // elliptic inclined case
-        {
-            W = acos(n[0] / norm(n));
-            if (n[1] < 0) W = 2 * M_PI - W;
-            w = acos(scalar(n, e) / (norm(n) * norm(e)));
-            if (e[2] < 0) w = 2 * M_PI - w;
-            u = 10;
-            w_true = 10;
-            lam_true = 10;
-            flag = 4;
-        }
+    if constexpr (Kind == Orbit_kind::Circular_equatorial) {
+        T lam_true = acos(r[0] / norm(r));
+        if (r[1] < 0) lam_true = 2 * pi - lam_true;
+        return {p, a, norm(e), i, lam_true, mu};
+    }
+    if constexpr (Kind == Orbit_kind::Circular_inclined) {
+        T u = acos(scalar(n, r) / (norm(n) * norm(r)));
+        if (r[2] < 0) u = 2 * pi - u;
+        T W = acos(n[0] / norm(n));
+        if (n[1] < 0) W = 2 * pi - W;
+        return {p, a, norm(e), i, W, u, mu};
+    }
+    T nu = acos(scalar(e, r) / (norm(e) * norm(r)));
+    if (scalar(r, v) < 0) nu = 2 * pi - nu;
+    if constexpr (Kind == Orbit_kind::Elliptic_equatorial) {
+        T w_true = acos(e[0] / norm(e));
+        if (e[1] < 0) w_true = 2 * pi - w_true;
+        return {p, a, norm(e), i, w_true, nu, mu};
+    }
+    if constexpr (Kind == Orbit_kind::Elliptic_inclined) {
+        T W = acos(n[0] / norm(n));
+        if (n[1] < 0) W = 2 * pi - W;
+        T w = acos(scalar(n, e) / (norm(n) * norm(e)));
+        if (e[2] < 0) w = 2 * pi - w;
+        return {p, a, norm(e), i, W, w, nu, mu};
     }
-    return COE<T>{p, a, norm(e), i, W, w, nu, u, lam_true, w_true, mu, flag};
 }
 
 /**
-     * Function that converts Keplerian elements to RV vectors
+     * Type of orbit by its RV vectors
      *
+     * Orbits with e < 0.1 are considered circular, orbits with |n| <= 1e-4 (|n| = 0 for circular) equatorial
+     * @param: RV vectors, gravitational parameter
+     * @return type of orbit
      *
-     * @param: Keplerian elements
-     * @return RV vectors
+     */
+template<typename T>
+Orbit_kind Classify_orbit(const Vec3<T> &r, const Vec3<T> &v, T mu) {
+    Vec3<T> h = cross_product(r, v);
+    Vec3<T> n = cross_product(Vec3<T>{0, 0, 1}, h);
+    Vec3<T> e = (r * (scalar(v, v) - mu / norm(r)) - v * scalar(r, v)) / mu;
+    if (norm(e) < 1e-1) return norm(n) == 0 ? Orbit_kind::Circular_equatorial : Orbit_kind::Circular_inclined;
+    return norm(n) <= 1e-4 ? Orbit_kind::Elliptic_equatorial : Orbit_kind::Elliptic_inclined;
+}
+
+/**
+     * Function that converts RV vectors to Keplerian elements of the type, found at runtime
+     *
+     * @param: RV vectors, gravitational parameter
+     * @return Keplerian elements of any type
+     *
+     */
+template<typename T>
+COE_variant<T> RV2COE_typed(const Vec3<T> &r, const Vec3<T> &v, T mu) {
+    switch (Classify_orbit(r, v, mu)) {
+        case Orbit_kind::Circular_equatorial:
+            return RV2COE<Orbit_kind::Circular_equatorial>(r, v, mu);
+        case Orbit_kind::Circular_inclined:
+            return RV2COE<Orbit_kind::Circular_inclined>(r, v, mu);
+        case Orbit_kind::Elliptic_equatorial:
+            return RV2COE<Orbit_kind::Elliptic_equatorial>(r, v, mu);
+        default:
+            return RV2COE<Orbit_kind::Elliptic_inclined>(r, v, mu);
+    }
+}
+
+/**
+     * Function that converts RV vectors to Keplerian elements
+     *
+     * Dispatches to RV2COE of the type of orbit. If a Keplerian element is not defined for this type of orbit,
+     * it is assigned to 10
+     * @param: RV vectors
+     * @return Structure of Keplerian elements
+     *
+     */
+template<typename T>
+COE<T> RV2COE(const Vec3<T> &r, const Vec3<T> &v, T mu) {
+    return to_runtime(RV2COE_typed(r, v, mu));
+}
+
+template<typename T>
+COE<T> RV2COE(const std::vector<T> &r, const std::vector<T> &v, T mu) {
+    return RV2COE(Vec3<T>(r), Vec3<T>(v), mu);
+}
+
+namespace detail {
+    template<typename T>
+    inline T wrap_angle(T angle) { // angle in [0, 2pi)
+        const T two_pi = 2 * std::numbers::pi_v<T>;
+        const T res = angle - two_pi * floor(angle / two_pi);
+        return res < two_pi ? res : 0;
+    }
+}
+
+/**
+     * Function that converts RV vectors to modified equinoctial elements
+     *
+     * Straight-line code with one atan2 (for L) and no classification of the orbit. Axes of equinoctial frame
+     * are the x and y axes, rotated onto the orbit plane by the shortest arc from z axis (from -z axis for
+     * retrograde orbits), so f, g and L are projections on directions, that exist for every orbit
+     * @param: RV vectors, gravitational parameter
+     * @return Structure of modified equinoctial elements, I = 1 for hz >= 0
+     *
+     */
+template<typename T>
+Equinoctial<T> RV2EQ(const Vec3<T> &r, const Vec3<T> &v, T mu) {
+    const Vec3<T> h_ = cross_product(r, v); // angular momentum
+    const T h2 = scalar(h_, h_);
+    const Vec3<T> h = h_ / sqrt(h2);
+    const int I = signbit(h[2]) ? -1 : 1;
+    const T c = 1 + I * h[2]; // >= 1
+
+    // axes f and g of equinoctial frame
+    const Vec3<T> f_hat{1 - h[0] * h[0] / c, -h[0] * h[1] / c, -I * h[0]};
+    const Vec3<T> g_hat{-I * h[0] * h[1] / c, I * (1 - h[1] * h[1] / c), -h[1]};
+
+    const T r_norm = norm(r);
+    const Vec3<T> e = (r * (scalar(v, v) - mu / r_norm) - v * scalar(r, v)) / mu; // eccentricity vector
+    return {h2 / mu, scalar(e, f_hat), scalar(e, g_hat), -h[1] / c, h[0] / c,
+            detail::wrap_angle(atan2(scalar(r, g_hat), scalar(r, f_hat))), mu, I};
+}
+
+namespace detail {
+    /**
+     * Angles of modified equinoctial elements
+     *
+     * @param:
+     * e, i - eccentricity and inclination
+     * sin_i - sine of inclination
+     * W - right ascension, 0 for equatorial orbits
+     * lon_periapsis - w + I * W, angle of eccentricity vector from axis f
+     *
+     */
+    template<typename T>
+    struct Equinoctial_angles {
+        T e, i, sin_i, W, lon_periapsis;
+    };
+
+    template<typename T>
+    inline Equinoctial_angles<T> Angles_of(const Equinoctial<T> &eq) {
+        const T t2 = eq.h * eq.h + eq.k * eq.k, half_i = 2 * atan(sqrt(t2));
+        return {sqrt(eq.f * eq.f + eq.g * eq.g), eq.I > 0 ? half_i : std::numbers::pi_v<T> - half_i,
+                2 * sqrt(t2) / (1 + t2), wrap_angle(atan2(eq.k, eq.h + T(0))), // -0 + 0 is +0
+                wrap_angle(atan2(eq.g, eq.f))};
+    }
+}
+
+/**
+     * Function that converts modified equinoctial elements to Keplerian elements
+     *
+     * Angles are found by atan2 and keep full precision near 0 and pi. Orbits with e <= tol are circular,
+     * orbits with sin(i) <= tol equatorial, so only orbits, whose perigee or node is lost in rounding,
+     * drop these angles, and the elements of any other orbit convert to the same RV vectors by COE2RV.
+     * Retrograde equatorial orbits get w_true and lam_true, that COE2RV inverts
+     * @param: modified equinoctial elements, tolerance (square root of machine epsilon by default)
+     * @return Structure of Keplerian elements, undefined elements are assigned to 10
      *
      */
 template<typename T>
-std::pair<std::vector<T>, std::vector<T>> COE2RV(const COE<T> &elem) {
-    T w, W, nu, i = elem.i;
-    if (elem.flag == 1) {
-        w = 0;
-        W = 0;
-        nu = elem.lam_true;
+COE<T> EQ2COE(const Equinoctial<T> &eq, T tol = sqrt(std::numeric_limits<T>::epsilon())) {
+    const auto q = detail::Angles_of(eq);
+    const bool elliptic = q.e > tol, inclined = q.sin_i > tol;
+    COE<T> res{eq.p, eq.p / (1 - q.e * q.e), q.e, q.i, 10, 10, 10, 10, 10, 10, eq.mu,
+               1 + int(inclined) + 2 * int(elliptic)};
+    if (res.flag == 1) res.lam_true = eq.L;
+    if (res.flag == 2) {
+        res.W = q.W;
+        res.u = detail::wrap_angle(eq.L - eq.I * q.W);
     }
-    if (elem.flag == 2) {
-        w = 0;
-        W = elem.W;
-        nu = elem.u;
+    if (res.flag == 3) {
+        res.w_true = q.lon_periapsis;
+        res.nu = detail::wrap_angle(eq.L - q.lon_periapsis);
     }
-    if (elem.flag == 3) {
-        W = 0;
-        w = elem.w_true;
-        nu = elem.nu;
+    if (res.flag == 4) {
+        res.W = q.W;
+        res.w = detail::wrap_angle(q.lon_periapsis - eq.I * q.W);
+        res.nu = detail::wrap_angle(eq.L - q.lon_periapsis);
     }
-    if (elem.flag == 4) {
-        nu = elem.nu;
-        w = elem.w;
-        W = elem.W;
+    return res;
+}
+
+/**
+     * Function that converts RV vectors to Keplerian elements without classification thresholds in the angles
+     *
+     * RV vectors are converted to modified equinoctial elements by straight-line code, Keplerian elements are
+     * found from them by EQ2COE, so the type of orbit is decided at the end by tol
+     * @param: RV vectors, gravitational parameter, tolerance of EQ2COE
+     * @return Structure of Keplerian elements, undefined elements are assigned to 10
+     *
+     */
+template<typename T>
+COE<T> RV2COE_robust(const Vec3<T> &r, const Vec3<T> &v, T mu, T tol = sqrt(std::numeric_limits<T>::epsilon())) {
+    return EQ2COE(RV2EQ(r, v, mu), tol);
+}
+
+namespace detail {
+    template<typename T>
+    constexpr std::pair<Vec3<T>, Vec3<T>> Perifocal_to_RV(T p, T e, T i, T W, T w, T nu, T mu) {
+        using constexpr_math::sqrt, constexpr_math::sin, constexpr_math::cos;
+        T r_p = p * cos(nu) / (1 + e * cos(nu)); // R vector in perifocal coordinate system
+        T r_q = p * sin(nu) / (1 + e * cos(nu));
+        T v_p = -sqrt(mu / p) * sin(nu); // V vector in perifocal coordinate system
+        T v_q = sqrt(mu / p) * (e + cos(nu));
+
+        // first two columns of the matrix of coordinate transformations, third components of R and V in PQW are 0
+        Vec3<T> P{cos(W) * cos(w) - sin(W) * sin(w) * cos(i), sin(W) * cos(w) + cos(W) * sin(w) * cos(i),
+                  sin(w) * sin(i)};
+        Vec3<T> Q{-cos(W) * sin(w) - sin(W) * cos(w) * cos(i), -sin(W) * sin(w) + cos(W) * cos(w) * cos(i),
+                  cos(w) * sin(i)};
+
+        return std::pair(P * r_p + Q * r_q, P * v_p + Q * v_q);
     }
-    std::vector<T> r_pqw{elem.p * cos(nu) / (1 + elem.e * cos(nu)), elem.p * sin(nu) / (1 + elem.e * cos(nu)), 0}; // calculating R vector in perifocal coordinate system
-    std::vector<T> v_pqw{-std::sqrt(elem.mu / elem.p) * sin(nu), std::sqrt(elem.mu / elem.p) * (elem.e + cos(nu)), 0};// calculating V vector in perifocal coordinate system
-    Dense<T> A(3, 3, {cos(W) * cos(w) - sin(W) * sin(w) * cos(i), -cos(W) * sin(w) - sin(W) * cos(w) * cos(i), sin(W) * sin(i),
-                      sin(W) * cos(w) + cos(W) * sin(w) * cos(i), -sin(W) * sin(w) + cos(W) * cos(w) * cos(i), -cos(W) * sin(i),
-                      sin(w) * sin(i),                             cos(w) * sin(i),                             cos(i)}); // matrix of coordinate transformations
+}
+
+/**
+     * Function that converts Keplerian elements of known type to RV vectors
+     *
+     * Undefined angles are compile-time zeros, so the rotation has no branches and fewer trigonometric functions
+     * @param: Keplerian elements of type Kind
+     * @return RV vectors
+     *
+     */
+template<typename T, Orbit_kind Kind>
+requires (Kind != Orbit_kind::Any)
+constexpr std::pair<Vec3<T>, Vec3<T>> COE2RV(const COE<T, Kind> &elem) {
+    if constexpr (Kind == Orbit_kind::Circular_equatorial)
+        return detail::Perifocal_to_RV<T>(elem.p, elem.e, elem.i, 0, 0, elem.lam_true, elem.mu);
+    if constexpr (Kind == Orbit_kind::Circular_inclined)
+        return detail::Perifocal_to_RV<T>(elem.p, elem.e, elem.i, elem.W, 0, elem.u, elem.mu);
+    if constexpr (Kind == Orbit_kind::Elliptic_equatorial)
+        return detail::Perifocal_to_RV<T>(elem.p, elem.e, elem.i, 0, elem.w_true, elem.nu, elem.mu);
+    if constexpr (Kind == Orbit_kind::Elliptic_inclined)
+        return detail::Perifocal_to_RV<T>(elem.p, elem.e, elem.i, elem.W, elem.w, elem.nu, elem.mu);
+}
+
+template<typename T>
+constexpr std::pair<Vec3<T>, Vec3<T>> COE2RV(const COE_variant<T> &elem) {
+    return std::visit([](const auto &typed) { return COE2RV(typed); }, elem);
+}
+
+/**
+     * Function that converts Keplerian elements to RV vectors
+     *
+     * Dispatches to COE2RV of the type of orbit by flag
+     * @param: Keplerian elements
+     * @return RV vectors
+     *
+     */
+template<typename T>
+constexpr std::pair<Vec3<T>, Vec3<T>> COE2RV(const COE<T> &elem) {
+    return COE2RV(to_typed(elem));
+}
+
+/**
+     * Function that converts modified equinoctial elements to RV vectors
+     *
+     * Axes of equinoctial frame are rational functions of h and k, so the only trigonometric functions are
+     * sine and cosine of L
+     * @param: modified equinoctial elements
+     * @return RV vectors
+     *
+     */
+template<typename T>
+std::pair<Vec3<T>, Vec3<T>> EQ2RV(const Equinoctial<T> &eq) {
+    const T h = eq.h, k = eq.k, I = T(eq.I);
+    const T cos_L = cos(eq.L), sin_L = sin(eq.L);
+    const T s2 = 1 + h * h + k * k;
+    const Vec3<T> f_hat = Vec3<T>{1 - k * k + h * h, 2 * h * k, -2 * I * k} / s2;
+    const Vec3<T> g_hat = Vec3<T>{2 * I * h * k, I * (1 + k * k - h * h), 2 * h} / s2;
+
+    const T r = eq.p / (1 + eq.f * cos_L + eq.g * sin_L);
+    const T sqrt_mu_p = sqrt(eq.mu / eq.p);
+    return std::pair(f_hat * (r * cos_L) + g_hat * (r * sin_L),
+                     f_hat * (-sqrt_mu_p * (eq.g + sin_L)) + g_hat * (sqrt_mu_p * (eq.f + cos_L)));
+}
+
+/**
+     * Function that converts Keplerian elements to modified equinoctial elements
+     *
+     * Undefined angles of the type of orbit are zeros, as in COE2RV, orbits with i > pi / 2 are retrograde
+     * @param: Keplerian elements, retrograde factor (0 - chosen by inclination)
+     * @return Structure of modified equinoctial elements
+     *
+     */
+template<typename T>
+Equinoctial<T> COE2EQ(const COE<T> &elem, int retrograde = 0) {
+    const T pi = std::numbers::pi_v<T>;
+    const bool circular = elem.flag == 1 || elem.flag == 2, equatorial = elem.flag == 1 || elem.flag == 3;
+    const T W = equatorial ? 0 : elem.W;
+    const T w = elem.flag == 3 ? elem.w_true : (circular ? 0 : elem.w);
+    const T nu = elem.flag == 1 ? elem.lam_true : (elem.flag == 2 ? elem.u : elem.nu);
 
-    return std::pair(A * r_pqw, A * v_pqw);
+    const int I = retrograde ? retrograde : (elem.i > pi / 2 ? -1 : 1);
+    const T t = tan((I > 0 ? elem.i : pi - elem.i) / 2);
+    const T lon_periapsis = w + I * W;
+    return {elem.p, elem.e * cos(lon_periapsis), elem.e * sin(lon_periapsis), t * cos(W),
+            t * sin(W), detail::wrap_angle(lon_periapsis + nu), elem.mu, I};
 }
 
 #endif //ORBITAL_MANEUVERS_ORBITAL_ELEMENTS_CONVERTION_H
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef ORBITAL_MANEUVERS_ORBITAL_MANEUVERS_H
 #define ORBITAL_MANEUVERS_ORBITAL_MANEUVERS_H
 
+#include <algorithm>
 #include "Orbital_elements_convertion.h"
 
 /**
@@ -11,17 +12,42 @@
      *
      */
 template<typename T>
-T Hohmann_transfer(const COE<T> &initial, const COE<T> &final) {
+constexpr T Hohmann_transfer(const COE<T> &initial, const COE<T> &final) {
+    using constexpr_math::sqrt, constexpr_math::abs;
     T mu = initial.mu;
     T a_trans = (initial.a + final.a) / 2;
-    T v_in = std::sqrt(mu / initial.a);
-    T v_fin = std::sqrt(mu / final.a);
-    T v_trans1 = std::sqrt(2 * mu / initial.a - mu / a_trans);
-    T v_trans2 = std::sqrt(2 * mu / final.a - mu / a_trans);
+    T v_in = sqrt(mu / initial.a);
+    T v_fin = sqrt(mu / final.a);
+    T v_trans1 = sqrt(2 * mu / initial.a - mu / a_trans);
+    T v_trans2 = sqrt(2 * mu / final.a - mu / a_trans);
     T delta_v = abs(v_trans1 - v_in) + abs(v_fin - v_trans2);
     return delta_v;
 }
 
+/**
+     * Edelbaum low-thrust transfer between circular orbits
+     *
+     * Continuous thrust of constant acceleration, plane change is spread over the whole transfer,
+     * so delta-v = sqrt(v0^2 + v1^2 - 2 v0 v1 cos(pi / 2 * alpha)), alpha - angle between orbit planes.
+     * Time of flight is delta-v / acceleration
+     * @param: Keplerian elements of initial and final orbits (a, i, W are used)
+     * @return delta-v
+     *
+     */
+template<typename T>
+T Edelbaum_transfer(const COE<T> &initial, const COE<T> &final) {
+    const T pi = std::numbers::pi_v<T>;
+    T v_in = sqrt(initial.mu / initial.a);
+    T v_fin = sqrt(initial.mu / final.a);
+    // unit angular momentum vectors, the angle between them keeps its digits for nearly coplanar orbits
+    const Vec3<T> h1{sin(initial.i) * sin(initial.W), -sin(initial.i) * cos(initial.W), cos(initial.i)};
+    const Vec3<T> h2{sin(final.i) * sin(final.W), -sin(final.i) * cos(final.W), cos(final.i)};
+    T alpha = Angle_between(h1, h2);
+    // v0^2 + v1^2 - 2 v0 v1 cos(x) as (v0 - v1)^2 + 4 v0 v1 sin^2(x / 2) without cancellation
+    T s = sin(pi / 4 * alpha);
+    return sqrt((v_in - v_fin) * (v_in - v_fin) + 4 * v_in * v_fin * s * s);
+}
+
 /**
      * Bi-elliptical transfer for circular orbits
      *
@@ -30,16 +56,17 @@ T Hohmann_transfer(const COE<T> &initial, const COE<T> &final) {
      *
      */
 template<typename T>
-T Bi_elliptic_transfer_circular_orbits(const COE<T> &initial, const COE<T> &final, T r_b) {
+constexpr T Bi_elliptic_transfer_circular_orbits(const COE<T> &initial, const COE<T> &final, T r_b) {
+    using constexpr_math::sqrt, constexpr_math::abs;
     T mu = initial.mu;
     T a_trans1 = (initial.a + r_b) / 2;
     T a_trans2 = (final.a + r_b) / 2;
-    T v_in = std::sqrt(mu / initial.a);
-    T v_fin = std::sqrt(mu / final.a);
-    T v_trans1a = std::sqrt(2 * mu / initial.a - mu / a_trans1);
-    T v_trans1b = std::sqrt(2 * mu / r_b - mu / a_trans1);
-    T v_trans2b = std::sqrt(2 * mu / r_b - mu / a_trans2);
-    T v_trans2c = std::sqrt(2 * mu / final.a - mu / a_trans2);
+    T v_in = sqrt(mu / initial.a);
+    T v_fin = sqrt(mu / final.a);
+    T v_trans1a = sqrt(2 * mu / initial.a - mu / a_trans1);
+    T v_trans1b = sqrt(2 * mu / r_b - mu / a_trans1);
+    T v_trans2b = sqrt(2 * mu / r_b - mu / a_trans2);
+    T v_trans2c = sqrt(2 * mu / final.a - mu / a_trans2);
     T delta_v = abs(v_trans1a - v_in) + abs(v_trans2b - v_trans1b) + abs(v_fin - v_trans2c);
     return delta_v;
 
@@ -60,23 +87,23 @@ T Bi_elliptic_transfer_elliptic_orbits(const COE<T> &initial, const COE<T> &fina
     T mu = initial.mu;
 
     T p1h = 2 * norm(r1) * r_a / (norm(r1) + r_a);
-    T v1h = std::sqrt(mu * p1h) / norm(r1);
+    T v1h = sqrt(mu * p1h) / norm(r1);
 
     T p2h = 2 * norm(r2) * r_a / (norm(r2) + r_a);
-    T v2h = std::sqrt(mu * p2h) / norm(r2);
+    T v2h = sqrt(mu * p2h) / norm(r2);
 
     T v0r = scalar(v1, r1) / norm(r1);
-    T v0t = std::sqrt(scalar(v1, v1) - v0r * v0r);
+    T v0t = sqrt(scalar(v1, v1) - v0r * v0r);
 
     T v3r = scalar(v2, r2) / norm(r2);
-    T v3t = std::sqrt(scalar(v2, v2) - v3r * v3r);
+    T v3t = sqrt(scalar(v2, v2) - v3r * v3r);
 
 
-    T v1ha = std::sqrt(mu * p1h) / r_a;
-    T v2ha = std::sqrt(mu * p2h) / r_a;
+    T v1ha = sqrt(mu * p1h) / r_a;
+    T v2ha = sqrt(mu * p2h) / r_a;
 
-    T delta_v = v1h + v2h - std::sqrt(v0r * v0r + (v0t + v1ha) * (v0t + v1ha)) -
-                std::sqrt(v3r * v3r + (v3t - v2ha) * (v3t - v2ha));
+    T delta_v = v1h + v2h - sqrt(v0r * v0r + (v0t + v1ha) * (v0t + v1ha)) -
+                sqrt(v3r * v3r + (v3t - v2ha) * (v3t - v2ha));
     return delta_v;
 
 }
@@ -93,18 +120,19 @@ T Two_impulse_transfer_elliptic_orbits(const COE<T> &initial, const COE<T> &fina
     auto [r1, v1] = COE2RV(initial);
     auto [r2, v2] = COE2RV(final);
     T mu = initial.mu;
+    T r1_norm = norm(r1), r2_norm = norm(r2);
 
-    T p_h = 2 * norm(r1) * norm(r2) / (norm(r1) + norm(r2));
-    T v1ht = std::sqrt(mu * p_h) / norm(r1);
-    T v2ht = std::sqrt(mu * p_h) / norm(r2);
+    T p_h = 2 * r1_norm * r2_norm / (r1_norm + r2_norm);
+    T v1ht = sqrt(mu * p_h) / r1_norm;
+    T v2ht = sqrt(mu * p_h) / r2_norm;
 
-    T v0r = scalar(v1, r1) / norm(r1);
-    T v0t = std::sqrt(scalar(v1, v1) - v0r * v0r);
+    T v0r = scalar(v1, r1) / r1_norm;
+    T v0t = sqrt(scalar(v1, v1) - v0r * v0r);
 
-    T v3r = scalar(v2, r2) / norm(r2);
-    T v3t = std::sqrt(scalar(v2, v2) - v3r * v3r);
+    T v3r = scalar(v2, r2) / r2_norm;
+    T v3t = sqrt(scalar(v2, v2) - v3r * v3r);
 
-    T delta_v = std::sqrt(v3r * v3r + (v3t + v1ht) * (v3t + v1ht)) - std::sqrt(v0r * v0r + (v0t + v2ht) * (v0t + v2ht));
+    T delta_v = sqrt(v3r * v3r + (v3t + v1ht) * (v3t + v1ht)) - sqrt(v0r * v0r + (v0t + v2ht) * (v0t + v2ht));
     return delta_v;
 }
 
@@ -117,14 +145,15 @@ T Two_impulse_transfer_elliptic_orbits(const COE<T> &initial, const COE<T> &fina
      */
 template<typename T>
 T Inclination_only_transfer(const COE<T> &initial, const COE<T> &final) {
-    T r1 = initial.p / (1 + initial.e * cos(2 * M_PI - initial.w));
-    T r2 = initial.p / (1 + initial.e * cos(M_PI - initial.w));
+    const T pi = std::numbers::pi_v<T>;
+    T r1 = initial.p / (1 + initial.e * cos(2 * pi - initial.w));
+    T r2 = initial.p / (1 + initial.e * cos(pi - initial.w));
 
-    T v1 = std::sqrt(2 * initial.mu / r1 - initial.mu / initial.a);
-    T v2 = std::sqrt(2 * initial.mu / r2 - initial.mu / initial.a);
+    T v1 = sqrt(2 * initial.mu / r1 - initial.mu / initial.a);
+    T v2 = sqrt(2 * initial.mu / r2 - initial.mu / initial.a);
 
-    T fi1 = atan(initial.e * sin(2 * M_PI - initial.w) / (1 + initial.e * cos(2 * M_PI - initial.w)));
-    T fi2 = atan(initial.e * sin(M_PI - initial.w) / (1 + initial.e * cos(M_PI - initial.w)));
+    T fi1 = atan(initial.e * sin(2 * pi - initial.w) / (1 + initial.e * cos(2 * pi - initial.w)));
+    T fi2 = atan(initial.e * sin(pi - initial.w) / (1 + initial.e * cos(pi - initial.w)));
 
     T delta_v1 = 2 * v1 * cos(fi1) * sin(abs(initial.i - final.i) / 2);
     T delta_v2 = 2 * v2 * cos(fi2) * sin(abs(initial.i - final.i) / 2);
@@ -139,55 +168,56 @@ T Inclination_only_transfer(const COE<T> &initial, const COE<T> &final) {
      *
      */
 template<typename T>
-std::tuple<T, std::vector<T>, std::vector<T>> General_plane_change(COE<T> &initial, const COE<T> &final) {
+std::tuple<T, Vec3<T>, Vec3<T>> General_plane_change(COE<T> &initial, const COE<T> &final) {
     auto [r_i, v_i] = COE2RV(initial);
     auto [r_f, v_f] = COE2RV(final);
+    const T pi = std::numbers::pi_v<T>;
     T mu = initial.mu;
     T delta_v1, delta_v2;
 
     // finding normal vectors
-    std::vector<T> h1 = cross_product(r_i, v_i); // coordinates are A, B, C of plane equation
+    Vec3<T> h1 = cross_product(r_i, v_i); // coordinates are A, B, C of plane equation
     h1 = h1 / norm(h1);
 
-    std::vector<T> h2 = cross_product(r_f, v_f);
+    Vec3<T> h2 = cross_product(r_f, v_f);
     h2 = h2 / norm(h2);
 
-    std::vector<T> a = cross_product(h1, h2); // vector of plane intersection
+    Vec3<T> a = cross_product(h1, h2); // vector of plane intersection
     a = a / norm(a);
 
-    std::vector<T> e = (r_i * (scalar(v_i, v_i) - mu / norm(r_i)) - v_i * scalar(r_i, v_i)) / mu;
+    Vec3<T> e = (r_i * (scalar(v_i, v_i) - mu / norm(r_i)) - v_i * scalar(r_i, v_i)) / mu;
 
 
     T nu = acos(scalar(e, a) / (norm(e) * norm(a)));
-    if (scalar(a, v_i) < 0) nu = 2 * M_PI - nu;
+    if (scalar(a, v_i) < 0) nu = 2 * pi - nu;
 
 
     initial.nu = nu;
-    std::vector<T> v2_1, v2_2; //two vectors for 2 nodes
+    Vec3<T> v2_1, v2_2; //two vectors for 2 nodes
 
     // 1 node of intersecting planes
     auto [r11, v11] = COE2RV(initial);
-    T alpha = acos(scalar(h1, h2));
-    delta_v1 = std::sqrt(2 * scalar(v11, v11) * (1 - cos(alpha)));
+    T alpha = Angle_between(h1, h2);
+    delta_v1 = 2 * norm(v11) * sin(alpha / 2); // sqrt(2 v^2 (1 - cos(alpha))) without cancellation
 
     if (scalar(h1, h2) >= 1e-5) {
         v2_1 = v11 * cos(alpha) + h1 * norm(v11) * sin(alpha);
     } else {
-        v2_1 = v11 * (cos(alpha)) + h1 * norm(v11) * sin(M_PI - alpha);
+        v2_1 = v11 * (cos(alpha)) + h1 * norm(v11) * sin(pi - alpha);
     }
 
     // 2 node of intersecting planes
-    if (nu < M_PI) initial.nu = nu + M_PI;
-    else initial.nu = nu - M_PI;
+    if (nu < pi) initial.nu = nu + pi;
+    else initial.nu = nu - pi;
 
 
     auto [r12, v12] = COE2RV(initial);
-    delta_v2 = std::sqrt(2 * scalar(v12, v12) * (1 - cos(alpha)));
+    delta_v2 = 2 * norm(v12) * sin(alpha / 2);
 
     if (scalar(h1, h2) >= 1e-30) {
         v2_2 = v12 * cos(alpha) - h1 * norm(v12) * sin(alpha);
     } else {
-        v2_2 = v12 * (cos(alpha)) - h1 * norm(v12) * sin(M_PI - alpha);
+        v2_2 = v12 * (cos(alpha)) - h1 * norm(v12) * sin(pi - alpha);
     }
 
     if (delta_v1 < delta_v2) return {delta_v1, r11, v2_1};
@@ -206,10 +236,10 @@ template<typename T>
 T General_transfer(COE<T> &initial, COE<T> &final)
 {
     auto[delta_v1, r, v] = General_plane_change(initial, final);
-    COE<T> transfer = RV2COE(r, v);
+    COE<T> transfer = RV2COE(r, v, initial.mu);
     transfer.nu = 0;
-    final.nu = M_PI;
+    final.nu = std::numbers::pi_v<T>;
     T delta_v2 = Two_impulse_transfer_elliptic_orbits(transfer, final);
-    return delta_v1 + delta_v1;
+    return delta_v1 + delta_v2;
 }
 #endif //ORBITAL_MANEUVERS_ORBITAL_MANEUVERS_H
\ No newline at end of file
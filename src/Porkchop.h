@@ -0,0 +1,96 @@
+#ifndef ORBITAL_MANEUVERS_PORKCHOP_H
+#define ORBITAL_MANEUVERS_PORKCHOP_H
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include "Vector.h"
+#include "Lambert.h"
+#include "Thread_pool.h"
+
+
+/**
+     * Cell of the porkchop plot
+     *
+     * @param:
+     * delta_v1 - departure delta-v, |v1 - v of departure body|
+     * delta_v2 - arrival delta-v, |v of arrival body - v2|
+     * NaN, if Lambert's problem of the cell has no solution
+     *
+     */
+template<typename T>
+struct Porkchop_cell {
+    T delta_v1;
+    T delta_v2;
+};
+
+/**
+     * Porkchop plot evaluation parameters
+     *
+     * @param:
+     * M - number of revolutions
+     * prograde, low_path - branch of Lambert's problem solution
+     * n_threads - number of threads of the pool, created by the overload without pool, 0 is for all cores
+     *
+     */
+struct Porkchop_options {
+    int M = 0;
+    bool prograde = true;
+    bool low_path = true;
+    unsigned n_threads = 0;
+};
+
+/**
+     * Porkchop plot: delta-v of transfers over the grid of departure times and times of flight
+     *
+     * Ephemerides are functions of time, that return the pair of R and V vectors of a body and are called
+     * concurrently. A row of fixed departure time is evaluated by one worker: departure state is computed once
+     * per row, cells are written contiguously and every cell starts Householder iterations from the solution
+     * of the previous time of flight, which is close to it on a fine grid. Cold start is used, if warm one fails
+     * @param: departure and arrival ephemerides, departure times, times of flight, gravitational parameter,
+     * thread pool, options
+     * @return row-major grid departure.size() x tof.size()
+     *
+     */
+template<typename T, typename Departure, typename Arrival>
+std::vector<Porkchop_cell<T>> Porkchop(Departure &&departure_ephemeris, Arrival &&arrival_ephemeris,
+                                       const std::vector<T> &departure, const std::vector<T> &tof, T mu,
+                                       Thread_pool &pool, const Porkchop_options &options = {}) {
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    const std::size_t n_tof = tof.size();
+    std::vector<Porkchop_cell<T>> grid(departure.size() * n_tof);
+
+    pool.parallel_for(departure.size(), [&](std::size_t row, unsigned) {
+        const T t_dep = departure[row];
+        const auto [r1, v_dep] = departure_ephemeris(t_dep);
+        Porkchop_cell<T> *cells = grid.data() + row * n_tof;
+        T x_guess = nan;
+        for (std::size_t j = 0; j < n_tof; j++) {
+            const auto [r2, v_arr] = arrival_ephemeris(t_dep + tof[j]);
+            auto solution = Lambert(r1, r2, tof[j], mu, options.M, options.prograde, options.low_path, x_guess);
+            if (!solution.converged && std::isfinite(x_guess))
+                solution = Lambert(r1, r2, tof[j], mu, options.M, options.prograde, options.low_path);
+            if (solution.converged) {
+                cells[j] = {norm(solution.v1 - v_dep), norm(v_arr - solution.v2)};
+                x_guess = solution.x;
+            } else {
+                cells[j] = {nan, nan};
+                x_guess = nan;
+            }
+        }
+    });
+    return grid;
+}
+
+template<typename T, typename Departure, typename Arrival>
+std::vector<Porkchop_cell<T>> Porkchop(Departure &&departure_ephemeris, Arrival &&arrival_ephemeris,
+                                       const std::vector<T> &departure, const std::vector<T> &tof, T mu,
+                                       const Porkchop_options &options = {}) {
+    Thread_pool pool(options.n_threads ? options.n_threads : std::thread::hardware_concurrency());
+    return Porkchop(std::forward<Departure>(departure_ephemeris), std::forward<Arrival>(arrival_ephemeris),
+                    departure, tof, mu, pool, options);
+}
+
+#endif //ORBITAL_MANEUVERS_PORKCHOP_H
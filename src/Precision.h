@@ -0,0 +1,63 @@
+#ifndef ORBITAL_MANEUVERS_PRECISION_H
+#define ORBITAL_MANEUVERS_PRECISION_H
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include "Orbital_elements_convertion.h"
+
+
+/**
+     * Error of delta-v in low precision against double precision over a population of transfers
+     *
+     * @param:
+     * max_abs_error - max |delta_v_low - delta_v|
+     * max_rel_error - max |delta_v_low - delta_v| / max(|delta_v|, scale)
+     * rms_rel_error - root mean square of the relative errors
+     * worst - index of the transfer with max_rel_error
+     * count - number of transfers
+     *
+     */
+struct Precision_report {
+    double max_abs_error = 0;
+    double max_rel_error = 0;
+    double rms_rel_error = 0;
+    std::size_t worst = 0;
+    std::size_t count = 0;
+};
+
+/**
+     * Comparison of a delta-v function in precision Low (float, mixed mode) with double precision
+     *
+     * Elements are rounded to Low, so the error includes rounding of the inputs, as for elements stored in Low.
+     * Both calls get copies of the elements, so functions, that change their arguments, are accepted
+     * @param: initial and final orbits of the transfers, delta_v(COE<T> &, COE<T> &) callable for T = double and
+     *         T = Low, scale of delta-v below which the error is taken as absolute
+     * @return Precision_report
+     *
+     */
+template<typename Low, typename Function>
+Precision_report Compare_precision(const std::vector<COE<double>> &initial, const std::vector<COE<double>> &final,
+                                   Function &&delta_v, double scale = 1e-3) {
+    Precision_report report;
+    double sum2 = 0;
+    for (std::size_t k = 0; k < initial.size(); k++) {
+        COE<double> initial_ = initial[k], final_ = final[k];
+        COE<Low> initial_low = COE_cast<Low>(initial[k]), final_low = COE_cast<Low>(final[k]);
+        const double reference = double(delta_v(initial_, final_));
+        const double error = std::abs(double(delta_v(initial_low, final_low)) - reference);
+        const double rel_error = error / std::max(std::abs(reference), scale);
+        report.max_abs_error = std::max(report.max_abs_error, error);
+        if (!std::isnan(report.max_rel_error) && !(rel_error <= report.max_rel_error)) { // NaN is the worst
+            report.max_rel_error = rel_error;
+            report.worst = k;
+        }
+        sum2 += rel_error * rel_error;
+    }
+    report.count = initial.size();
+    report.rms_rel_error = report.count ? std::sqrt(sum2 / double(report.count)) : 0;
+    return report;
+}
+
+#endif //ORBITAL_MANEUVERS_PRECISION_H
@@ -0,0 +1,275 @@
+#ifndef ORBITAL_MANEUVERS_PREPARED_ORBIT_H
+#define ORBITAL_MANEUVERS_PREPARED_ORBIT_H
+
+#include <tuple>
+#include <algorithm>
+#include <numbers>
+#include "Orbital_maneuvers.h"
+
+
+/**
+     * Orbit with precomputed quantities, that do not depend on the other orbit of a transfer
+     *
+     * Built once per orbit, when the same orbit participates in many transfers
+     * @param:
+     * elem - Keplerian elements
+     * r, v - RV vectors at true anomaly of elem
+     * r_norm - |r|
+     * v_r, v_t - radial and tangential velocity
+     * h_hat - unit angular momentum vector (normal to the orbit plane)
+     * e_vec - eccentricity vector
+     * sqrt_mu_a - sqrt(mu / a), velocity on circular orbit of radius a
+     * node_speed - min(v * cos(fi)) over the two points, used by Inclination_only_transfer
+     *
+     */
+template<typename T>
+struct Prepared_orbit {
+    COE<T> elem;
+    Vec3<T> r, v;
+    T r_norm, v_r, v_t;
+    Vec3<T> h_hat, e_vec;
+    T sqrt_mu_a;
+    T node_speed;
+
+    explicit Prepared_orbit(const COE<T> &elem_) : elem(elem_) {
+        const T mu = elem.mu, pi = std::numbers::pi_v<T>;
+        std::tie(r, v) = COE2RV(elem);
+        r_norm = norm(r);
+        v_r = scalar(v, r) / r_norm;
+        v_t = sqrt(scalar(v, v) - v_r * v_r);
+        h_hat = cross_product(r, v);
+        h_hat = h_hat / norm(h_hat);
+        e_vec = (r * (scalar(v, v) - mu / r_norm) - v * scalar(r, v)) / mu;
+        sqrt_mu_a = sqrt(mu / elem.a);
+
+        T r1 = elem.p / (1 + elem.e * cos(2 * pi - elem.w));
+        T r2 = elem.p / (1 + elem.e * cos(pi - elem.w));
+        T v1 = sqrt(2 * mu / r1 - mu / elem.a);
+        T v2 = sqrt(2 * mu / r2 - mu / elem.a);
+        T fi1 = atan(elem.e * sin(2 * pi - elem.w) / (1 + elem.e * cos(2 * pi - elem.w)));
+        T fi2 = atan(elem.e * sin(pi - elem.w) / (1 + elem.e * cos(pi - elem.w)));
+        node_speed = std::min(v1 * cos(fi1), v2 * cos(fi2));
+    }
+};
+
+namespace detail {
+    /**
+     * Bi-elliptic transfer for elliptical orbits on scalars of prepared orbits
+     *
+     * @param: gravitational parameter, |r|, radial and tangential velocity of initial and final orbits,
+     * apogee radius of transfer orbit
+     * @return delta-v
+     *
+     */
+    template<typename T>
+    inline T Bi_elliptic_delta_v(T mu, T r1, T v0r, T v0t, T r2, T v3r, T v3t, T r_a) {
+        T p1h = 2 * r1 * r_a / (r1 + r_a);
+        T p2h = 2 * r2 * r_a / (r2 + r_a);
+        T v1h = sqrt(mu * p1h) / r1;
+        T v2h = sqrt(mu * p2h) / r2;
+        T v1ha = sqrt(mu * p1h) / r_a;
+        T v2ha = sqrt(mu * p2h) / r_a;
+        return v1h + v2h - sqrt(v0r * v0r + (v0t + v1ha) * (v0t + v1ha)) -
+               sqrt(v3r * v3r + (v3t - v2ha) * (v3t - v2ha));
+    }
+
+    /**
+     * Two impulse transfer for elliptical orbits as the sum of magnitudes of the burns
+     *
+     * Transfer orbit has apsides at |r1| and |r2|, the burns cancel radial velocity and change tangential one
+     * @param: gravitational parameter, |r|, radial and tangential velocity of initial and final orbits
+     * @return delta-v, not negative
+     *
+     */
+    template<typename T>
+    inline T Two_impulse_burns(T mu, T r1, T v0r, T v0t, T r2, T v3r, T v3t) {
+        T p_h = 2 * r1 * r2 / (r1 + r2);
+        T v1ht = sqrt(mu * p_h) / r1;
+        T v2ht = sqrt(mu * p_h) / r2;
+        return sqrt(v0r * v0r + (v1ht - v0t) * (v1ht - v0t)) + sqrt(v3r * v3r + (v3t - v2ht) * (v3t - v2ht));
+    }
+
+    /**
+     * Bi-elliptic transfer for elliptical orbits as the sum of magnitudes of the burns
+     *
+     * Transfer orbits have apsides at |r1|, r_a and at r_a, |r2|. The first and the last burns cancel radial velocity
+     * and change tangential one, the middle burn changes speed at r_a
+     * @param: gravitational parameter, |r|, radial and tangential velocity of initial and final orbits,
+     * apogee radius of transfer orbit
+     * @return delta-v, not negative
+     *
+     */
+    template<typename T>
+    inline T Bi_elliptic_burns(T mu, T r1, T v0r, T v0t, T r2, T v3r, T v3t, T r_a) {
+        T p1h = 2 * r1 * r_a / (r1 + r_a);
+        T p2h = 2 * r2 * r_a / (r2 + r_a);
+        T v1h = sqrt(mu * p1h) / r1;
+        T v2h = sqrt(mu * p2h) / r2;
+        T v1ha = sqrt(mu * p1h) / r_a;
+        T v2ha = sqrt(mu * p2h) / r_a;
+        return sqrt(v0r * v0r + (v1h - v0t) * (v1h - v0t)) + abs(v2ha - v1ha) +
+               sqrt(v3r * v3r + (v3t - v2h) * (v3t - v2h));
+    }
+}
+
+/**
+     * Hohmann transfer
+     *
+     * @param: prepared initial and final orbits
+     * @return delta-v
+     *
+     */
+template<typename T>
+T Hohmann_transfer(const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final) {
+    T mu = initial.elem.mu;
+    T a_trans = (initial.elem.a + final.elem.a) / 2;
+    T v_trans1 = sqrt(2 * mu / initial.elem.a - mu / a_trans);
+    T v_trans2 = sqrt(2 * mu / final.elem.a - mu / a_trans);
+    return abs(v_trans1 - initial.sqrt_mu_a) + abs(final.sqrt_mu_a - v_trans2);
+}
+
+/**
+     * Edelbaum low-thrust transfer between circular orbits
+     *
+     * @param: prepared initial and final orbits
+     * @return delta-v
+     *
+     */
+template<typename T>
+T Edelbaum_transfer(const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final) {
+    const T pi = std::numbers::pi_v<T>;
+    T alpha = Angle_between(initial.h_hat, final.h_hat);
+    T v_in = initial.sqrt_mu_a, v_fin = final.sqrt_mu_a, s = sin(pi / 4 * alpha);
+    return sqrt((v_in - v_fin) * (v_in - v_fin) + 4 * v_in * v_fin * s * s);
+}
+
+/**
+     * Bi-elliptical transfer for circular orbits
+     *
+     * @param: prepared initial and final orbits, apogee radius of transfer orbit
+     * @return delta-v
+     *
+     */
+template<typename T>
+T Bi_elliptic_transfer_circular_orbits(const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final, T r_b) {
+    T mu = initial.elem.mu;
+    T a_trans1 = (initial.elem.a + r_b) / 2;
+    T a_trans2 = (final.elem.a + r_b) / 2;
+    T v_trans1a = sqrt(2 * mu / initial.elem.a - mu / a_trans1);
+    T v_trans1b = sqrt(2 * mu / r_b - mu / a_trans1);
+    T v_trans2b = sqrt(2 * mu / r_b - mu / a_trans2);
+    T v_trans2c = sqrt(2 * mu / final.elem.a - mu / a_trans2);
+    return abs(v_trans1a - initial.sqrt_mu_a) + abs(v_trans2b - v_trans1b) + abs(final.sqrt_mu_a - v_trans2c);
+}
+
+/**
+     * Bi-elliptic transfer for elliptical orbits
+     *
+     * @param: prepared initial and final orbits, apogee radius of transfer orbit
+     * @return delta-v
+     *
+     */
+template<typename T>
+T Bi_elliptic_transfer_elliptic_orbits(const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final, T r_a) {
+    return detail::Bi_elliptic_delta_v(initial.elem.mu, initial.r_norm, initial.v_r, initial.v_t,
+                                       final.r_norm, final.v_r, final.v_t, r_a);
+}
+
+/**
+     * Two impulse transfer for elliptical orbits
+     *
+     * @param: prepared initial and final orbits
+     * @return delta-v
+     *
+     */
+template<typename T>
+T Two_impulse_transfer_elliptic_orbits(const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final) {
+    T mu = initial.elem.mu;
+    T p_h = 2 * initial.r_norm * final.r_norm / (initial.r_norm + final.r_norm);
+    T v1ht = sqrt(mu * p_h) / initial.r_norm;
+    T v2ht = sqrt(mu * p_h) / final.r_norm;
+
+    return sqrt(final.v_r * final.v_r + (final.v_t + v1ht) * (final.v_t + v1ht)) -
+           sqrt(initial.v_r * initial.v_r + (initial.v_t + v2ht) * (initial.v_t + v2ht));
+}
+
+/**
+     * Two impulse transfer for elliptical orbits as the sum of magnitudes of the burns
+     *
+     * Two_impulse_transfer_elliptic_orbits keeps the signed formula of the analytical solution (reference 3 of README),
+     * which is negative for about half of the pairs, so costs, that are compared or minimized, use this one
+     * @param: prepared initial and final orbits
+     * @return delta-v, not negative
+     *
+     */
+template<typename T>
+T Two_impulse_burns(const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final) {
+    return detail::Two_impulse_burns(initial.elem.mu, initial.r_norm, initial.v_r, initial.v_t,
+                                     final.r_norm, final.v_r, final.v_t);
+}
+
+/**
+     * Bi-elliptic transfer for elliptical orbits as the sum of magnitudes of the burns
+     *
+     * @param: prepared initial and final orbits, apogee radius of transfer orbit
+     * @return delta-v, not negative
+     *
+     */
+template<typename T>
+T Bi_elliptic_burns(const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final, T r_a) {
+    return detail::Bi_elliptic_burns(initial.elem.mu, initial.r_norm, initial.v_r, initial.v_t,
+                                     final.r_norm, final.v_r, final.v_t, r_a);
+}
+
+/**
+     * Inclination only plane change transfer for elliptical orbits
+     *
+     * @param: prepared initial and final orbits
+     * @return delta-v
+     *
+     */
+template<typename T>
+T Inclination_only_transfer(const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final) {
+    return 2 * initial.node_speed * sin(abs(initial.elem.i - final.elem.i) / 2);
+}
+
+/**
+     * General plane change transfer for elliptical orbits
+     *
+     * Initial orbit is not changed, true anomaly of the burn is set in a copy of its elements
+     * @param: prepared initial and final orbits
+     * @return delta-v, RV vectors
+     *
+     */
+template<typename T>
+std::tuple<T, Vec3<T>, Vec3<T>> General_plane_change(const Prepared_orbit<T> &initial, const Prepared_orbit<T> &final) {
+    const Vec3<T> &h1 = initial.h_hat, &h2 = final.h_hat;
+    const T pi = std::numbers::pi_v<T>;
+    COE<T> node = initial.elem;
+
+    Vec3<T> a = cross_product(h1, h2); // vector of plane intersection
+    a = a / norm(a);
+
+    T nu = acos(scalar(initial.e_vec, a) / norm(initial.e_vec));
+    if (scalar(a, initial.v) < 0) nu = 2 * pi - nu;
+
+    T alpha = Angle_between(h1, h2);
+    T cos_alpha = cos(alpha), sin_alpha = sin(alpha), sin_half = sin(alpha / 2);
+
+    // 1 node of intersecting planes
+    node.nu = nu;
+    auto [r11, v11] = COE2RV(node);
+    T delta_v1 = 2 * norm(v11) * sin_half; // sqrt(2 v^2 (1 - cos(alpha))) without cancellation
+    Vec3<T> v2_1 = v11 * cos_alpha + h1 * norm(v11) * (scalar(h1, h2) >= 1e-5 ? sin_alpha : sin(pi - alpha));
+
+    // 2 node of intersecting planes
+    node.nu = nu < pi ? nu + pi : nu - pi;
+    auto [r12, v12] = COE2RV(node);
+    T delta_v2 = 2 * norm(v12) * sin_half;
+    Vec3<T> v2_2 = v12 * cos_alpha - h1 * norm(v12) * (scalar(h1, h2) >= 1e-30 ? sin_alpha : sin(pi - alpha));
+
+    if (delta_v1 < delta_v2) return {delta_v1, r11, v2_1};
+    else return {delta_v2, r12, v2_2};
+}
+
+#endif //ORBITAL_MANEUVERS_PREPARED_ORBIT_H
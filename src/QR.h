@@ -0,0 +1,233 @@
+#ifndef ORBITAL_MANEUVERS_QR_H
+#define ORBITAL_MANEUVERS_QR_H
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "Dense.h"
+
+
+namespace detail {
+    /**
+     * Householder reflection of the column c of a below the diagonal
+     *
+     * Same reflection as Dense::eval_norm_vec(c), v = x + sign(x_c) |x| e_c, stored as in LAPACK: v is scaled
+     * to v_c = 1, a(c, c) gets -sign(x_c) |x|, a(c + 1 :, c) gets v(c + 1 :)
+     * @param: matrix, column
+     * @return tau, reflection is I - tau v v^T, 0 when the column is already zero below the diagonal
+     *
+     */
+    template<typename T>
+    T Householder_reflector(Matrix_view<T> a, int c) {
+        T alpha = a(c, c), x_norm = 0;
+        for (int r = c + 1; r < a.rows; r++) x_norm += a(r, c) * a(r, c);
+        if (x_norm == 0) return 0;
+        T beta = std::sqrt(alpha * alpha + x_norm);
+        if (alpha >= 0) beta = -beta;
+        T scale = 1 / (alpha - beta);
+        for (int r = c + 1; r < a.rows; r++) a(r, c) *= scale;
+        a(c, c) = beta;
+        return (beta - alpha) / beta;
+    }
+
+    // b(c :, j) -= tau v v^T b(c :, j) for j in [begin, end), v is the column c of v_ below the diagonal,
+    // rows are traversed in order, so b is read along its rows
+    template<typename T>
+    void Apply_reflector(Matrix_view<const T> v_, int c, T tau, Matrix_view<T> b, int begin, int end) {
+        if (tau == 0) return;
+        constexpr int chunk = 32;
+        T s[chunk];
+        for (int j0 = begin; j0 < end; j0 += chunk) {
+            const int cols = std::min(chunk, end - j0);
+            for (int j = 0; j < cols; j++) s[j] = b(c, j0 + j);
+            for (int r = c + 1; r < v_.rows; r++) {
+                const T v = v_(r, c);
+                for (int j = 0; j < cols; j++) s[j] += v * b(r, j0 + j);
+            }
+            for (int j = 0; j < cols; j++) {
+                s[j] *= tau;
+                b(c, j0 + j) -= s[j];
+            }
+            for (int r = c + 1; r < v_.rows; r++) {
+                const T v = v_(r, c);
+                for (int j = 0; j < cols; j++) b(r, j0 + j) -= s[j] * v;
+            }
+        }
+    }
+
+    /**
+     * Triangular factor of the WY representation H_0 H_1 ... H_{k-1} = I - Y T Y^T
+     *
+     * LAPACK dlarft, forward, column-wise
+     * @param: factorized panel (Householder vectors below the diagonal), tau, output k x k upper triangular T
+     *
+     */
+    template<typename T>
+    void Triangular_factor(Matrix_view<const T> panel, const T *tau, Matrix_view<T> t) {
+        const int k = t.rows;
+        for (int i = 0; i < k; i++) {
+            for (int c = 0; c < i; c++) t(c, i) = panel(i, c); // t(0 : i, i) = -tau_i Y(:, 0 : i)^T v_i
+            for (int r = i + 1; r < panel.rows; r++) {
+                const T v = panel(r, i);
+                for (int c = 0; c < i; c++) t(c, i) += panel(r, c) * v;
+            }
+            for (int c = 0; c < i; c++) t(c, i) *= -tau[i];
+            for (int c = 0; c < i; c++) { // t(0 : i, i) = T(0 : i, 0 : i) t(0 : i, i)
+                T s = 0;
+                for (int p = c; p < i; p++) s += t(c, p) * t(p, i);
+                t(c, i) = s;
+            }
+            for (int r = i + 1; r < k; r++) t(r, i) = 0;
+            t(i, i) = tau[i];
+        }
+    }
+
+    /**
+     * c = (I - Y T Y^T)^T c, with both products done by multiply_add
+     *
+     * @param: factorized panel, its triangular factor, matrix with the same rows as the panel,
+     *         workspaces of at least panel.rows x k and k x c.cols
+     *
+     */
+    template<typename T>
+    void Apply_block_reflector(Matrix_view<const T> panel, Matrix_view<const T> t, Matrix_view<T> c,
+                               Dense<T> &y_, Dense<T> &w_) {
+        const int k = t.rows;
+        Matrix_view<T> y = y_.block(0, 0, panel.rows, k), w = w_.block(0, 0, k, c.cols);
+        for (int r = 0; r < panel.rows; r++) { // Y with explicit unit diagonal and zeros above it
+            for (int j = 0; j < k; j++) y(r, j) = r > j ? panel(r, j) : (r == j ? T(1) : T(0));
+        }
+        multiply_into(y.transposed(), c, w);
+        for (int r = k - 1; r >= 0; r--) { // w = T^T w in place, T^T is lower triangular
+            for (int j = 0; j < c.cols; j++) {
+                T s = 0;
+                for (int p = 0; p <= r; p++) s += t(p, r) * w(p, j);
+                w(r, j) = s;
+            }
+        }
+        multiply_add(y, w, c, T(-1), T(1));
+    }
+
+    // solution of r x = b for upper triangular r, in place of b
+    template<typename T>
+    void Back_substitution(Matrix_view<const T> r, Matrix_view<T> x) {
+        for (int i = r.cols - 1; i >= 0; i--) {
+            for (int p = i + 1; p < r.cols; p++) {
+                const T r_ = r(i, p);
+                for (int j = 0; j < x.cols; j++) x(i, j) -= r_ * x(p, j);
+            }
+            const T inv_ = 1 / r(i, i);
+            for (int j = 0; j < x.cols; j++) x(i, j) *= inv_;
+        }
+    }
+}
+
+/**
+     * QR decomposition of m x n matrix
+     *
+     * @param:
+     * qr - R on and above the diagonal, Householder vectors below it
+     * tau - scales of the reflections, Q = H_0 H_1 ... H_{min(m, n) - 1}, H_k = I - tau_k v_k v_k^T
+     * t - triangular factors of WY representation of the panels, factor of the panel, that starts at column j,
+     *     is t.block(0, j, k, k)
+     * block - width of the panels
+     *
+     */
+template<typename T>
+struct QR_decomposition {
+    Dense<T> qr;
+    std::vector<T> tau;
+    Dense<T> t;
+    int block;
+};
+
+/**
+     * Blocked Householder QR decomposition
+     *
+     * Panels of block columns are factorized column by column, the rest of the matrix is updated by the whole panel
+     * at once in WY representation, so most of the work is done by multiply_add
+     * @param: matrix, width of the panels
+     * @return decomposition
+     *
+     */
+template<typename T>
+QR_decomposition<T> QR_factorization(Dense<T> a, int block = 32) {
+    const int m = a.get_height(), n = a.get_width(), k_max = std::min(m, n);
+    QR_decomposition<T> res{std::move(a), std::vector<T>(k_max), Dense<T>{block, k_max}, block};
+    Matrix_view<T> qr = res.qr.view();
+    Dense<T> y_{m, block}, w_{block, n};
+    for (int j = 0; j < k_max; j += block) {
+        const int k = std::min(block, k_max - j);
+        Matrix_view<T> panel = qr.block(j, j, m - j, k);
+        for (int c = 0; c < k; c++) {
+            res.tau[j + c] = detail::Householder_reflector(panel, c);
+            detail::Apply_reflector<T>(panel, c, res.tau[j + c], panel, c + 1, k);
+        }
+        detail::Triangular_factor<T>(panel, res.tau.data() + j, res.t.block(0, j, k, k));
+        if (j + k < n) detail::Apply_block_reflector<T>(panel, res.t.block(0, j, k, k),
+                                                         qr.block(j, j + k, m - j, n - j - k), y_, w_);
+    }
+    return res;
+}
+
+/**
+     * Least squares solution of a x = b, |a x - b| -> min, by QR decomposition of a
+     *
+     * a must have full column rank, otherwise the solution contains inf or NaN
+     * @param: decomposition of m x n matrix a, m >= n, m x k right-hand sides
+     * @return n x k solutions
+     *
+     */
+template<typename T>
+Dense<T> Least_squares(const QR_decomposition<T> &qr_, const Dense<T> &b) {
+    const int m = qr_.qr.get_height(), n = qr_.qr.get_width(), k_max = std::min(m, n), block = qr_.block;
+    Dense<T> qtb = b; // Q^T b
+    Dense<T> y_{m, block}, w_{block, b.get_width()};
+    for (int j = 0; j < k_max; j += block) {
+        const int k = std::min(block, k_max - j);
+        detail::Apply_block_reflector<T>(qr_.qr.block(j, j, m - j, k), qr_.t.block(0, j, k, k),
+                                         qtb.block(j, 0, m - j, b.get_width()), y_, w_);
+    }
+    Dense<T> x{n, b.get_width()};
+    for (int i = 0; i < n; i++) for (int j = 0; j < b.get_width(); j++) x(i, j) = qtb(i, j);
+    detail::Back_substitution<T>(qr_.qr.block(0, 0, n, n), x.view());
+    return x;
+}
+
+/**
+     * Solution of a x = b for square nonsingular a, or least squares solution for m x n a, m > n
+     *
+     * @param: matrix, right-hand sides
+     * @return solutions
+     *
+     */
+template<typename T>
+Dense<T> Linear_solve(Dense<T> a, const Dense<T> &b) {
+    return Least_squares(QR_factorization(std::move(a)), b);
+}
+
+/**
+     * Inverse of fixed-size matrix (6x6 covariance, STM) by unblocked Householder QR on the stack
+     *
+     * Singular matrix gives inf or NaN
+     * @param: matrix
+     * @return inverse
+     *
+     */
+template<typename T, int N>
+Dense<T, N, N> Inverse(Dense<T, N, N> a) {
+    std::array<T, N> tau;
+    Matrix_view<T> qr = a.view();
+    for (int c = 0; c < N; c++) {
+        tau[c] = detail::Householder_reflector(qr, c);
+        detail::Apply_reflector<T>(qr, c, tau[c], qr, c + 1, N);
+    }
+    Dense<T, N, N> x = Dense<T, N, N>::identity();
+    for (int c = 0; c < N; c++) detail::Apply_reflector<T>(qr, c, tau[c], x.view(), 0, N);
+    detail::Back_substitution<T>(qr, x.view());
+    return x;
+}
+
+
+#endif //ORBITAL_MANEUVERS_QR_H
@@ -0,0 +1,403 @@
+#ifndef ORBITAL_MANEUVERS_SEQUENCING_H
+#define ORBITAL_MANEUVERS_SEQUENCING_H
+
+#include <span>
+#include <tuple>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include "Orbital_maneuvers.h"
+#include "Thread_pool.h"
+
+
+/**
+     * Sequencing parameters
+     *
+     * @param:
+     * leg_time - time of one leg in s, leg k departs at k * leg_time, 0 - costs do not depend on time
+     * epoch_bins - number of departure epochs, at which costs are evaluated and memoized, legs are rounded to them
+     * exact_limit - largest number of orbits, solved by branch-and-bound
+     * max_nodes - limit of branch-and-bound nodes, the best sequence found is returned, when it is reached
+     * beam_width - number of partial sequences, kept by beam search
+     * rounds, walks, iterations - large neighborhood search: every round runs walks independent walks of iterations
+     *                             steps from the best sequence, the best of them starts the next round
+     * destroy - number of orbits, removed and reinserted by one step
+     * seed - seed of random numbers of the walks, results do not depend on the number of threads
+     * n_threads - number of threads of the pool, created by the overload without pool, 0 is for all cores
+     *
+     */
+template<typename T>
+struct Sequencing_options {
+    T leg_time = 0;
+    std::size_t epoch_bins = 16;
+    std::size_t exact_limit = 12;
+    std::size_t max_nodes = 10000000;
+    std::size_t beam_width = 64;
+    std::size_t rounds = 16;
+    std::size_t walks = 8;
+    std::size_t iterations = 64;
+    std::size_t destroy = 6;
+    unsigned seed = 1;
+    unsigned n_threads = 0;
+};
+
+/**
+     * Work of the cost oracle
+     *
+     * @param:
+     * lookups - number of requested costs
+     * evaluations - number of calls of the cost function, the rest of lookups are served from memory
+     * seconds - wall time of the solver
+     *
+     */
+struct Sequencing_statistics {
+    std::size_t lookups = 0;
+    std::size_t evaluations = 0;
+    double seconds = 0;
+
+    double hit_rate() const { return lookups ? 1 - double(evaluations) / double(lookups) : 0; }
+
+    double evaluations_per_second() const { return seconds > 0 ? double(evaluations) / seconds : 0; }
+
+    double lookups_per_second() const { return seconds > 0 ? double(lookups) / seconds : 0; }
+};
+
+/**
+     * Order of visits
+     *
+     * @param:
+     * order - indices of orbits, order[0] = 0 is the initial orbit of the servicer
+     * delta_v - total delta-v of the legs
+     * optimal - true, if branch-and-bound finished within max_nodes
+     * statistics - work of the cost oracle
+     *
+     */
+template<typename T>
+struct Sequence {
+    std::vector<std::size_t> order;
+    T delta_v;
+    bool optimal;
+    Sequencing_statistics statistics;
+};
+
+/**
+     * Leg cost of sequencing: coplanar and plane change transfers between orbits with nodes drifting by J2
+     *
+     * Right ascensions are moved to the departure epoch by the secular rate -1.5 n J2 (R / p)^2 cos(i), cost is
+     * Hohmann transfer plus general plane change. Called concurrently, so it must not change its state
+     * @param:
+     * J2 - second zonal harmonic
+     * R - equatorial radius
+     *
+     */
+template<typename T>
+struct Drifting_transfer_cost {
+    T J2 = T(1.08262668e-3);
+    T R = T(6378.137);
+
+    T node_rate(const COE<T> &elem) const {
+        const T n = std::sqrt(elem.mu / (elem.a * elem.a * elem.a));
+        return T(-1.5) * n * J2 * (R / elem.p) * (R / elem.p) * std::cos(elem.i);
+    }
+
+    T operator()(const COE<T> &from, const COE<T> &to, T epoch) const {
+        COE<T> initial = from, final = to;
+        initial.W += node_rate(from) * epoch;
+        final.W += node_rate(to) * epoch;
+        T delta_v = Hohmann_transfer(initial, final);
+        const T cos_alpha = std::cos(initial.i) * std::cos(final.i) +
+                            std::sin(initial.i) * std::sin(final.i) * std::cos(final.W - initial.W);
+        if (cos_alpha < 1 - std::numeric_limits<T>::epsilon() * 16)
+            delta_v += std::get<0>(General_plane_change(initial, final));
+        return delta_v;
+    }
+};
+
+/**
+     * Lazily evaluated and memoized costs of legs between orbits
+     *
+     * Table of n x n costs per departure epoch is filled on first request. Slots are atomic, so the oracle is shared
+     * by threads without locks: two threads, that miss the same slot at once, both evaluate it
+     * @param: orbits, cost(from, to, epoch) function, time of one leg, number of departure epochs
+     *
+     */
+template<typename T, typename Orbit, typename Cost>
+class Cost_oracle {
+private:
+    const std::vector<Orbit> &orbits_;
+    Cost cost_;
+    std::size_t n_;
+    std::size_t bins_;
+    T leg_time_;
+    std::unique_ptr<std::atomic<T>[]> table_;
+    std::atomic<std::size_t> lookups_{0};
+    std::atomic<std::size_t> evaluations_{0};
+
+public:
+    Cost_oracle(const std::vector<Orbit> &orbits, Cost cost, T leg_time, std::size_t epoch_bins)
+            : orbits_(orbits), cost_(std::move(cost)), n_(orbits.size()),
+              bins_(leg_time > 0 && n_ > 1 ? std::clamp<std::size_t>(epoch_bins, 1, n_ - 1) : 1),
+              leg_time_(leg_time), table_(new std::atomic<T>[bins_ * n_ * n_]) {
+        for (std::size_t k = 0; k < bins_ * n_ * n_; k++)
+            table_[k].store(std::numeric_limits<T>::quiet_NaN(), std::memory_order_relaxed);
+    }
+
+    std::size_t size() const { return n_; }
+
+    std::size_t bins() const { return bins_; }
+
+    // departure epoch bin of leg
+    std::size_t bin(std::size_t leg) const { return bins_ == 1 ? 0 : leg * bins_ / (n_ - 1); }
+
+    // epoch in the middle of the bin
+    T epoch(std::size_t bin) const {
+        return bins_ == 1 ? T(0) : leg_time_ * ((T(bin) + T(0.5)) * T(n_ - 1) / T(bins_) - T(0.5));
+    }
+
+    T operator()(std::size_t from, std::size_t to, std::size_t leg) { return cost_of_bin(from, to, bin(leg)); }
+
+    T cost_of_bin(std::size_t from, std::size_t to, std::size_t bin) {
+        lookups_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic<T> &slot = table_[(bin * n_ + from) * n_ + to];
+        T cost = slot.load(std::memory_order_relaxed);
+        if (cost == cost) return cost;
+        evaluations_.fetch_add(1, std::memory_order_relaxed);
+        cost = cost_(orbits_[from], orbits_[to], epoch(bin));
+        slot.store(cost, std::memory_order_relaxed);
+        return cost;
+    }
+
+    // total delta-v of the sequence
+    T cost(std::span<const std::size_t> order) {
+        T sum = 0;
+        for (std::size_t k = 0; k + 1 < order.size(); k++) sum += (*this)(order[k], order[k + 1], k);
+        return sum;
+    }
+
+    Sequencing_statistics statistics() const {
+        return {lookups_.load(), evaluations_.load(), 0};
+    }
+};
+
+namespace detail {
+    /**
+     * Beam search of the sequence
+     *
+     * Every level extends the kept partial sequences by every unvisited orbit and keeps beam_width cheapest,
+     * ties are broken by parent and orbit index, so the result is deterministic. Width 1 is the greedy nearest neighbor
+     * @param: cost oracle, beam width
+     * @return sequence
+     *
+     */
+    template<typename T, typename Oracle>
+    std::vector<std::size_t> Beam_search(Oracle &oracle, std::size_t width) {
+        const std::size_t n = oracle.size();
+        width = std::max<std::size_t>(width, 1);
+        std::vector<std::size_t> paths(n, 0), next_paths;
+        std::vector<T> costs{0}, next_costs;
+        std::vector<std::tuple<T, std::size_t, std::size_t>> candidates; // cost, parent, orbit
+        std::vector<char> visited(n);
+        for (std::size_t level = 1; level < n; level++) {
+            candidates.clear();
+            for (std::size_t parent = 0; parent < costs.size(); parent++) {
+                const std::size_t *path = paths.data() + parent * n;
+                std::fill(visited.begin(), visited.end(), 0);
+                for (std::size_t k = 0; k < level; k++) visited[path[k]] = 1;
+                for (std::size_t j = 0; j < n; j++)
+                    if (!visited[j]) candidates.emplace_back(costs[parent] + oracle(path[level - 1], j, level - 1),
+                                                             parent, j);
+            }
+            const std::size_t kept = std::min(width, candidates.size());
+            std::partial_sort(candidates.begin(), candidates.begin() + kept, candidates.end());
+            next_paths.resize(kept * n);
+            next_costs.resize(kept);
+            for (std::size_t c = 0; c < kept; c++) {
+                const auto [cost, parent, j] = candidates[c];
+                std::copy_n(paths.begin() + parent * n, level, next_paths.begin() + c * n);
+                next_paths[c * n + level] = j;
+                next_costs[c] = cost;
+            }
+            std::swap(paths, next_paths);
+            std::swap(costs, next_costs);
+        }
+        return {paths.begin(), paths.begin() + n};
+    }
+
+    /**
+     * Branch-and-bound search of the optimal sequence
+     *
+     * Depth-first search, cheapest leg first. Lower bound of a partial sequence is its cost plus the cheapest leg into
+     * every unvisited orbit over all orbits and epochs
+     * @param: cost oracle, upper bound and its sequence (improved in place), limit of nodes
+     * @return true, if the search finished within the limit
+     *
+     */
+    template<typename T, typename Oracle>
+    bool Branch_and_bound(Oracle &oracle, std::vector<std::size_t> &best, T &best_cost, std::size_t max_nodes) {
+        const std::size_t n = oracle.size();
+        std::vector<T> min_in(n, std::numeric_limits<T>::infinity());
+        for (std::size_t b = 0; b < oracle.bins(); b++)
+            for (std::size_t i = 0; i < n; i++)
+                for (std::size_t j = 1; j < n; j++)
+                    if (i != j) min_in[j] = std::min(min_in[j], oracle.cost_of_bin(i, j, b));
+
+        std::vector<std::size_t> path{0};
+        std::vector<char> visited(n, 0);
+        visited[0] = 1;
+        std::size_t nodes = 0;
+        std::vector<std::vector<std::pair<T, std::size_t>>> children(n); // per depth, reused
+        std::function<void(T, T)> search = [&](T cost, T remaining_bound) {
+            if (++nodes > max_nodes) return;
+            const std::size_t level = path.size();
+            if (level == n) {
+                if (cost < best_cost) best_cost = cost, best = path;
+                return;
+            }
+            if (cost + remaining_bound >= best_cost) return;
+            auto &options = children[level];
+            options.clear();
+            for (std::size_t j = 1; j < n; j++)
+                if (!visited[j]) options.emplace_back(oracle(path.back(), j, level - 1), j);
+            std::sort(options.begin(), options.end());
+            for (std::size_t c = 0; c < options.size(); c++) {
+                const auto [leg, j] = children[level][c];
+                visited[j] = 1;
+                path.push_back(j);
+                search(cost + leg, remaining_bound - min_in[j]);
+                path.pop_back();
+                visited[j] = 0;
+                if (nodes > max_nodes) return;
+            }
+        };
+        T bound = 0;
+        for (std::size_t j = 1; j < n; j++) bound += min_in[j];
+        search(0, bound);
+        return nodes <= max_nodes;
+    }
+
+    /**
+     * Step of large neighborhood search: removes orbits and reinserts them greedily at the cheapest positions
+     *
+     * Removed orbits are a random segment or random positions, the initial orbit is never removed. Cost of insertion
+     * takes into account, that the following legs depart one leg later
+     * @param: cost oracle, sequence (changed in place), number of removed orbits, random numbers generator,
+     * buffers
+     *
+     */
+    template<typename T, typename Oracle>
+    void Destroy_repair(Oracle &oracle, std::vector<std::size_t> &path, std::size_t destroy, std::mt19937 &gen,
+                        std::vector<std::size_t> &removed, std::vector<T> &prefix, std::vector<T> &suffix) {
+        const std::size_t n = path.size();
+        destroy = std::min(destroy, n - 1);
+        removed.clear();
+        if (gen() % 2) { // segment
+            const std::size_t begin = 1 + gen() % (n - destroy);
+            removed.assign(path.begin() + begin, path.begin() + begin + destroy);
+            path.erase(path.begin() + begin, path.begin() + begin + destroy);
+        } else {
+            for (std::size_t r = 0; r < destroy; r++) {
+                const std::size_t position = 1 + gen() % (path.size() - 1);
+                removed.push_back(path[position]);
+                path.erase(path.begin() + position);
+            }
+        }
+        std::shuffle(removed.begin(), removed.end(), gen);
+
+        for (std::size_t x: removed) {
+            const std::size_t m = path.size();
+            prefix.assign(m, 0); // prefix[q] - cost of legs up to path[q]
+            for (std::size_t k = 0; k + 1 < m; k++) prefix[k + 1] = prefix[k] + oracle(path[k], path[k + 1], k);
+            suffix.assign(m + 1, 0); // suffix[q] - cost of legs from path[q], departing one leg later
+            for (std::size_t k = m - 1; k-- > 0;) suffix[k] = suffix[k + 1] + oracle(path[k], path[k + 1], k + 1);
+
+            T best = std::numeric_limits<T>::infinity();
+            std::size_t best_q = m - 1;
+            for (std::size_t q = 0; q < m; q++) { // x goes after path[q]
+                T cost = prefix[q] + oracle(path[q], x, q);
+                if (q + 1 < m) cost += oracle(x, path[q + 1], q + 1) + suffix[q + 1];
+                if (cost < best) best = cost, best_q = q;
+            }
+            path.insert(path.begin() + best_q + 1, x);
+        }
+    }
+}
+
+/**
+     * Order of visits of orbits with minimal total delta-v
+     *
+     * Open path from orbits[0] through all other orbits. Costs come from the memoized oracle, so every leg at every
+     * departure epoch is evaluated once. Up to exact_limit orbits the order is found by branch-and-bound, started
+     * from beam search. Larger sets start from beam search and are improved by parallel large neighborhood search:
+     * walks of a round are spread over the threads of the pool and share the oracle
+     * @param: orbits (COE, Prepared_orbit or any other type, accepted by cost), cost(from, to, epoch) function,
+     * thread pool, options
+     * @return Sequence
+     *
+     */
+template<typename Orbit, typename Cost, typename T = std::invoke_result_t<Cost &, const Orbit &, const Orbit &, double>>
+Sequence<T> Sequence_targets(const std::vector<Orbit> &orbits, Cost &&cost, Thread_pool &pool,
+                             const Sequencing_options<T> &options = {}) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t n = orbits.size();
+    Sequence<T> res{{}, 0, true, {}};
+    if (n == 0) return res;
+    Cost_oracle<T, Orbit, std::decay_t<Cost>> oracle(orbits, std::forward<Cost>(cost), options.leg_time,
+                                                     options.epoch_bins);
+
+    res.order = detail::Beam_search<T>(oracle, options.beam_width);
+    res.delta_v = oracle.cost(res.order);
+    if (n <= options.exact_limit) {
+        res.optimal = detail::Branch_and_bound(oracle, res.order, res.delta_v, options.max_nodes);
+    } else {
+        res.optimal = false;
+        struct Walk {
+            std::vector<std::size_t> path, removed;
+            std::vector<T> prefix, suffix;
+            T cost;
+        };
+        std::vector<Walk> walks(std::max<std::size_t>(options.walks, 1));
+        for (std::size_t round = 0; round < options.rounds; round++) {
+            pool.parallel_for(walks.size(), [&](std::size_t w, unsigned) {
+                Walk &walk = walks[w];
+                std::mt19937 gen(options.seed + static_cast<unsigned>(round * walks.size() + w));
+                walk.path = res.order;
+                walk.cost = res.delta_v;
+                std::vector<std::size_t> candidate;
+                for (std::size_t it = 0; it < options.iterations; it++) {
+                    candidate = walk.path;
+                    detail::Destroy_repair(oracle, candidate, options.destroy, gen, walk.removed, walk.prefix,
+                                           walk.suffix);
+                    const T candidate_cost = oracle.cost(candidate);
+                    if (candidate_cost < walk.cost) walk.cost = candidate_cost, std::swap(walk.path, candidate);
+                }
+            });
+            for (const Walk &walk: walks)
+                if (walk.cost < res.delta_v) res.delta_v = walk.cost, res.order = walk.path;
+        }
+    }
+    res.statistics = oracle.statistics();
+    res.statistics.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
+
+template<typename Orbit, typename Cost, typename T = std::invoke_result_t<Cost &, const Orbit &, const Orbit &, double>>
+Sequence<T> Sequence_targets(const std::vector<Orbit> &orbits, Cost &&cost, const Sequencing_options<T> &options = {}) {
+    Thread_pool pool(options.n_threads ? options.n_threads : std::thread::hardware_concurrency());
+    return Sequence_targets(orbits, std::forward<Cost>(cost), pool, options);
+}
+
+template<typename T>
+Sequence<T> Sequence_targets(const std::vector<COE<T>> &orbits, const Sequencing_options<T> &options = {}) {
+    return Sequence_targets(orbits, Drifting_transfer_cost<T>{}, options);
+}
+
+#endif //ORBITAL_MANEUVERS_SEQUENCING_H
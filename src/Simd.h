@@ -0,0 +1,301 @@
+#ifndef ORBITAL_MANEUVERS_SIMD_H
+#define ORBITAL_MANEUVERS_SIMD_H
+
+#include <cstddef>
+#include <type_traits>
+#include <initializer_list>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ORBITAL_MANEUVERS_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define ORBITAL_MANEUVERS_X86_SIMD 0
+#endif
+
+
+/**
+     * Instruction set of the SIMD kernels: COE2RV_simd, batch Kepler_propagation and Numerical_propagation, GEMM of Dense
+     *
+     * scalar - portable code, reference path
+     * avx2 - 4 doubles or 8 floats per instruction, AVX2 + FMA
+     * avx512 - 8 doubles or 16 floats per instruction, AVX-512F
+     *
+     */
+enum class Simd_level {
+    scalar = 0,
+    avx2 = 1,
+    avx512 = 2
+};
+
+/**
+     * Instruction set, supported by the CPU the program is running on
+     *
+     * @return Simd_level
+     *
+     */
+inline Simd_level supported_simd_level() {
+#if ORBITAL_MANEUVERS_X86_SIMD
+    static const Simd_level level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return Simd_level::avx512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return Simd_level::avx2;
+        return Simd_level::scalar;
+    }();
+    return level;
+#else
+    return Simd_level::scalar;
+#endif
+}
+
+#if ORBITAL_MANEUVERS_X86_SIMD
+
+/// AVX2 + FMA pack of 4 doubles ///
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+namespace simd_avx2 {
+    struct Pack {
+        __m256d v;
+        static constexpr int width = 4;
+    };
+    struct Mask {
+        __m256d m;
+    };
+
+    inline Pack load(const double *ptr) { return {_mm256_loadu_pd(ptr)}; }
+
+    inline void store(double *ptr, Pack a) { _mm256_storeu_pd(ptr, a.v); }
+
+    inline Pack set1(double a) { return {_mm256_set1_pd(a)}; }
+
+    inline Pack operator+(Pack a, Pack b) { return {_mm256_add_pd(a.v, b.v)}; }
+
+    inline Pack operator-(Pack a, Pack b) { return {_mm256_sub_pd(a.v, b.v)}; }
+
+    inline Pack operator*(Pack a, Pack b) { return {_mm256_mul_pd(a.v, b.v)}; }
+
+    inline Pack operator/(Pack a, Pack b) { return {_mm256_div_pd(a.v, b.v)}; }
+
+    inline Pack operator-(Pack a) { return {_mm256_xor_pd(a.v, _mm256_set1_pd(-0.0))}; }
+
+    inline Pack fmadd(Pack a, Pack b, Pack c) { return {_mm256_fmadd_pd(a.v, b.v, c.v)}; } // a * b + c
+
+    inline Pack fnmadd(Pack a, Pack b, Pack c) { return {_mm256_fnmadd_pd(a.v, b.v, c.v)}; } // c - a * b
+
+    inline Pack sqrt(Pack a) { return {_mm256_sqrt_pd(a.v)}; }
+
+    inline Pack abs(Pack a) { return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)}; }
+
+    inline Pack round(Pack a) { return {_mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+
+    inline Pack floor(Pack a) { return {_mm256_floor_pd(a.v)}; }
+
+    inline Mask less(Pack a, Pack b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)}; }
+
+    inline Pack select(Mask mask, Pack a, Pack b) { return {_mm256_blendv_pd(b.v, a.v, mask.m)}; } // mask ? a : b
+
+    inline Pack cbrt_estimate(Pack a) { // a >= 0, bit pattern divided by 3 plus bias as in fdlibm cbrt, ~5% error
+        __m256i i = _mm256_srli_epi64(_mm256_castpd_si256(a.v), 2);
+        for (int shift: {2, 4, 8, 16, 32}) i = _mm256_add_epi64(i, _mm256_srli_epi64(i, shift));
+        return {_mm256_castsi256_pd(_mm256_add_epi64(i, _mm256_set1_epi64x(0x2A9F789300000000)))};
+    }
+
+#include "Simd_kernel.h"
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+/// AVX-512F pack of 8 doubles ///
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+namespace simd_avx512 {
+    struct Pack {
+        __m512d v;
+        static constexpr int width = 8;
+    };
+    struct Mask {
+        __mmask8 m;
+    };
+
+    inline Pack load(const double *ptr) { return {_mm512_loadu_pd(ptr)}; }
+
+    inline void store(double *ptr, Pack a) { _mm512_storeu_pd(ptr, a.v); }
+
+    inline Pack set1(double a) { return {_mm512_set1_pd(a)}; }
+
+    inline Pack operator+(Pack a, Pack b) { return {_mm512_add_pd(a.v, b.v)}; }
+
+    inline Pack operator-(Pack a, Pack b) { return {_mm512_sub_pd(a.v, b.v)}; }
+
+    inline Pack operator*(Pack a, Pack b) { return {_mm512_mul_pd(a.v, b.v)}; }
+
+    inline Pack operator/(Pack a, Pack b) { return {_mm512_div_pd(a.v, b.v)}; }
+
+    inline Pack operator-(Pack a) { return {_mm512_sub_pd(_mm512_setzero_pd(), a.v)}; }
+
+    inline Pack fmadd(Pack a, Pack b, Pack c) { return {_mm512_fmadd_pd(a.v, b.v, c.v)}; } // a * b + c
+
+    inline Pack fnmadd(Pack a, Pack b, Pack c) { return {_mm512_fnmadd_pd(a.v, b.v, c.v)}; } // c - a * b
+
+    // masked forms with all lanes set and the source given explicitly: unmasked sqrt, roundscale and srli of GCC
+    // headers pass an undefined source and warn with -Wmaybe-uninitialized in every includer
+    inline Pack sqrt(Pack a) { return {_mm512_mask_sqrt_pd(a.v, 0xFF, a.v)}; }
+
+    inline Pack abs(Pack a) { return {_mm512_abs_pd(a.v)}; }
+
+    inline Pack round(Pack a) {
+        return {_mm512_mask_roundscale_pd(a.v, 0xFF, a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+    }
+
+    inline Pack floor(Pack a) {
+        return {_mm512_mask_roundscale_pd(a.v, 0xFF, a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)};
+    }
+
+    inline Mask less(Pack a, Pack b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ)}; }
+
+    inline Pack select(Mask mask, Pack a, Pack b) { return {_mm512_mask_blend_pd(mask.m, b.v, a.v)}; } // mask ? a : b
+
+    inline Pack cbrt_estimate(Pack a) { // a >= 0, bit pattern divided by 3 plus bias as in fdlibm cbrt, ~5% error
+        const __m512i bits = _mm512_castpd_si512(a.v);
+        __m512i i = _mm512_mask_srli_epi64(bits, 0xFF, bits, 2);
+        for (int shift: {2, 4, 8, 16, 32}) i = _mm512_add_epi64(i, _mm512_mask_srli_epi64(i, 0xFF, i, shift));
+        return {_mm512_castsi512_pd(_mm512_add_epi64(i, _mm512_set1_epi64(0x2A9F789300000000)))};
+    }
+
+#include "Simd_kernel.h"
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+/// AVX2 + FMA pack of 8 floats ///
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+namespace simd_avx2_float {
+    struct Pack {
+        __m256 v;
+        static constexpr int width = 8;
+    };
+    struct Mask {
+        __m256 m;
+    };
+
+    inline Pack load(const float *ptr) { return {_mm256_loadu_ps(ptr)}; }
+
+    inline void store(float *ptr, Pack a) { _mm256_storeu_ps(ptr, a.v); }
+
+    inline Pack set1(float a) { return {_mm256_set1_ps(a)}; }
+
+    inline Pack operator+(Pack a, Pack b) { return {_mm256_add_ps(a.v, b.v)}; }
+
+    inline Pack operator-(Pack a, Pack b) { return {_mm256_sub_ps(a.v, b.v)}; }
+
+    inline Pack operator*(Pack a, Pack b) { return {_mm256_mul_ps(a.v, b.v)}; }
+
+    inline Pack operator/(Pack a, Pack b) { return {_mm256_div_ps(a.v, b.v)}; }
+
+    inline Pack operator-(Pack a) { return {_mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f))}; }
+
+    inline Pack fmadd(Pack a, Pack b, Pack c) { return {_mm256_fmadd_ps(a.v, b.v, c.v)}; } // a * b + c
+
+    inline Pack fnmadd(Pack a, Pack b, Pack c) { return {_mm256_fnmadd_ps(a.v, b.v, c.v)}; } // c - a * b
+
+    inline Pack sqrt(Pack a) { return {_mm256_sqrt_ps(a.v)}; }
+
+    inline Pack abs(Pack a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+
+    inline Pack round(Pack a) { return {_mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+
+    inline Pack floor(Pack a) { return {_mm256_floor_ps(a.v)}; }
+
+    inline Mask less(Pack a, Pack b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+
+    inline Pack select(Mask mask, Pack a, Pack b) { return {_mm256_blendv_ps(b.v, a.v, mask.m)}; } // mask ? a : b
+
+#include "Simd_kernel_float.h"
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+/// AVX-512F pack of 16 floats ///
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+namespace simd_avx512_float {
+    struct Pack {
+        __m512 v;
+        static constexpr int width = 16;
+    };
+    struct Mask {
+        __mmask16 m;
+    };
+
+    inline Pack load(const float *ptr) { return {_mm512_loadu_ps(ptr)}; }
+
+    inline void store(float *ptr, Pack a) { _mm512_storeu_ps(ptr, a.v); }
+
+    inline Pack set1(float a) { return {_mm512_set1_ps(a)}; }
+
+    inline Pack operator+(Pack a, Pack b) { return {_mm512_add_ps(a.v, b.v)}; }
+
+    inline Pack operator-(Pack a, Pack b) { return {_mm512_sub_ps(a.v, b.v)}; }
+
+    inline Pack operator*(Pack a, Pack b) { return {_mm512_mul_ps(a.v, b.v)}; }
+
+    inline Pack operator/(Pack a, Pack b) { return {_mm512_div_ps(a.v, b.v)}; }
+
+    inline Pack operator-(Pack a) { return {_mm512_sub_ps(_mm512_setzero_ps(), a.v)}; }
+
+    inline Pack fmadd(Pack a, Pack b, Pack c) { return {_mm512_fmadd_ps(a.v, b.v, c.v)}; } // a * b + c
+
+    inline Pack fnmadd(Pack a, Pack b, Pack c) { return {_mm512_fnmadd_ps(a.v, b.v, c.v)}; } // c - a * b
+
+    inline Pack sqrt(Pack a) { return {_mm512_mask_sqrt_ps(a.v, 0xFFFF, a.v)}; }
+
+    inline Pack abs(Pack a) { return {_mm512_abs_ps(a.v)}; }
+
+    inline Pack round(Pack a) {
+        return {_mm512_mask_roundscale_ps(a.v, 0xFFFF, a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+    }
+
+    inline Pack floor(Pack a) {
+        return {_mm512_mask_roundscale_ps(a.v, 0xFFFF, a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)};
+    }
+
+    inline Mask less(Pack a, Pack b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ)}; }
+
+    inline Pack select(Mask mask, Pack a, Pack b) { return {_mm512_mask_blend_ps(mask.m, b.v, a.v)}; } // mask ? a : b
+
+#include "Simd_kernel_float.h"
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif
+
+#endif //ORBITAL_MANEUVERS_SIMD_H
@@ -0,0 +1,57 @@
+#ifndef ORBITAL_MANEUVERS_SIMD_CONVERTION_H
+#define ORBITAL_MANEUVERS_SIMD_CONVERTION_H
+
+#include <cstddef>
+#include <type_traits>
+#include "Batch_convertion.h"
+#include "Simd.h"
+
+
+/**
+     * Batch conversion of Keplerian elements to RV vectors with explicit SIMD kernels
+     *
+     * Kernel is chosen at runtime, the tail of the columns that does not fill a whole pack and
+     * types other than double and float go through the scalar batch COE2RV. Float packs are twice as wide.
+     * Vectorized sin/cos agree with std::sin/std::cos within a few ULP for angles below 1e5 rad (1e3 rad for float)
+     * @param: Keplerian elements columns, output RV vectors columns, gravitational parameter, instruction set
+     *
+     */
+template<typename T>
+void COE2RV_simd(const COE_columns<const T> &elem, const RV_columns<T> &rv, T mu,
+                 Simd_level level = supported_simd_level()) {
+    std::size_t done = 0;
+#if ORBITAL_MANEUVERS_X86_SIMD
+    if constexpr (std::is_same_v<T, double>) {
+        if (level > supported_simd_level()) level = supported_simd_level();
+        if (level == Simd_level::avx512)
+            done = simd_avx512::COE2RV_kernel(elem.p.data(), elem.e.data(), elem.i.data(), elem.W.data(),
+                                              elem.w.data(), elem.nu.data(), mu, rv.x.data(), rv.y.data(),
+                                              rv.z.data(), rv.vx.data(), rv.vy.data(), rv.vz.data(), elem.size());
+        if (level == Simd_level::avx2)
+            done = simd_avx2::COE2RV_kernel(elem.p.data(), elem.e.data(), elem.i.data(), elem.W.data(),
+                                            elem.w.data(), elem.nu.data(), mu, rv.x.data(), rv.y.data(),
+                                            rv.z.data(), rv.vx.data(), rv.vy.data(), rv.vz.data(), elem.size());
+    }
+    if constexpr (std::is_same_v<T, float>) {
+        if (level > supported_simd_level()) level = supported_simd_level();
+        if (level == Simd_level::avx512)
+            done = simd_avx512_float::COE2RV_kernel(elem.p.data(), elem.e.data(), elem.i.data(), elem.W.data(),
+                                                    elem.w.data(), elem.nu.data(), mu, rv.x.data(), rv.y.data(),
+                                                    rv.z.data(), rv.vx.data(), rv.vy.data(), rv.vz.data(),
+                                                    elem.size());
+        if (level == Simd_level::avx2)
+            done = simd_avx2_float::COE2RV_kernel(elem.p.data(), elem.e.data(), elem.i.data(), elem.W.data(),
+                                                  elem.w.data(), elem.nu.data(), mu, rv.x.data(), rv.y.data(),
+                                                  rv.z.data(), rv.vx.data(), rv.vy.data(), rv.vz.data(),
+                                                  elem.size());
+    }
+#endif
+    if (done == elem.size()) return;
+    // a and flag columns are not used by COE2RV
+    COE2RV(COE_columns<const T>{elem.p.subspan(done), {}, elem.e.subspan(done), elem.i.subspan(done),
+                                elem.W.subspan(done), elem.w.subspan(done), elem.nu.subspan(done), {}},
+           RV_columns<T>{rv.x.subspan(done), rv.y.subspan(done), rv.z.subspan(done),
+                         rv.vx.subspan(done), rv.vy.subspan(done), rv.vz.subspan(done)}, mu);
+}
+
+#endif //ORBITAL_MANEUVERS_SIMD_CONVERTION_H
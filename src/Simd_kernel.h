@@ -0,0 +1,260 @@
+// Instruction set independent part of Simd.h
+//
+// Included once per instruction set inside its namespace, after definition of Pack, Mask and
+// operations on them, so there is no include guard.
+
+
+/**
+     * Simultaneous sine and cosine of a pack of angles
+     *
+     * Cody-Waite reduction by pi/2 and fdlibm polynomials on [-pi/4, pi/4]
+     * @param: angles, output sines, output cosines
+     *
+     */
+inline void sincos(Pack x, Pack &sin_, Pack &cos_) {
+    const Pack q = round(x * set1(0.63661977236758134308)); // number of quarter turns
+    Pack y = fnmadd(q, set1(1.57079625129699707031e+00), x);
+    y = fnmadd(q, set1(7.54978941586159635335e-08), y);
+    y = fnmadd(q, set1(5.39030285815811905290e-15), y);
+    const Pack z = y * y;
+
+    Pack ps = fmadd(z, set1(1.58969099521155010221e-10), set1(-2.50507602534068634195e-08));
+    ps = fmadd(z, ps, set1(2.75573137070700676789e-06));
+    ps = fmadd(z, ps, set1(-1.98412698298579493134e-04));
+    ps = fmadd(z, ps, set1(8.33333333332248946124e-03));
+    ps = fmadd(z, ps, set1(-1.66666666666666324348e-01));
+    ps = fmadd(y * z, ps, y);
+
+    Pack pc = fmadd(z, set1(-1.13596475577881948265e-11), set1(2.08757232129817482790e-09));
+    pc = fmadd(z, pc, set1(-2.75573143513906633035e-07));
+    pc = fmadd(z, pc, set1(2.48015872894767294178e-05));
+    pc = fmadd(z, pc, set1(-1.38888888888741095749e-03));
+    pc = fmadd(z, pc, set1(4.16666666666666019037e-02));
+    pc = fmadd(z * z, pc, fnmadd(set1(0.5), z, set1(1.0)));
+
+    const Pack quadrant = q - set1(4.0) * floor(q * set1(0.25)); // 0, 1, 2 or 3
+    const Mask odd = less(set1(0.5), quadrant - set1(2.0) * floor(quadrant * set1(0.5)));
+    const Mask sin_negative = less(set1(1.5), quadrant);
+    const Mask cos_negative = less(abs(quadrant - set1(1.5)), set1(1.0));
+
+    sin_ = select(odd, pc, ps);
+    cos_ = select(odd, ps, pc);
+    sin_ = select(sin_negative, -sin_, sin_);
+    cos_ = select(cos_negative, -cos_, cos_);
+}
+
+/**
+     * Conversion of Keplerian elements to RV vectors for whole packs of the columns
+     *
+     * @param: pointers to Keplerian elements columns, gravitational parameter, pointers to RV vectors columns, size
+     * @return number of processed elements, multiple of Pack::width
+     *
+     */
+inline std::size_t COE2RV_kernel(const double *p_, const double *e_, const double *i_, const double *W_,
+                                 const double *w_, const double *nu_, double mu,
+                                 double *x_, double *y_, double *z_, double *vx_, double *vy_, double *vz_,
+                                 std::size_t n_) {
+    const Pack mu_ = set1(mu), one = set1(1.0);
+    std::size_t k = 0;
+    for (; k + Pack::width <= n_; k += Pack::width) {
+        const Pack p = load(p_ + k), e = load(e_ + k);
+        Pack sin_nu, cos_nu, sin_W, cos_W, sin_w, cos_w, sin_i, cos_i;
+        sincos(load(nu_ + k), sin_nu, cos_nu);
+        sincos(load(W_ + k), sin_W, cos_W);
+        sincos(load(w_ + k), sin_w, cos_w);
+        sincos(load(i_ + k), sin_i, cos_i);
+
+        const Pack r_ = p / fmadd(e, cos_nu, one); // R and V vectors in perifocal coordinate system
+        const Pack r_p = r_ * cos_nu, r_q = r_ * sin_nu;
+        const Pack sqrt_mu_p = sqrt(mu_ / p);
+        const Pack v_p = -(sqrt_mu_p * sin_nu), v_q = sqrt_mu_p * (e + cos_nu);
+
+        const Pack sin_w_cos_i = sin_w * cos_i, cos_w_cos_i = cos_w * cos_i; // matrix of coordinate transformations
+        const Pack Px = fnmadd(sin_W, sin_w_cos_i, cos_W * cos_w);
+        const Pack Py = fmadd(cos_W, sin_w_cos_i, sin_W * cos_w);
+        const Pack Pz = sin_w * sin_i;
+        const Pack Qx = -fmadd(sin_W, cos_w_cos_i, cos_W * sin_w);
+        const Pack Qy = fnmadd(sin_W, sin_w, cos_W * cos_w_cos_i);
+        const Pack Qz = cos_w * sin_i;
+
+        store(x_ + k, fmadd(Qx, r_q, Px * r_p));
+        store(y_ + k, fmadd(Qy, r_q, Py * r_p));
+        store(z_ + k, fmadd(Qz, r_q, Pz * r_p));
+        store(vx_ + k, fmadd(Qx, v_q, Px * v_p));
+        store(vy_ + k, fmadd(Qy, v_q, Py * v_p));
+        store(vz_ + k, fmadd(Qz, v_q, Pz * v_p));
+    }
+    return k;
+}
+
+/**
+     * Cube root of a pack of non-negative numbers
+     *
+     * Estimate from the bit pattern and three Halley iterations
+     * @param: pack
+     * @return cube roots
+     *
+     */
+inline Pack cbrt(Pack x) {
+    Pack y = cbrt_estimate(x);
+    for (int iter = 0; iter < 3; iter++) {
+        const Pack y3 = y * y * y;
+        y = y * fmadd(set1(2.0), x, y3) / fmadd(set1(2.0), y3, x);
+    }
+    return y;
+}
+
+/**
+     * Arctangent of a pack
+     *
+     * Reduction to [0, tan(pi/8)] and Cephes rational approximation
+     * @param: pack
+     * @return arctangents in [-pi/2, pi/2]
+     *
+     */
+inline Pack atan(Pack x) {
+    const Pack zero = set1(0.0), one = set1(1.0);
+    const Pack ax = abs(x);
+    const Mask big = less(set1(2.41421356237309504880), ax); // tan(3pi/8)
+    const Mask middle = less(set1(0.66), ax);
+    Pack y = select(big, set1(1.57079632679489661923), select(middle, set1(0.78539816339744830962), zero));
+    Pack xr = select(big, -(one / ax), select(middle, (ax - one) / (ax + one), ax));
+    const Pack more_bits = select(big, set1(6.123233995736765886130e-17),
+                                  select(middle, set1(3.061616997868382943065e-17), zero));
+
+    const Pack z = xr * xr;
+    Pack p = fmadd(z, set1(-8.750608600031904122785e-01), set1(-1.615753718733365076637e+01));
+    p = fmadd(z, p, set1(-7.500855792314704667340e+01));
+    p = fmadd(z, p, set1(-1.228866684490136173410e+02));
+    p = fmadd(z, p, set1(-6.485021904942025371773e+01));
+    Pack q = z + set1(2.485846490142306297962e+01);
+    q = fmadd(z, q, set1(1.650270098316988542046e+02));
+    q = fmadd(z, q, set1(4.328810604912902668951e+02));
+    q = fmadd(z, q, set1(4.853903996359136964868e+02));
+    q = fmadd(z, q, set1(1.945506571482613964425e+02));
+
+    y = y + (fmadd(xr, z * p / q, xr) + more_bits);
+    return select(less(x, zero), -y, y);
+}
+
+/**
+     * True anomalies of elliptic orbits after time step for whole packs of the columns
+     *
+     * Markley's starter and two Halley iterations of Kepler's equation, same as Eccentric_anomaly
+     * @param: pointers to mean anomaly at epoch, mean motion, eccentricity, sqrt((1 + e) / (1 - e)) columns,
+     * time step, pointer to output true anomaly column, size
+     * @return number of processed elements, multiple of Pack::width
+     *
+     */
+inline std::size_t Kepler_kernel(const double *M0_, const double *n_, const double *e_, const double *beta_,
+                                 double dt, double *nu_, std::size_t n_orbits) {
+    const double pi = 3.14159265358979323846;
+    const Pack zero = set1(0.0), one = set1(1.0), two = set1(2.0), dt_ = set1(dt);
+    const Pack two_pi = set1(2 * pi), pi2 = set1(pi * pi);
+    std::size_t k = 0;
+    for (; k + Pack::width <= n_orbits; k += Pack::width) {
+        const Pack e = load(e_ + k);
+        Pack M = fmadd(load(n_ + k), dt_, load(M0_ + k));
+        M = fnmadd(two_pi, round(M * set1(1 / (2 * pi))), M); // [-pi, pi]
+        const Pack aM = abs(M);
+
+        const Pack alpha = (set1(3 * pi * pi) + set1(1.6 * pi) * (set1(pi) - aM) / (one + e)) / (pi2 - set1(6.0));
+        const Pack d = fmadd(alpha, e, set1(3.0) * (one - e));
+        const Pack q = two * alpha * d * (one - e) - aM * aM;
+        const Pack r = fmadd(set1(3.0) * alpha * d * (d - one + e), aM, aM * aM * aM);
+        const Pack disc = fmadd(q * q, q, r * r);
+        Pack w = cbrt(abs(r) + sqrt(select(less(disc, zero), zero, disc)));
+        w = w * w;
+        Pack E = (two * r * w / (fmadd(w, w + q, q * q)) + aM) / d;
+        E = select(less(M, zero), -E, E);
+
+        Pack sin_E, cos_E;
+        for (int iter = 0; iter < 2; iter++) { // Halley iterations
+            sincos(E, sin_E, cos_E);
+            const Pack f = fnmadd(e, sin_E, E) - M;
+            const Pack f1 = fnmadd(e, cos_E, one);
+            const Pack f2 = e * sin_E;
+            E = E - f / fnmadd(f * f2, set1(0.5) / f1, f1);
+        }
+        sincos(E, sin_E, cos_E);
+        Pack nu = two * atan(load(beta_ + k) * sin_E / (one + cos_E));
+        store(nu_ + k, select(less(nu, zero), nu + two_pi, nu));
+    }
+    return k;
+}
+
+/**
+     * Gravity acceleration with J2 for whole packs of the columns
+     *
+     * a = -mu / r^3 * (x (1 + q (1 - 5 z^2 / r^2)), y (1 + q (1 - 5 z^2 / r^2)), z (1 + q (3 - 5 z^2 / r^2))),
+     * q = 1.5 J2 R^2 / r^2, same as detail::Gravity of Numerical_propagation.h
+     * @param: pointers to R vectors columns, gravitational parameter, 1.5 J2 R^2, pointers to acceleration columns, size
+     * @return number of processed elements, multiple of Pack::width
+     *
+     */
+inline std::size_t J2_kernel(const double *x_, const double *y_, const double *z_, double mu, double j2,
+                             double *ax_, double *ay_, double *az_, std::size_t n_) {
+    const Pack mu_ = set1(mu), j2_ = set1(j2), one = set1(1.0), two = set1(2.0), five = set1(5.0);
+    std::size_t k = 0;
+    for (; k + Pack::width <= n_; k += Pack::width) {
+        const Pack x = load(x_ + k), y = load(y_ + k), z = load(z_ + k);
+        const Pack r2 = fmadd(x, x, fmadd(y, y, z * z));
+        const Pack inv_r2 = one / r2;
+        const Pack mu_r3 = mu_ * inv_r2 / sqrt(r2);
+        const Pack q = j2_ * inv_r2;
+        const Pack c_xy = -(mu_r3 * fmadd(q, fnmadd(five * z * z, inv_r2, one), one));
+        const Pack c_z = fnmadd(mu_r3 * q, two, c_xy); // -mu / r^3 (1 + q (3 - 5 z^2 / r^2))
+        store(ax_ + k, c_xy * x);
+        store(ay_ + k, c_xy * y);
+        store(az_ + k, c_z * z);
+    }
+    return k;
+}
+
+/**
+     * Linear combination of columns for whole packs, out = y + h * sum(c_j K_j), stages of Runge-Kutta method
+     *
+     * @param: pointers to state column and step column (both null for out = sum(c_j K_j)), pointers to columns K_j,
+     * coefficients c_j, number of columns, pointer to output column, size
+     * @return number of processed elements, multiple of Pack::width
+     *
+     */
+inline std::size_t Combination_kernel(const double *y_, const double *h_, const double *const *K_, const double *c_,
+                                      int count, double *out_, std::size_t n_) {
+    std::size_t k = 0;
+    for (; k + Pack::width <= n_; k += Pack::width) {
+        Pack sum = load(K_[0] + k) * set1(c_[0]);
+        for (int j = 1; j < count; j++) sum = fmadd(set1(c_[j]), load(K_[j] + k), sum);
+        store(out_ + k, y_ ? fmadd(load(h_ + k), sum, load(y_ + k)) : sum);
+    }
+    return k;
+}
+
+// size of the block of the matrix product, computed by Gemm_kernel
+inline constexpr int gemm_mr = Pack::width == 8 ? 8 : 6;
+inline constexpr int gemm_nr = 2 * Pack::width;
+
+/**
+     * Register-blocked micro-kernel of matrix multiplication
+     *
+     * c = a * b for a gemm_mr x kc panel of a, packed column by column, and a kc x gemm_nr panel of b, packed row by row,
+     * accumulators of the whole gemm_mr x gemm_nr block stay in registers during the loop over kc
+     * @param: kc, packed panels, output row-major gemm_mr x gemm_nr block
+     *
+     */
+inline void Gemm_kernel(std::size_t kc, const double *a, const double *b, double *c) {
+    Pack acc0[gemm_mr], acc1[gemm_mr];
+    for (int i = 0; i < gemm_mr; i++) acc0[i] = acc1[i] = set1(0.0);
+    for (std::size_t p = 0; p < kc; p++) {
+        const Pack b0 = load(b + p * gemm_nr), b1 = load(b + p * gemm_nr + Pack::width);
+        for (int i = 0; i < gemm_mr; i++) {
+            const Pack a_ = set1(a[p * gemm_mr + i]);
+            acc0[i] = fmadd(a_, b0, acc0[i]);
+            acc1[i] = fmadd(a_, b1, acc1[i]);
+        }
+    }
+    for (int i = 0; i < gemm_mr; i++) {
+        store(c + i * gemm_nr, acc0[i]);
+        store(c + i * gemm_nr + Pack::width, acc1[i]);
+    }
+}
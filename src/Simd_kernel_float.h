@@ -0,0 +1,82 @@
+// Instruction set independent part of Simd.h for packs of floats
+//
+// Included once per instruction set inside its namespace, after definition of Pack, Mask and
+// operations on them, so there is no include guard.
+
+
+/**
+     * Simultaneous sine and cosine of a pack of angles
+     *
+     * Cody-Waite reduction by pi/2 and Cephes sinf/cosf polynomials on [-pi/4, pi/4]
+     * @param: angles, output sines, output cosines
+     *
+     */
+inline void sincos(Pack x, Pack &sin_, Pack &cos_) {
+    const Pack q = round(x * set1(0.636619772f)); // number of quarter turns
+    Pack y = fnmadd(q, set1(1.5703125f), x);
+    y = fnmadd(q, set1(4.83751296997070312e-4f), y);
+    y = fnmadd(q, set1(7.54978995489188216e-8f), y);
+    const Pack z = y * y;
+
+    Pack ps = fmadd(z, set1(-1.9515295891e-4f), set1(8.3321608736e-3f));
+    ps = fmadd(z, ps, set1(-1.6666654611e-1f));
+    ps = fmadd(y * z, ps, y);
+
+    Pack pc = fmadd(z, set1(2.443315711809948e-5f), set1(-1.388731625493765e-3f));
+    pc = fmadd(z, pc, set1(4.166664568298827e-2f));
+    pc = fmadd(z * z, pc, fnmadd(set1(0.5f), z, set1(1.0f)));
+
+    const Pack quadrant = q - set1(4.0f) * floor(q * set1(0.25f)); // 0, 1, 2 or 3
+    const Mask odd = less(set1(0.5f), quadrant - set1(2.0f) * floor(quadrant * set1(0.5f)));
+    const Mask sin_negative = less(set1(1.5f), quadrant);
+    const Mask cos_negative = less(abs(quadrant - set1(1.5f)), set1(1.0f));
+
+    sin_ = select(odd, pc, ps);
+    cos_ = select(odd, ps, pc);
+    sin_ = select(sin_negative, -sin_, sin_);
+    cos_ = select(cos_negative, -cos_, cos_);
+}
+
+/**
+     * Conversion of Keplerian elements to RV vectors for whole packs of the columns
+     *
+     * @param: pointers to Keplerian elements columns, gravitational parameter, pointers to RV vectors columns, size
+     * @return number of processed elements, multiple of Pack::width
+     *
+     */
+inline std::size_t COE2RV_kernel(const float *p_, const float *e_, const float *i_, const float *W_,
+                                 const float *w_, const float *nu_, float mu,
+                                 float *x_, float *y_, float *z_, float *vx_, float *vy_, float *vz_,
+                                 std::size_t n_) {
+    const Pack mu_ = set1(mu), one = set1(1.0f);
+    std::size_t k = 0;
+    for (; k + Pack::width <= n_; k += Pack::width) {
+        const Pack p = load(p_ + k), e = load(e_ + k);
+        Pack sin_nu, cos_nu, sin_W, cos_W, sin_w, cos_w, sin_i, cos_i;
+        sincos(load(nu_ + k), sin_nu, cos_nu);
+        sincos(load(W_ + k), sin_W, cos_W);
+        sincos(load(w_ + k), sin_w, cos_w);
+        sincos(load(i_ + k), sin_i, cos_i);
+
+        const Pack r_ = p / fmadd(e, cos_nu, one); // R and V vectors in perifocal coordinate system
+        const Pack r_p = r_ * cos_nu, r_q = r_ * sin_nu;
+        const Pack sqrt_mu_p = sqrt(mu_ / p);
+        const Pack v_p = -(sqrt_mu_p * sin_nu), v_q = sqrt_mu_p * (e + cos_nu);
+
+        const Pack sin_w_cos_i = sin_w * cos_i, cos_w_cos_i = cos_w * cos_i; // matrix of coordinate transformations
+        const Pack Px = fnmadd(sin_W, sin_w_cos_i, cos_W * cos_w);
+        const Pack Py = fmadd(cos_W, sin_w_cos_i, sin_W * cos_w);
+        const Pack Pz = sin_w * sin_i;
+        const Pack Qx = -fmadd(sin_W, cos_w_cos_i, cos_W * sin_w);
+        const Pack Qy = fnmadd(sin_W, sin_w, cos_W * cos_w_cos_i);
+        const Pack Qz = cos_w * sin_i;
+
+        store(x_ + k, fmadd(Qx, r_q, Px * r_p));
+        store(y_ + k, fmadd(Qy, r_q, Py * r_p));
+        store(z_ + k, fmadd(Qz, r_q, Pz * r_p));
+        store(vx_ + k, fmadd(Qx, v_q, Px * v_p));
+        store(vy_ + k, fmadd(Qy, v_q, Py * v_p));
+        store(vz_ + k, fmadd(Qz, v_q, Pz * v_p));
+    }
+    return k;
+}
@@ -0,0 +1,72 @@
+#ifndef ORBITAL_MANEUVERS_SOLVERS_H
+#define ORBITAL_MANEUVERS_SOLVERS_H
+
+#include <cmath>
+#include <limits>
+#include <utility>
+
+
+/**
+     * Brent's minimization of a function of one variable on a segment
+     *
+     * Golden-section steps are combined with parabolic interpolation, see R. Brent, Algorithms for
+     * minimization without derivatives. If the function is not unimodal on the segment, a local minimum is returned
+     * @param: function, segment [a, b], relative tolerance of the argument, maximum number of iterations
+     * @return argument and value of the minimum
+     *
+     */
+template<typename T, typename Function>
+std::pair<T, T> Brent_minimize(Function &&f, T a, T b, T tol = T(1e-10), int max_iter = 200) {
+    const T golden = T(0.3819660112501051);
+    const T eps = std::numeric_limits<T>::epsilon();
+    T x = a + golden * (b - a), w = x, v = x;
+    T fx = f(x), fw = fx, fv = fx;
+    T d = 0, e = 0;
+    for (int iter = 0; iter < max_iter; iter++) {
+        T xm = (a + b) / 2;
+        T tol1 = tol * std::abs(x) + eps, tol2 = 2 * tol1;
+        if (std::abs(x - xm) <= tol2 - (b - a) / 2) break;
+        bool golden_step = true;
+        if (std::abs(e) > tol1) { // trying parabolic step through x, w, v
+            T r = (x - w) * (fx - fv);
+            T q = (x - v) * (fx - fw);
+            T p = (x - v) * q - (x - w) * r;
+            q = 2 * (q - r);
+            if (q > 0) p = -p;
+            q = std::abs(q);
+            T e_prev = e;
+            e = d;
+            if (std::abs(p) < std::abs(q * e_prev / 2) && p > q * (a - x) && p < q * (b - x)) {
+                d = p / q;
+                T u = x + d;
+                if (u - a < tol2 || b - u < tol2) d = xm >= x ? tol1 : -tol1;
+                golden_step = false;
+            }
+        }
+        if (golden_step) {
+            e = x >= xm ? a - x : b - x;
+            d = golden * e;
+        }
+        T u = std::abs(d) >= tol1 ? x + d : x + (d >= 0 ? tol1 : -tol1);
+        T fu = f(u);
+        if (fu <= fx) {
+            if (u >= x) a = x;
+            else b = x;
+            v = w, fv = fw;
+            w = x, fw = fx;
+            x = u, fx = fu;
+        } else {
+            if (u < x) a = u;
+            else b = u;
+            if (fu <= fw || w == x) {
+                v = w, fv = fw;
+                w = u, fw = fu;
+            } else if (fu <= fv || v == x || v == w) {
+                v = u, fv = fu;
+            }
+        }
+    }
+    return {x, fx};
+}
+
+#endif //ORBITAL_MANEUVERS_SOLVERS_H
@@ -0,0 +1,203 @@
+#ifndef ORBITAL_MANEUVERS_STATE_TRANSITION_MATRIX_H
+#define ORBITAL_MANEUVERS_STATE_TRANSITION_MATRIX_H
+
+#include <span>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include "Orbital_elements_convertion.h"
+#include "Kepler_propagation.h"
+#include "Dense.h"
+
+
+/**
+     * State and state transition matrix of two-body motion after time step
+     *
+     * @param:
+     * r, v - RV vectors after time step
+     * stm - d(r, v) / d(r0, v0), 6x6
+     *
+     */
+template<typename T>
+struct STM_solution {
+    Vec3<T> r, v;
+    Dense<T, 6, 6> stm;
+};
+
+namespace detail {
+    /**
+     * Universal functions U_0 ... U_5 of universal anomaly
+     *
+     * U_n = chi^n c_n(alpha chi^2) with Stumpff functions c_n, series for small |alpha chi^2|
+     * @param: universal anomaly, alpha = 1 / a, output U_0 ... U_5
+     *
+     */
+    template<typename T>
+    void Universal_functions(T chi, T alpha, T *U) {
+        const T z = alpha * chi * chi;
+        T c[6];
+        if (std::abs(z) < T(0.1)) {
+            T factorial = 1;
+            for (int n = 0; n < 6; n++) {
+                if (n > 0) factorial *= n;
+                T term = 1, sum = 0, f = factorial; // sum_k (-z)^k / (n + 2k)!
+                for (int k = 0; k < 8; k++) {
+                    sum += term / f;
+                    term *= -z;
+                    f *= (n + 2 * k + 1) * (n + 2 * k + 2);
+                }
+                c[n] = sum;
+            }
+        } else {
+            const T s = std::sqrt(std::abs(z));
+            if (z > 0) {
+                c[0] = std::cos(s);
+                c[1] = std::sin(s) / s;
+            } else {
+                c[0] = std::cosh(s);
+                c[1] = std::sinh(s) / s;
+            }
+            c[2] = (1 - c[0]) / z;
+            c[3] = (1 - c[1]) / z;
+            c[4] = (T(0.5) - c[2]) / z;
+            c[5] = (T(1) / 6 - c[3]) / z;
+        }
+        T chi_n = 1;
+        for (int n = 0; n < 6; n++) {
+            U[n] = chi_n * c[n];
+            chi_n *= chi;
+        }
+    }
+
+    // m(row_, col_) block += coef a b^T
+    template<typename T>
+    void Add_outer(Dense<T, 6, 6> &m, int row_, int col_, T coef, const Vec3<T> &a, const Vec3<T> &b) {
+        for (int i = 0; i < 3; i++) for (int j = 0; j < 3; j++) m(row_ + i, col_ + j) += coef * a[i] * b[j];
+    }
+
+    /**
+     * State and STM for known universal anomaly
+     *
+     * Lagrange coefficients and Battin's closed form of the STM (R. Battin, An Introduction to the Mathematics
+     * and Methods of Astrodynamics, 9.7)
+     *
+     */
+    template<typename T>
+    STM_solution<T> Universal_STM(const Vec3<T> &r0, const Vec3<T> &v0, T dt, T mu, T chi, T alpha) {
+        const T sqrt_mu = std::sqrt(mu), r0_norm = norm(r0), sigma0 = scalar(r0, v0) / sqrt_mu;
+        T U[6];
+        Universal_functions(chi, alpha, U);
+        const T r_norm = r0_norm * U[0] + sigma0 * U[1] + U[2];
+
+        const T F = 1 - U[2] / r0_norm, G = (r0_norm * U[1] + sigma0 * U[2]) / sqrt_mu;
+        const T Ft = -sqrt_mu * U[1] / (r_norm * r0_norm), Gt = 1 - U[2] / r_norm;
+        STM_solution<T> res{F * r0 + G * v0, Ft * r0 + Gt * v0, {}};
+        const Vec3<T> &r = res.r, &v = res.v;
+        const Vec3<T> dv = v - v0;
+        const T C = (3 * U[5] - chi * U[4]) / sqrt_mu - dt * U[2];
+        const T r0_3 = r0_norm * r0_norm * r0_norm, r_2 = r_norm * r_norm, r_3 = r_2 * r_norm;
+
+        Dense<T, 6, 6> &m = res.stm;
+        for (int i = 0; i < 3; i++) {
+            m(i, i) = F;
+            m(i, 3 + i) = G;
+            m(3 + i, i) = Ft;
+            m(3 + i, 3 + i) = Gt;
+        }
+        Add_outer(m, 0, 0, r_norm / mu, dv, dv); // dr / dr0
+        Add_outer(m, 0, 0, r0_norm * (1 - F) / r0_3, r, r0);
+        Add_outer(m, 0, 0, C / r0_3, v, r0);
+
+        Add_outer(m, 0, 3, r0_norm * (1 - F) / mu, r - r0, v0); // dr / dv0
+        Add_outer(m, 0, 3, -r0_norm * (1 - F) / mu, dv, r0);
+        Add_outer(m, 0, 3, C / mu, v, v0);
+
+        const Vec3<T> rv = r * scalar(r, v) - v * r_2; // (r v^T - v r^T) r
+        Add_outer(m, 3, 0, -1 / (r0_norm * r0_norm), dv, r0); // dv / dr0
+        Add_outer(m, 3, 0, -1 / r_2, r, dv);
+        Add_outer(m, 3, 0, -Ft / r_2, r, r);
+        Add_outer(m, 3, 0, Ft / (mu * r_norm), rv, dv);
+        Add_outer(m, 3, 0, -mu * C / (r_3 * r0_3), r, r0);
+
+        Add_outer(m, 3, 3, r0_norm / mu, dv, dv); // dv / dv0
+        Add_outer(m, 3, 3, r0_norm * (1 - F) / r_3, r, r0);
+        Add_outer(m, 3, 3, -C / r_3, r, v0);
+        return res;
+    }
+}
+
+/**
+     * State transition matrix of two-body motion from RV vectors
+     *
+     * Universal Kepler's equation is solved by Laguerre-Conway iterations, so any type of orbit is accepted.
+     * Everything is on the stack
+     * @param: RV vectors, time step, gravitational parameter, tolerance, maximum number of iterations
+     * @return RV vectors after time step and 6x6 STM
+     *
+     */
+template<typename T>
+STM_solution<T> State_transition_matrix(const Vec3<T> &r0, const Vec3<T> &v0, T dt, T mu,
+                                        T tol = 8 * std::numeric_limits<T>::epsilon(), int max_iter = 50) {
+    const T sqrt_mu = std::sqrt(mu), r0_norm = norm(r0), sigma0 = scalar(r0, v0) / sqrt_mu;
+    const T alpha = 2 / r0_norm - scalar(v0, v0) / mu;
+    T chi = alpha > 0 ? sqrt_mu * dt * alpha : sqrt_mu * dt / r0_norm;
+    T U[6];
+    for (int iter = 0; iter < max_iter; iter++) {
+        detail::Universal_functions(chi, alpha, U);
+        const T f = r0_norm * U[1] + sigma0 * U[2] + U[3] - sqrt_mu * dt;
+        const T f1 = r0_norm * U[0] + sigma0 * U[1] + U[2];
+        const T f2 = sigma0 * U[0] + (1 - alpha * r0_norm) * U[1];
+        const T delta = 5 * f / (f1 + std::copysign(std::sqrt(std::abs(16 * f1 * f1 - 20 * f * f2)), f1));
+        chi -= delta;
+        if (std::abs(delta) <= tol * std::max(T(1), std::abs(chi))) break;
+    }
+    return detail::Universal_STM(r0, v0, dt, mu, chi, alpha);
+}
+
+/**
+     * State transition matrix of two-body motion from Keplerian elements
+     *
+     * For elliptic orbits universal anomaly is sqrt(a) (E - E0) with E from Eccentric_anomaly, so there are no
+     * iterations on universal Kepler's equation, other orbits go to the RV version
+     * @param: Keplerian elements, time step
+     * @return RV vectors after time step and STM with respect to the RV vectors of COE2RV(elem)
+     *
+     */
+template<typename T>
+STM_solution<T> State_transition_matrix(const COE<T> &elem, T dt) {
+    auto [r0, v0] = COE2RV(elem);
+    if (!(elem.e < 1)) return State_transition_matrix(r0, v0, dt, elem.mu);
+    const T anomaly = elem.flag == 1 ? elem.lam_true : (elem.flag == 2 ? elem.u : elem.nu);
+    const T E0 = 2 * std::atan2(std::sqrt(1 - elem.e) * std::sin(anomaly / 2),
+                                std::sqrt(1 + elem.e) * std::cos(anomaly / 2));
+    const T M = E0 - elem.e * std::sin(E0) + Mean_motion(elem.p, elem.a, elem.e, elem.mu) * dt;
+    const T chi = std::sqrt(elem.a) * (Eccentric_anomaly(M, elem.e) - E0);
+    return detail::Universal_STM(r0, v0, dt, elem.mu, chi, 1 / elem.a);
+}
+
+/**
+     * Batch covariance propagation P' = STM P STM^T
+     *
+     * STM P is done by fixed-size Dense product, only the upper triangle of the symmetric result is computed
+     * @param: STMs, covariance matrices, output covariance matrices, all of the same size
+     *
+     */
+template<typename T>
+void Covariance_propagation(std::span<const Dense<T, 6, 6>> stm, std::span<const Dense<T, 6, 6>> covariance,
+                            std::span<Dense<T, 6, 6>> result) {
+    for (std::size_t k = 0; k < stm.size(); k++) {
+        const Dense<T, 6, 6> &phi = stm[k];
+        const Dense<T, 6, 6> tmp = phi * covariance[k];
+        Dense<T, 6, 6> &res = result[k];
+        for (int i = 0; i < 6; i++) {
+            for (int j = i; j < 6; j++) {
+                T sum = 0;
+                for (int p = 0; p < 6; p++) sum += tmp(i, p) * phi(j, p);
+                res(i, j) = res(j, i) = sum;
+            }
+        }
+    }
+}
+
+
+#endif //ORBITAL_MANEUVERS_STATE_TRANSITION_MATRIX_H
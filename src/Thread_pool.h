@@ -0,0 +1,99 @@
+#ifndef ORBITAL_MANEUVERS_THREAD_POOL_H
+#define ORBITAL_MANEUVERS_THREAD_POOL_H
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <vector>
+#include <cstddef>
+
+
+/**
+     * Pool of persistent worker threads
+     *
+     * parallel_for hands out task indices through a shared atomic counter, so a worker that finished
+     * its tasks immediately takes the next free one and the load is balanced without a central queue.
+     * The calling thread works as worker 0.
+     *
+     */
+class Thread_pool {
+private:
+    std::vector<std::thread> workers_;
+    std::function<void(unsigned)> job_;
+    std::atomic<std::size_t> generation_{0}; // incremented, when a new job is published
+    std::atomic<unsigned> running_{0}; // number of workers, that did not finish the current job
+    std::atomic<bool> stop_{false};
+
+    void worker_loop(unsigned worker) {
+        std::size_t seen = 0;
+        while (true) {
+            generation_.wait(seen);
+            seen = generation_.load();
+            if (stop_) return;
+            job_(worker);
+            if (--running_ == 0) running_.notify_one();
+        }
+    }
+
+public:
+    explicit Thread_pool(unsigned n_threads = std::thread::hardware_concurrency()) {
+        if (n_threads == 0) n_threads = 1;
+        workers_.reserve(n_threads - 1);
+        for (unsigned i = 1; i < n_threads; i++) workers_.emplace_back(&Thread_pool::worker_loop, this, i);
+    }
+
+    Thread_pool(const Thread_pool &) = delete;
+
+    Thread_pool &operator=(const Thread_pool &) = delete;
+
+    ~Thread_pool() {
+        stop_ = true;
+        generation_++;
+        generation_.notify_all();
+        for (auto &worker: workers_) worker.join();
+    }
+
+    unsigned size() const { return workers_.size() + 1; }
+
+    /**
+     * Running function(task, worker) for every task in [0, n_tasks)
+     *
+     * Returns, when all tasks are finished. The first exception thrown by a task is rethrown here,
+     * remaining tasks are skipped
+     * @param: number of tasks, function of task index and worker index (less than size())
+     *
+     */
+    template<typename Function>
+    void parallel_for(std::size_t n_tasks, Function &&function) {
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto job = [&](unsigned worker) {
+            for (std::size_t task = next++; task < n_tasks; task = next++) {
+                try {
+                    function(task, worker);
+                } catch (...) {
+                    std::lock_guard lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                    next = n_tasks;
+                }
+            }
+        };
+        if (workers_.empty() || n_tasks <= 1) {
+            job(0);
+        } else {
+            job_ = job;
+            running_ = workers_.size();
+            generation_++;
+            generation_.notify_all();
+            job(0);
+            for (unsigned running = running_; running != 0; running = running_) running_.wait(running);
+            job_ = nullptr;
+        }
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+#endif //ORBITAL_MANEUVERS_THREAD_POOL_H
@@ -0,0 +1,142 @@
+#ifndef ORBITAL_MANEUVERS_TRANSFER_COST_MATRIX_H
+#define ORBITAL_MANEUVERS_TRANSFER_COST_MATRIX_H
+
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include "Orbital_maneuvers.h"
+#include "Prepared_orbit.h"
+#include "Thread_pool.h"
+
+
+/**
+     * Maneuvers, available for the cost matrix by name
+     *
+     * Two_impulse is the sum of magnitudes of the burns (Two_impulse_burns), so no cost of the matrix is negative
+     *
+     */
+enum class Maneuver {
+    Hohmann,
+    Two_impulse,
+    Edelbaum
+};
+
+/**
+     * Block of the cost matrix
+     *
+     * @param:
+     * row_begin, col_begin - indices of the first initial and final orbits of the block
+     * rows, cols - size of the block
+     * cost - delta-v of the block, row-major, cost[r * cols + c] is the transfer from initial[row_begin + r]
+     *        to final[col_begin + c]. Memory is reused after the consumer returns
+     *
+     */
+template<typename T>
+struct Cost_tile {
+    std::size_t row_begin, col_begin;
+    std::size_t rows, cols;
+    std::span<const T> cost;
+};
+
+/**
+     * Cost matrix evaluation parameters
+     *
+     * @param:
+     * tile_rows, tile_cols - size of the blocks, which are evaluated by one worker at once
+     * n_threads - number of threads of the pool, created when the whole matrix is stored, 0 is for all cores
+     *
+     */
+struct Cost_matrix_options {
+    std::size_t tile_rows = 64;
+    std::size_t tile_cols = 64;
+    unsigned n_threads = 0;
+};
+
+/**
+     * Delta-v of transfers between every pair of orbits of two catalogs
+     *
+     * Matrix is split into tiles, tiles are spread over the threads of the pool and passed to consumer
+     * as soon as they are ready, so the whole matrix is never stored. Consumer is called concurrently
+     * from different threads, tiles come in no particular order
+     * @param: initial and final orbits catalogs (COE, Prepared_orbit or any other type, accepted by cost),
+     * cost(initial, final) function, consumer(const Cost_tile<T> &), thread pool, size of tiles
+     *
+     */
+template<typename Orbit, typename Cost, typename Consumer>
+void Transfer_cost_matrix(const std::vector<Orbit> &initial, const std::vector<Orbit> &final, Cost &&cost,
+                          Consumer &&consumer, Thread_pool &pool, const Cost_matrix_options &options = {}) {
+    using T = std::invoke_result_t<Cost &, const Orbit &, const Orbit &>;
+    const std::size_t tile_rows = std::max<std::size_t>(options.tile_rows, 1);
+    const std::size_t tile_cols = std::max<std::size_t>(options.tile_cols, 1);
+    const std::size_t n_row_tiles = (initial.size() + tile_rows - 1) / tile_rows;
+    const std::size_t n_col_tiles = (final.size() + tile_cols - 1) / tile_cols;
+
+    std::vector<std::vector<T>> buffers(pool.size(), std::vector<T>(tile_rows * tile_cols));
+    pool.parallel_for(n_row_tiles * n_col_tiles, [&](std::size_t task, unsigned worker) {
+        Cost_tile<T> tile;
+        tile.row_begin = (task / n_col_tiles) * tile_rows;
+        tile.col_begin = (task % n_col_tiles) * tile_cols;
+        tile.rows = std::min(tile_rows, initial.size() - tile.row_begin);
+        tile.cols = std::min(tile_cols, final.size() - tile.col_begin);
+
+        std::vector<T> &buffer = buffers[worker];
+        for (std::size_t r = 0; r < tile.rows; r++) {
+            const Orbit &from = initial[tile.row_begin + r];
+            for (std::size_t c = 0; c < tile.cols; c++) buffer[r * tile.cols + c] = cost(from, final[tile.col_begin + c]);
+        }
+        tile.cost = std::span<const T>(buffer.data(), tile.rows * tile.cols);
+        consumer(tile);
+    });
+}
+
+template<typename T, typename Consumer>
+void Transfer_cost_matrix(const std::vector<COE<T>> &initial, const std::vector<COE<T>> &final, Maneuver maneuver,
+                          Consumer &&consumer, Thread_pool &pool, const Cost_matrix_options &options = {}) {
+    // every orbit is prepared once, so the pairwise loop does only the pair-specific arithmetic
+    std::vector<Prepared_orbit<T>> prepared_initial(initial.begin(), initial.end());
+    std::vector<Prepared_orbit<T>> prepared_final(final.begin(), final.end());
+    switch (maneuver) { // maneuver is chosen once, the inner loop calls the function directly
+        case Maneuver::Hohmann:
+            Transfer_cost_matrix(prepared_initial, prepared_final,
+                                 [](const Prepared_orbit<T> &from, const Prepared_orbit<T> &to) {
+                                     return Hohmann_transfer(from, to);
+                                 }, consumer, pool, options);
+            break;
+        case Maneuver::Two_impulse:
+            Transfer_cost_matrix(prepared_initial, prepared_final,
+                                 [](const Prepared_orbit<T> &from, const Prepared_orbit<T> &to) {
+                                     return Two_impulse_burns(from, to);
+                                 }, consumer, pool, options);
+            break;
+        case Maneuver::Edelbaum:
+            Transfer_cost_matrix(prepared_initial, prepared_final,
+                                 [](const Prepared_orbit<T> &from, const Prepared_orbit<T> &to) {
+                                     return Edelbaum_transfer(from, to);
+                                 }, consumer, pool, options);
+            break;
+    }
+}
+
+/**
+     * Delta-v of transfers between every pair of orbits of two catalogs, stored as a whole matrix
+     *
+     * @param: initial and final orbits catalogs, maneuver, size of tiles and number of threads
+     * @return row-major matrix initial.size() x final.size()
+     *
+     */
+template<typename T>
+std::vector<T> Transfer_cost_matrix(const std::vector<COE<T>> &initial, const std::vector<COE<T>> &final,
+                                    Maneuver maneuver, const Cost_matrix_options &options = {}) {
+    std::vector<T> matrix(initial.size() * final.size());
+    Thread_pool pool(options.n_threads ? options.n_threads : std::thread::hardware_concurrency());
+    Transfer_cost_matrix(initial, final, maneuver, [&](const Cost_tile<T> &tile) {
+        for (std::size_t r = 0; r < tile.rows; r++)
+            std::copy_n(tile.cost.begin() + r * tile.cols, tile.cols,
+                        matrix.begin() + (tile.row_begin + r) * final.size() + tile.col_begin);
+    }, pool, options);
+    return matrix;
+}
+
+#endif //ORBITAL_MANEUVERS_TRANSFER_COST_MATRIX_H
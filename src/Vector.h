@@ -4,9 +4,117 @@
 
 #include <iostream>
 #include <vector>
+#include <array>
 #include <cmath>
+#include <math.h>
+#include <type_traits>
+#include "Constexpr_math.h"
 
+// Math functions of T are called unqualified: <math.h> brings std overloads for float and double into the global
+// namespace, Dual of Dual.h gets its own by ADL. Functions, usable in constant expressions, take float and double
+// overloads from constexpr_math by using-declarations
 
+
+/**
+     * Fixed-size 3D vector, that lives on the stack
+     *
+     * Trivially copyable replacement of std::vector<T> for R, V and other 3-element vectors
+     *
+     */
+template<typename T>
+struct Vec3 {
+    std::array<T, 3> coord_;
+
+    constexpr T operator[](int i) const { return coord_[i]; }
+
+    constexpr T &operator[](int i) { return coord_[i]; }
+
+    static constexpr int size() { return 3; }
+
+    Vec3() = default;
+
+    constexpr Vec3(T x_, T y_, T z_) : coord_{x_, y_, z_} {};
+
+    explicit Vec3(const std::vector<T> &vec_) : coord_{vec_[0], vec_[1], vec_[2]} {};
+
+    operator std::vector<T>() const { return {coord_[0], coord_[1], coord_[2]}; }
+};
+
+template<typename T>
+constexpr Vec3<T> operator+(const Vec3<T> &vec_1_, const Vec3<T> &vec_2_) {
+    return {vec_1_[0] + vec_2_[0], vec_1_[1] + vec_2_[1], vec_1_[2] + vec_2_[2]};
+}
+
+template<typename T>
+constexpr Vec3<T> operator-(const Vec3<T> &vec_1_, const Vec3<T> &vec_2_) {
+    return {vec_1_[0] - vec_2_[0], vec_1_[1] - vec_2_[1], vec_1_[2] - vec_2_[2]};
+}
+
+template<typename T>
+constexpr Vec3<T> operator-(const Vec3<T> &vec_) {
+    return {-vec_[0], -vec_[1], -vec_[2]};
+}
+
+template<typename T>
+constexpr Vec3<T> operator*(const Vec3<T> &vec_1_, std::type_identity_t<T> mult_) {
+    return {vec_1_[0] * mult_, vec_1_[1] * mult_, vec_1_[2] * mult_};
+}
+
+template<typename T>
+constexpr Vec3<T> operator*(std::type_identity_t<T> mult_, const Vec3<T> &vec_1_) {
+    return vec_1_ * mult_;
+}
+
+template<typename T>
+constexpr Vec3<T> operator/(const Vec3<T> &vec_1_, std::type_identity_t<T> mult_) {
+    return {vec_1_[0] / mult_, vec_1_[1] / mult_, vec_1_[2] / mult_};
+}
+
+template<typename T>
+constexpr T scalar(const Vec3<T> &mult_1, const Vec3<T> &mult_2) {
+    return mult_1[0] * mult_2[0] + mult_1[1] * mult_2[1] + mult_1[2] * mult_2[2];
+}
+
+template<typename T>
+constexpr Vec3<T> cross_product(const Vec3<T> &mult_1, const Vec3<T> &mult_2) {
+    return {mult_1[1] * mult_2[2] - mult_1[2] * mult_2[1],
+            mult_1[2] * mult_2[0] - mult_1[0] * mult_2[2],
+            mult_1[0] * mult_2[1] - mult_1[1] * mult_2[0]};
+}
+
+template<typename T>
+constexpr T norm(const Vec3<T> &vec_) {
+    using constexpr_math::sqrt;
+    return sqrt(scalar(vec_, vec_));
+}
+
+/**
+     * Type of intermediate results, that lose too much precision in T: double for float, T itself otherwise
+     *
+     * Only the terms with cancellation, such as the angle between close planes, are computed in it,
+     * so float storage and arithmetic keep their speed
+     *
+     */
+template<typename T>
+using Accumulator = std::conditional_t<std::is_same_v<T, float>, double, T>;
+
+// angle in [0, pi] between unit vectors, atan2(|a x b|, a b) in Accumulator<T> instead of acos(a b),
+// which loses half of the digits for small angles
+template<typename T>
+T Angle_between(const Vec3<T> &a, const Vec3<T> &b) {
+    using A = Accumulator<T>;
+    const Vec3<A> a_{A(a[0]), A(a[1]), A(a[2])}, b_{A(b[0]), A(b[1]), A(b[2])};
+    return T(atan2(norm(cross_product(a_, b_)), scalar(a_, b_)));
+}
+
+template<typename T>
+std::ostream &operator<<(std::ostream &out, const Vec3<T> &vec_) {
+    for (int j = 0; j < 3; j++) out << vec_[j] << " ";
+    return out;
+}
+
+
+/// std::vector<T> operations, kept for vectors of arbitrary size ///
 template<typename T>
 std::vector<T> operator+(const std::vector<T> &vec_1_, const std::vector<T> &vec_2_) {
     std::vector<T> res_(3);
@@ -58,7 +166,7 @@ template<typename T>
 T norm(const std::vector<T> &vec_) {
     T res_ = 0;
     for (int i = 0; i < vec_.size(); i++) res_ += vec_[i] * vec_[i];
-    return std::sqrt(res_);
+    return sqrt(res_);
 }
 
 template<typename T>
@@ -0,0 +1,34 @@
+#ifndef ORBITAL_MANEUVERS_COUNTING_ALLOCATOR_H
+#define ORBITAL_MANEUVERS_COUNTING_ALLOCATOR_H
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+#include <cstddef>
+
+
+/**
+     * Counting allocator of the test and benchmark binaries
+     *
+     * Replaces global operator new and delete, so every heap allocation of the binary, Thread_pool workers too, is
+     * counted. Replacement functions are not inline: the header is included by exactly one translation unit of a
+     * binary. They are not inlined into callers either, otherwise GCC pairs new with std::free and reports
+     * -Wmismatched-new-delete. Array forms use these by default
+     *
+     */
+static std::atomic<std::size_t> allocation_counter = 0;
+
+// number of allocations so far, relaxed: readers only compare counts taken on their own thread
+inline std::size_t allocation_count() { return allocation_counter.load(std::memory_order_relaxed); }
+
+[[gnu::noinline]] void *operator new(std::size_t size) {
+    allocation_counter.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+[[gnu::noinline]] void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+#endif //ORBITAL_MANEUVERS_COUNTING_ALLOCATOR_H
@@ -1,6 +1,61 @@
 #include "gtest/gtest.h"
 #include "../src/Orbital_elements_convertion.h"
 #include "../src/Orbital_maneuvers.h"
+#include "../src/Batch_convertion.h"
+#include "../src/Simd_convertion.h"
+#include "../src/Transfer_cost_matrix.h"
+#include "../src/Prepared_orbit.h"
+#include "../src/Bi_elliptic_optimization.h"
+#include "../src/Lambert.h"
+#include "../src/Porkchop.h"
+#include "../src/Kepler_propagation.h"
+#include "../src/Dense.h"
+#include "../src/QR.h"
+#include "../src/State_transition_matrix.h"
+#include "../src/Maneuver_planner.h"
+#include "../src/Combined_transfer.h"
+#include "../src/Catalog_stream.h"
+#include "../src/Orbit_catalog.h"
+#include "../src/Precision.h"
+#include "../src/Numerical_propagation.h"
+#include "../src/Low_thrust.h"
+#include "../src/Sequencing.h"
+#include "../src/Dual.h"
+#include "Counting_allocator.h"
+#include <random>
+#include <filesystem>
+#include <limits>
+
+
+/// Random elliptic inclined orbits of the randomized tests ///
+struct Orbit_ranges {
+    double radius_min = 6600, radius_max = 50000;
+    double ecc_min = 0.1, ecc_max = 0.6;
+    double incl_min = 0.1, incl_max = 3;
+    double angle_min = 0, angle_max = 2 * M_PI;
+};
+
+// elliptic inclined orbit (flag 4), dependent angles u, lam_true, w_true agree with W, w, nu
+COE<double> random_elliptic_orbit(std::mt19937 &gen, const Orbit_ranges &ranges = {}, double mu = 398600.4415) {
+    std::uniform_real_distribution<double> radius(ranges.radius_min, ranges.radius_max);
+    std::uniform_real_distribution<double> ecc(ranges.ecc_min, ranges.ecc_max);
+    std::uniform_real_distribution<double> incl(ranges.incl_min, ranges.incl_max);
+    std::uniform_real_distribution<double> angle(ranges.angle_min, ranges.angle_max);
+    COE<double> elem{};
+    elem.e = ecc(gen);
+    elem.a = radius(gen);
+    elem.p = elem.a * (1 - elem.e * elem.e);
+    elem.i = incl(gen);
+    elem.W = angle(gen);
+    elem.w = angle(gen);
+    elem.nu = angle(gen);
+    elem.u = elem.w + elem.nu;
+    elem.lam_true = elem.W + elem.w + elem.nu;
+    elem.w_true = elem.W + elem.w;
+    elem.mu = mu;
+    elem.flag = 4;
+    return elem;
+}
 
 
 /// Converting RV vectors to Keplerian elements ///
@@ -674,6 +729,1644 @@ TEST(ORBITAL_MANEUVERS, PLANE_CHANGE6) {
     ASSERT_NEAR(check.W, elem2.W, 2e-1);
 }
 
+/// Batch conversions ///
+TEST(ORBITAL_MANEUVERS, RV2COE_BATCH) {
+    /**
+     * Batch conversion of RV vectors to Keplerian elements agrees with RV2COE for all types of orbits
+     *
+     * @return Keplerian elements columns
+     */
+    std::vector<double> x{6524.834, 6524.834, 5011.173, 5011.173};
+    std::vector<double> y{6862.875, 6862.875, 6234.5, 6234.5};
+    std::vector<double> z{6448.296, 0, -138.135, 0};
+    std::vector<double> vx{4.901327, 4.901327, 5.499, 5.499};
+    std::vector<double> vy{5.533756, 1.533756, -4.422, -4.422};
+    std::vector<double> vz{-1.976341, 0, -0.1048, 0};
+    double mu = 398600.4415;
+
+    std::size_t n = x.size();
+    std::vector<double> p(n), a(n), e(n), i(n), W(n), w(n), nu(n);
+    std::vector<int> flag(n);
+    COE_columns<double> elem{p, a, e, i, W, w, nu, flag};
+    RV2COE(RV_columns<const double>{x, y, z, vx, vy, vz}, elem, mu);
+
+    for (std::size_t k = 0; k < n; k++) {
+        COE<double> check = RV2COE(Vec3<double>{x[k], y[k], z[k]}, Vec3<double>{vx[k], vy[k], vz[k]}, mu);
+        COE<double> batch = get_COE(elem, k, mu);
+        ASSERT_EQ(batch.flag, check.flag);
+        ASSERT_NEAR(batch.p, check.p, 1e-8);
+        ASSERT_NEAR(batch.a, check.a, 1e-8);
+        ASSERT_NEAR(batch.e, check.e, 1e-12);
+        ASSERT_NEAR(batch.i, check.i, 1e-12);
+        if (check.flag == 2 || check.flag == 4) { ASSERT_NEAR(batch.W, check.W, 1e-12); }
+        if (check.flag == 2) { ASSERT_NEAR(batch.u, check.u, 1e-12); }
+        if (check.flag == 3) { ASSERT_NEAR(batch.w_true, check.w_true, 1e-12); }
+        if (check.flag >= 3) { ASSERT_NEAR(batch.nu, check.nu, 1e-12); }
+        if (check.flag == 4) { ASSERT_NEAR(batch.w, check.w, 1e-12); }
+    }
+    ASSERT_EQ(flag[0], 4);
+    ASSERT_EQ(flag[1], 3);
+    ASSERT_EQ(flag[2], 2);
+    ASSERT_EQ(flag[3], 1);
+}
+
+TEST(ORBITAL_MANEUVERS, COE2RV_BATCH) {
+    /**
+     * Batch conversion of Keplerian elements to RV vectors agrees with COE2RV and inverts batch RV2COE
+     *
+     * @return RV vectors columns
+     */
+    double mu = 398600.4415;
+    COE<double> elem1{11067.790, 36127.343, 0.83285, 87.87 * M_PI / 180, 227.898 * M_PI / 180, 53.38 * M_PI / 180,
+                      92.335 * M_PI / 180, 10, 10, 10, mu, 4};
+    COE<double> elem2{8000 * (1 - 0.83 * 0.83), 8000, 0.83, 0, 10, 10, 211.7 * M_PI / 180, 10, 10, 327.12 * M_PI / 180,
+                      mu, 3};
+    COE<double> elem3{8000, 8000, 0, 60 * M_PI / 180, 30 * M_PI / 180, 10, 10, 280.5 * M_PI / 180, 10, 10, mu, 2};
+    COE<double> elem4{8000, 8000, 0, 0, 10, 10, 10, 10, 148.49 * M_PI / 180, 10, mu, 1};
+    std::vector<COE<double>> catalog{elem1, elem2, elem3, elem4};
+
+    std::size_t n = catalog.size();
+    std::vector<double> p(n), a(n), e(n), i(n), W(n), w(n), nu(n);
+    std::vector<int> flag(n);
+    COE_columns<double> elem{p, a, e, i, W, w, nu, flag};
+    for (std::size_t k = 0; k < n; k++) set_COE(elem, k, catalog[k]);
+
+    std::vector<double> x(n), y(n), z(n), vx(n), vy(n), vz(n);
+    COE2RV(COE_columns<const double>{p, a, e, i, W, w, nu, flag}, RV_columns<double>{x, y, z, vx, vy, vz}, mu);
+
+    std::vector<double> p2(n), a2(n), e2(n), i2(n), W2(n), w2(n), nu2(n);
+    std::vector<int> flag2(n);
+    RV2COE(RV_columns<const double>{x, y, z, vx, vy, vz}, COE_columns<double>{p2, a2, e2, i2, W2, w2, nu2, flag2}, mu);
+
+    for (std::size_t k = 0; k < n; k++) {
+        auto [r, v] = COE2RV(catalog[k]);
+        ASSERT_NEAR(x[k], r[0], 1e-8);
+        ASSERT_NEAR(y[k], r[1], 1e-8);
+        ASSERT_NEAR(z[k], r[2], 1e-8);
+        ASSERT_NEAR(vx[k], v[0], 1e-12);
+        ASSERT_NEAR(vy[k], v[1], 1e-12);
+        ASSERT_NEAR(vz[k], v[2], 1e-12);
+
+        ASSERT_EQ(flag2[k], flag[k]);
+        ASSERT_NEAR(p2[k], p[k], 1e-6);
+        ASSERT_NEAR(i2[k], i[k], 1e-9);
+        ASSERT_NEAR(W2[k], W[k], 1e-9);
+        ASSERT_NEAR(w2[k], w[k], 1e-9);
+        ASSERT_NEAR(nu2[k], nu[k], 1e-9);
+    }
+}
+
+TEST(ORBITAL_MANEUVERS, COE2RV_SIMD) {
+    /**
+     * SIMD kernels of batch COE2RV agree with the scalar reference path within a few ULP on a random population
+     *
+     * @return RV vectors columns
+     */
+    double mu = 398600.4415;
+    std::size_t n = 1003; // not a multiple of pack width, so the tail goes through the scalar path
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> radius(6600, 50000), ecc(0, 0.9), angle(0, 2 * M_PI), incl(0, M_PI);
+
+    std::vector<double> p(n), a(n), e(n), i(n), W(n), w(n), nu(n);
+    std::vector<int> flag(n, 4);
+    for (std::size_t k = 0; k < n; k++) {
+        e[k] = ecc(gen);
+        a[k] = radius(gen);
+        p[k] = a[k] * (1 - e[k] * e[k]);
+        i[k] = incl(gen);
+        W[k] = angle(gen);
+        w[k] = angle(gen);
+        nu[k] = angle(gen) + (k % 7) * 2 * M_PI; // several revolutions to check the range reduction
+    }
+    COE_columns<const double> elem{p, a, e, i, W, w, nu, flag};
+
+    std::vector<double> x(n), y(n), z(n), vx(n), vy(n), vz(n);
+    COE2RV(elem, RV_columns<double>{x, y, z, vx, vy, vz}, mu);
+
+    for (Simd_level level: {Simd_level::scalar, Simd_level::avx2, Simd_level::avx512}) {
+        if (level > supported_simd_level()) continue;
+        std::vector<double> sx(n), sy(n), sz(n), svx(n), svy(n), svz(n);
+        COE2RV_simd(elem, RV_columns<double>{sx, sy, sz, svx, svy, svz}, mu, level);
+        for (std::size_t k = 0; k < n; k++) {
+            double r_tol = 16 * std::numeric_limits<double>::epsilon() * norm(Vec3<double>{x[k], y[k], z[k]});
+            double v_tol = 16 * std::numeric_limits<double>::epsilon() * norm(Vec3<double>{vx[k], vy[k], vz[k]});
+            ASSERT_NEAR(sx[k], x[k], r_tol);
+            ASSERT_NEAR(sy[k], y[k], r_tol);
+            ASSERT_NEAR(sz[k], z[k], r_tol);
+            ASSERT_NEAR(svx[k], vx[k], v_tol);
+            ASSERT_NEAR(svy[k], vy[k], v_tol);
+            ASSERT_NEAR(svz[k], vz[k], v_tol);
+        }
+    }
+}
+
+TEST(ORBITAL_MANEUVERS, RV2COE_ROBUST) {
+    /**
+     * RV2COE_robust agrees with RV2COE on well-defined orbits, keeps precision of small angles, gives elements,
+     * that COE2RV converts back to the same RV vectors, for circular, equatorial and retrograde orbits,
+     * batch version agrees with the scalar one
+     *
+     * @param random orbits with e and i from exact zero to well-defined, retrograde ones
+     * @return Keplerian elements
+     */
+    const double mu = 398600.4415;
+    std::mt19937 gen(19);
+    std::uniform_real_distribution<double> radius(6600, 50000), angle(0, 2 * M_PI), unit(0, 1);
+    const std::vector<double> small{0, 1e-12, 1e-9, 1e-6, 1e-3, 0.05, 0.3};
+    std::vector<std::pair<Vec3<double>, Vec3<double>>> states;
+    for (int k = 0; k < 700; k++) {
+        COE<double> elem{};
+        elem.e = small[k % 7] * (k % 2 ? 1 : 0.7);
+        elem.a = radius(gen);
+        elem.p = elem.a * (1 - elem.e * elem.e);
+        elem.i = small[(k / 7) % 7] * 3;
+        if (k % 3 == 0) elem.i = M_PI - elem.i;
+        elem.W = angle(gen);
+        elem.w = angle(gen);
+        elem.nu = angle(gen);
+        elem.mu = mu;
+        elem.flag = 4;
+        states.push_back(COE2RV(elem));
+    }
+
+    for (auto &[r, v]: states) {
+        COE<double> robust = RV2COE_robust(r, v, mu);
+        auto [r1, v1] = COE2RV(robust);
+        double precision = robust.flag == 4 ? 1e-12 : 4e-8; // e or sin(i) below tol are dropped
+        for (int c = 0; c < 3; c++) {
+            ASSERT_NEAR(r1[c], r[c], precision * norm(r));
+            ASSERT_NEAR(v1[c], v[c], precision * norm(v));
+        }
+        COE<double> check = RV2COE(r, v, mu);
+        if (check.flag == 4 && robust.e > 0.1 && std::sin(robust.i) > 0.1) {
+            ASSERT_EQ(robust.flag, 4);
+            ASSERT_NEAR(robust.i, check.i, 1e-12);
+            ASSERT_NEAR(robust.W, check.W, 1e-12);
+            ASSERT_NEAR(robust.w, check.w, 1e-10);
+            ASSERT_NEAR(robust.nu, check.nu, 1e-10);
+        }
+    }
+
+    COE<double> tilted{8000 * (1 - 0.2 * 0.2), 8000, 0.2, 1e-7, 1.0, 2.0, 1e-8, 10, 10, 10, mu, 4};
+    auto [r, v] = COE2RV(tilted);
+    COE<double> robust = RV2COE_robust(r, v, mu);
+    ASSERT_EQ(robust.flag, 4);
+    ASSERT_NEAR(robust.i, 1e-7, 1e-20);
+    ASSERT_NEAR(robust.W, 1.0, 1e-8);
+    ASSERT_NEAR(detail::wrap_angle(robust.nu + 1), 1 + 1e-8, 1e-14);
+
+    std::size_t n = states.size();
+    std::vector<double> x(n), y(n), z(n), vx(n), vy(n), vz(n);
+    for (std::size_t k = 0; k < n; k++) {
+        auto &[r_, v_] = states[k];
+        x[k] = r_[0], y[k] = r_[1], z[k] = r_[2], vx[k] = v_[0], vy[k] = v_[1], vz[k] = v_[2];
+    }
+    std::vector<double> p(n), a(n), e(n), i(n), W(n), w(n), nu(n);
+    std::vector<int> flag(n);
+    COE_columns<double> elem{p, a, e, i, W, w, nu, flag};
+    RV2COE_robust(RV_columns<const double>{x, y, z, vx, vy, vz}, elem, mu);
+    for (std::size_t k = 0; k < n; k++) {
+        COE<double> check = RV2COE_robust(states[k].first, states[k].second, mu);
+        COE<double> batch = get_COE(elem, k, mu);
+        ASSERT_EQ(batch.flag, check.flag);
+        ASSERT_EQ(batch.e, check.e);
+        ASSERT_EQ(batch.i, check.i);
+        if (check.flag == 1) { ASSERT_NEAR(batch.lam_true, check.lam_true, 1e-14); }
+        if (check.flag == 2) { ASSERT_NEAR(batch.u, check.u, 1e-14); }
+        if (check.flag == 3) { ASSERT_NEAR(batch.w_true, check.w_true, 1e-14); }
+        if (check.flag == 4) { ASSERT_NEAR(batch.w, check.w, 1e-14); }
+        if (check.flag >= 3) { ASSERT_NEAR(batch.nu, check.nu, 1e-14); }
+    }
+    ASSERT_NE(std::count(flag.begin(), flag.end(), 1), 0);
+    ASSERT_NE(std::count(flag.begin(), flag.end(), 2), 0);
+    ASSERT_NE(std::count(flag.begin(), flag.end(), 3), 0);
+}
+
+/// Equinoctial elements ///
+TEST(ORBITAL_MANEUVERS, EQUINOCTIAL) {
+    /**
+     * Modified equinoctial elements convert to the same RV vectors as Keplerian elements of every type of orbit,
+     * including retrograde ones, RV2EQ and EQ2RV are inverse, batch versions agree with scalar ones
+     *
+     * @param Keplerian elements of every type of orbit, retrograde orbits, random RV vectors
+     * @return modified equinoctial elements, RV vectors
+     */
+    double mu = 398600.4415;
+    COE<double> elem1{11067.790, 36127.343, 0.83285, 87.87 * M_PI / 180, 227.898 * M_PI / 180, 53.38 * M_PI / 180,
+                      92.335 * M_PI / 180, 10, 10, 10, mu, 4};
+    COE<double> elem2{8000 * (1 - 0.83 * 0.83), 8000, 0.83, 0, 10, 10, 211.7 * M_PI / 180, 10, 10, 327.12 * M_PI / 180,
+                      mu, 3};
+    COE<double> elem3{8000, 8000, 0, 60 * M_PI / 180, 30 * M_PI / 180, 10, 10, 280.5 * M_PI / 180, 10, 10, mu, 2};
+    COE<double> elem4{8000, 8000, 0, 0, 10, 10, 10, 10, 148.49 * M_PI / 180, 10, mu, 1};
+    COE<double> elem5 = elem1, elem6 = elem2;
+    elem5.i = 170 * M_PI / 180;
+    elem6.i = M_PI;
+
+    Equinoctial<double> eq1 = COE2EQ(elem1);
+    ASSERT_EQ(eq1.I, 1);
+    ASSERT_NEAR(eq1.f, elem1.e * std::cos(elem1.w + elem1.W), 1e-12);
+    ASSERT_NEAR(eq1.g, elem1.e * std::sin(elem1.w + elem1.W), 1e-12);
+    ASSERT_NEAR(eq1.h, std::tan(elem1.i / 2) * std::cos(elem1.W), 1e-12);
+    ASSERT_NEAR(eq1.k, std::tan(elem1.i / 2) * std::sin(elem1.W), 1e-12);
+    ASSERT_EQ(COE2EQ(elem5).I, -1);
+
+    for (const COE<double> &elem: {elem1, elem2, elem3, elem4, elem5, elem6}) {
+        auto [r, v] = COE2RV(elem);
+        Equinoctial<double> eq = COE2EQ(elem);
+        auto [r1, v1] = EQ2RV(eq);
+        Equinoctial<double> eq2 = RV2EQ(r, v, mu);
+        ASSERT_EQ(eq2.I, eq.I);
+        for (double Equinoctial<double>::*field: {&Equinoctial<double>::p, &Equinoctial<double>::f,
+                                                  &Equinoctial<double>::g, &Equinoctial<double>::h,
+                                                  &Equinoctial<double>::k, &Equinoctial<double>::L})
+            ASSERT_NEAR(eq2.*field, eq.*field, 1e-9 * std::max(1.0, std::abs(eq.*field)));
+        for (int c = 0; c < 3; c++) {
+            ASSERT_NEAR(r1[c], r[c], 1e-9 * norm(r));
+            ASSERT_NEAR(v1[c], v[c], 1e-9 * norm(v));
+        }
+        COE<double> back = EQ2COE(eq);
+        ASSERT_EQ(back.flag, elem.flag);
+        ASSERT_NEAR(back.e, elem.e, 1e-12);
+        ASSERT_NEAR(back.i, elem.i, 1e-12);
+    }
+
+    std::mt19937 gen(20);
+    std::uniform_real_distribution<double> coordinate(-40000, 40000), speed(-7, 7);
+    std::size_t n = 301;
+    std::vector<double> x(n), y(n), z(n), vx(n), vy(n), vz(n);
+    for (std::size_t m = 0; m < n; m++) {
+        x[m] = coordinate(gen), y[m] = coordinate(gen), z[m] = m % 5 ? coordinate(gen) : 0;
+        vx[m] = speed(gen), vy[m] = speed(gen), vz[m] = m % 5 ? speed(gen) : 0;
+    }
+    std::vector<double> p(n), f(n), g(n), h(n), k(n), L(n);
+    std::vector<int> I(n);
+    RV2EQ(RV_columns<const double>{x, y, z, vx, vy, vz}, EQ_columns<double>{p, f, g, h, k, L, I}, mu);
+    std::vector<double> x1(n), y1(n), z1(n), vx1(n), vy1(n), vz1(n);
+    EQ2RV(EQ_columns<const double>{p, f, g, h, k, L, I}, RV_columns<double>{x1, y1, z1, vx1, vy1, vz1}, mu);
+    for (std::size_t m = 0; m < n; m++) {
+        Vec3<double> r{x[m], y[m], z[m]}, v{vx[m], vy[m], vz[m]};
+        Equinoctial<double> eq = RV2EQ(r, v, mu);
+        ASSERT_EQ(eq.p, p[m]);
+        ASSERT_EQ(eq.L, L[m]);
+        ASSERT_EQ(eq.I, I[m]);
+        ASSERT_NEAR(x1[m], x[m], 1e-10 * norm(r));
+        ASSERT_NEAR(z1[m], z[m], 1e-10 * norm(r));
+        ASSERT_NEAR(vy1[m], vy[m], 1e-10 * norm(v));
+        ASSERT_NEAR(vz1[m], vz[m], 1e-10 * norm(v));
+    }
+}
+
+/// Orbit kinds ///
+TEST(ORBITAL_MANEUVERS, ORBIT_KIND) {
+    /**
+     * Keplerian elements of known type keep only their elements and convert to the same RV vectors as the runtime
+     * structure, RV2COE finds the type, partitioned batch conversion keeps the original order
+     *
+     * @param Keplerian elements of every type of orbit
+     * @return RV vectors
+     */
+    static_assert(sizeof(COE<double, Orbit_kind::Circular_equatorial>) == 6 * sizeof(double));
+    static_assert(sizeof(COE<double, Orbit_kind::Elliptic_inclined>) == 8 * sizeof(double));
+    static_assert(sizeof(COE<double, Orbit_kind::Elliptic_inclined>) < sizeof(COE<double>));
+
+    double mu = 398600.4415;
+    COE<double> elem1{11067.790, 36127.343, 0.83285, 87.87 * M_PI / 180, 227.898 * M_PI / 180, 53.38 * M_PI / 180,
+                      92.335 * M_PI / 180, 10, 10, 10, mu, 4};
+    COE<double> elem2{8000 * (1 - 0.83 * 0.83), 8000, 0.83, 0, 10, 10, 211.7 * M_PI / 180, 10, 10, 327.12 * M_PI / 180,
+                      mu, 3};
+    COE<double> elem3{8000, 8000, 0, 60 * M_PI / 180, 30 * M_PI / 180, 10, 10, 280.5 * M_PI / 180, 10, 10, mu, 2};
+    COE<double> elem4{8000, 8000, 0, 0, 10, 10, 10, 10, 148.49 * M_PI / 180, 10, mu, 1};
+
+    std::vector<COE<double>> catalog;
+    for (int k = 0; k < 40; k++) {
+        COE<double> elem = std::vector<COE<double>>{elem1, elem2, elem3, elem4}[(k * 7) % 4];
+        elem.nu += 0.1 * k, elem.u += 0.1 * k, elem.lam_true += 0.1 * k;
+        catalog.push_back(elem);
+    }
+
+    std::size_t n = catalog.size();
+    std::vector<double> p(n), a(n), e(n), i(n), W(n), w(n), nu(n);
+    std::vector<int> flag(n);
+    COE_columns<double> columns{p, a, e, i, W, w, nu, flag};
+    for (std::size_t k = 0; k < n; k++) set_COE(columns, k, catalog[k]);
+    std::vector<double> x(n), y(n), z(n), vx(n), vy(n), vz(n);
+    COE2RV(COE_columns<const double>{p, a, e, i, W, w, nu, flag}, RV_columns<double>{x, y, z, vx, vy, vz}, mu);
+
+    for (std::size_t k = 0; k < n; k++) {
+        COE_variant<double> typed = to_typed(catalog[k]);
+        ASSERT_EQ(int(typed.index()) + 1, catalog[k].flag);
+        auto [r, v] = COE2RV(typed);
+        ASSERT_NEAR(norm(r - Vec3<double>{x[k], y[k], z[k]}), 0, 1e-8);
+        ASSERT_NEAR(norm(v - Vec3<double>{vx[k], vy[k], vz[k]}), 0, 1e-12);
+
+        COE<double> back = to_runtime(RV2COE_typed(r, v, mu));
+        ASSERT_EQ(back.flag, catalog[k].flag);
+        auto [r2, v2] = COE2RV(back);
+        ASSERT_NEAR(norm(r2 - r), 0, 1e-7);
+        ASSERT_NEAR(norm(v2 - v), 0, 1e-10);
+    }
+
+    auto [r1, v1] = COE2RV(elem1);
+    auto elliptic_inclined = RV2COE<Orbit_kind::Elliptic_inclined>(r1, v1, mu);
+    ASSERT_NEAR(elliptic_inclined.W, elem1.W, 1e-9);
+    ASSERT_NEAR(elliptic_inclined.w, elem1.w, 1e-9);
+    ASSERT_NEAR(elliptic_inclined.nu, elem1.nu, 1e-9);
+
+    COE_partition<double> partition = Partition_by_kind(catalog);
+    ASSERT_EQ(partition.size(), n);
+    ASSERT_EQ(partition.elliptic_inclined.size(), 10);
+    std::vector<double> px(n), py(n), pz(n), pvx(n), pvy(n), pvz(n);
+    COE2RV(partition, RV_columns<double>{px, py, pz, pvx, pvy, pvz});
+    for (std::size_t k = 0; k < n; k++) {
+        auto [r, v] = COE2RV(catalog[k]);
+        ASSERT_EQ(px[k], r[0]);
+        ASSERT_EQ(py[k], r[1]);
+        ASSERT_EQ(pz[k], r[2]);
+        ASSERT_EQ(pvx[k], v[0]);
+        ASSERT_EQ(pvy[k], v[1]);
+        ASSERT_EQ(pvz[k], v[2]);
+    }
+}
+
+/// Prepared orbits ///
+TEST(ORBITAL_MANEUVERS, PREPARED_ORBIT) {
+    /**
+     * Maneuvers on prepared orbits agree with maneuvers on Keplerian elements
+     *
+     * @param Keplerian elements
+     * @return delta-v
+     */
+    COE<double> elem1;
+    elem1.nu = 10 * M_PI / 180;
+    elem1.e = 0.2;
+    elem1.p = 10320 * (1 - elem1.e);
+    elem1.a = 10320 / (1 + elem1.e);
+    elem1.i = 30 * M_PI / 180;
+    elem1.flag = 4;
+    elem1.w = 15 * M_PI / 180;
+    elem1.W = 45 * M_PI / 180;
+    elem1.mu = 398600.4415;
+
+    COE<double> elem2 = elem1;
+    elem2.nu = 50 * M_PI / 180;
+    elem2.p = 10320 * 18.98 * (1 - elem1.e);
+    elem2.a = 10320 * 18.98 / (1 + elem1.e);
+    elem2.i = 45 * M_PI / 180;
+    elem2.w = 30 * M_PI / 180;
+    elem2.W = 90 * M_PI / 180;
+
+    Prepared_orbit<double> initial(elem1), final(elem2);
+    double r_b = 2 * 10320 * 18.98;
+    ASSERT_NEAR(Hohmann_transfer(initial, final), Hohmann_transfer(elem1, elem2), 1e-12);
+    ASSERT_NEAR(Bi_elliptic_transfer_circular_orbits(initial, final, r_b),
+                Bi_elliptic_transfer_circular_orbits(elem1, elem2, r_b), 1e-12);
+    ASSERT_NEAR(Bi_elliptic_transfer_elliptic_orbits(initial, final, r_b),
+                Bi_elliptic_transfer_elliptic_orbits(elem1, elem2, r_b), 1e-12);
+    ASSERT_NEAR(Two_impulse_transfer_elliptic_orbits(initial, final),
+                Two_impulse_transfer_elliptic_orbits(elem1, elem2), 1e-12);
+    ASSERT_NEAR(Inclination_only_transfer(initial, final), Inclination_only_transfer(elem1, elem2), 1e-12);
+
+    auto [delta_v, r, v] = General_plane_change(initial, final);
+    auto [check_delta_v, check_r, check_v] = General_plane_change(elem1, elem2);
+    ASSERT_NEAR(delta_v, check_delta_v, 1e-12);
+    for (int j = 0; j < 3; j++) {
+        ASSERT_NEAR(r[j], check_r[j], 1e-8);
+        ASSERT_NEAR(v[j], check_v[j], 1e-12);
+    }
+}
+
+/// Bi-elliptic transfer optimization ///
+TEST(ORBITAL_MANEUVERS, OPTIMAL_BI_ELLIPTIC_TRANSFER_CIRCULAR_ORBITS) {
+    /**
+     * Optimal intermediate radius of bi-elliptic transfer for circular orbits is not worse than a dense sweep
+     *
+     * @param Keplerian elements, upper bound of apogee radius of transfer orbit
+     * @return Bi_elliptic_optimum
+     */
+    COE<double> elem1;
+    elem1.a = 191.3441 + 6378.137;
+    elem1.mu = 398600.4415;
+    COE<double> elem2 = elem1;
+    elem2.a = 376310 + 6378.137;
+    double r_b_max = 503873 + 6378.137;
+
+    Bi_elliptic_optimum<double> optimum = Optimal_bi_elliptic_transfer_circular_orbits(elem1, elem2, r_b_max);
+    ASSERT_TRUE(optimum.use_bi_elliptic);
+    ASSERT_NEAR(optimum.delta_v, 3.904057, 1e-6);
+    ASSERT_NEAR(optimum.direct_delta_v, Hohmann_transfer(elem1, elem2), 1e-12);
+    for (int k = 0; k <= 1000; k++) {
+        double r_b = elem2.a * std::pow(r_b_max / elem2.a, k / 1000.0);
+        ASSERT_GE(Bi_elliptic_transfer_circular_orbits(elem1, elem2, r_b), optimum.delta_v - 1e-12);
+    }
+
+    COE<double> elem3 = elem1;
+    elem3.a = 35781.34857 + 6378.137; // radii ratio is below threshold
+    optimum = Optimal_bi_elliptic_transfer_circular_orbits(elem1, elem3, 100 * elem3.a);
+    ASSERT_FALSE(optimum.use_bi_elliptic);
+    ASSERT_NEAR(optimum.delta_v, 3.935224, 1e-6);
+}
+
+TEST(ORBITAL_MANEUVERS, OPTIMAL_BI_ELLIPTIC_TRANSFER_ELLIPTIC_ORBITS) {
+    /**
+     * Optimal intermediate radius of bi-elliptic transfer for elliptic orbits, scalar and threaded batch search, pairs
+     * with different gravitational parameters
+     *
+     * @param Keplerian elements, upper bound of apogee radius of transfer orbit
+     * @return Bi_elliptic_optimum
+     */
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> radius(6600, 20000), ratio(1.5, 30), ecc(0, 0.6), angle(0, 2 * M_PI);
+    std::vector<Prepared_orbit<double>> initial, final;
+    for (int k = 0; k < 20; k++) {
+        COE<double> elem1;
+        elem1.e = ecc(gen);
+        elem1.a = radius(gen);
+        elem1.p = elem1.a * (1 - elem1.e * elem1.e);
+        elem1.i = 0;
+        elem1.w_true = angle(gen);
+        elem1.nu = angle(gen);
+        elem1.flag = 3;
+        elem1.mu = k % 2 ? 398600.4415 : 42828.37;
+        COE<double> elem2 = elem1;
+        elem2.e = ecc(gen);
+        elem2.a = elem1.a * ratio(gen);
+        elem2.p = elem2.a * (1 - elem2.e * elem2.e);
+        elem2.w_true = angle(gen);
+        elem2.nu = angle(gen);
+        initial.emplace_back(elem1);
+        final.emplace_back(elem2);
+    }
+    double r_a_max = 2e6;
+    std::vector<Bi_elliptic_optimum<double>> batch = Optimal_bi_elliptic_transfer_elliptic_orbits(initial, final,
+                                                                                                 r_a_max);
+    for (std::size_t k = 0; k < initial.size(); k++) {
+        Bi_elliptic_optimum<double> optimum = Optimal_bi_elliptic_transfer_elliptic_orbits(initial[k], final[k],
+                                                                                          r_a_max);
+        double r_low = std::max(initial[k].r_norm, final[k].r_norm);
+        double sweep = std::numeric_limits<double>::max();
+        for (int j = 0; j <= 2000; j++)
+            sweep = std::min(sweep, Bi_elliptic_burns(initial[k], final[k],
+                                                      r_low * std::pow(r_a_max / r_low, j / 2000.0)));
+        ASSERT_LE(optimum.delta_v, sweep + 1e-9);
+        ASSERT_LE(batch[k].delta_v, sweep + 1e-9);
+        ASSERT_NEAR(batch[k].delta_v, optimum.delta_v, 1e-9);
+        ASSERT_NEAR(optimum.delta_v, Bi_elliptic_burns(initial[k], final[k], optimum.r_b), 1e-12);
+        ASSERT_NEAR(optimum.direct_delta_v, Two_impulse_burns(initial[k], final[k]), 1e-12);
+        ASSERT_GE(optimum.direct_delta_v, 0);
+        ASSERT_EQ(optimum.use_bi_elliptic, optimum.delta_v < optimum.direct_delta_v);
+    }
+}
+
+/// Lambert's problem ///
+TEST(ORBITAL_MANEUVERS, LAMBERT) {
+    /**
+     * Example 5.2 from Curtis, Orbital mechanics for engineering students,
+     * and arcs of a circular orbit with zero, one revolution and retrograde motion
+     *
+     * @param R vectors of two points, time of flight
+     * @return V vectors at the points
+     */
+    double mu = 398600;
+    Vec3<double> r1(5000, 10000, 2100), r2(-14600, 2500, 7000);
+    auto solution = Lambert(r1, r2, 3600.0, mu);
+    ASSERT_TRUE(solution.converged);
+    Vec3<double> v1_expected(-5.9925, 1.9254, 3.2456), v2_expected(-3.3125, -4.1966, -0.38529);
+    for (int j = 0; j < 3; j++) {
+        ASSERT_NEAR(solution.v1[j], v1_expected[j], 1e-3);
+        ASSERT_NEAR(solution.v2[j], v2_expected[j], 1e-3);
+    }
+
+    double radius = 7000, n = std::sqrt(mu / (radius * radius * radius)), theta = 1;
+    Vec3<double> a(radius, 0, 0), b(radius * cos(theta), radius * sin(theta), 0);
+    Vec3<double> v_a(0, n * radius, 0), v_b(-n * radius * sin(theta), n * radius * cos(theta), 0);
+
+    solution = Lambert(a, b, theta / n, mu);
+    ASSERT_TRUE(solution.converged);
+    ASSERT_NEAR(norm(solution.v1 - v_a), 0, 1e-9);
+    ASSERT_NEAR(norm(solution.v2 - v_b), 0, 1e-9);
+
+    solution = Lambert(a, b, (2 * M_PI - theta) / n, mu, 0, false);
+    ASSERT_TRUE(solution.converged);
+    ASSERT_NEAR(norm(solution.v1 + v_a), 0, 1e-9);
+    ASSERT_NEAR(norm(solution.v2 + v_b), 0, 1e-9);
+
+    auto low = Lambert(a, b, (theta + 2 * M_PI) / n, mu, 1, true, true);
+    auto high = Lambert(a, b, (theta + 2 * M_PI) / n, mu, 1, true, false);
+    ASSERT_TRUE(low.converged && high.converged);
+    ASSERT_NEAR(std::min(norm(low.v1 - v_a), norm(high.v1 - v_a)), 0, 1e-9);
+
+    ASSERT_FALSE(Lambert(a, b, theta / n, mu, 1).converged);
+}
+
+TEST(ORBITAL_MANEUVERS, PORKCHOP) {
+    /**
+     * Porkchop plot between circular coplanar orbits: warm-started grid agrees with cold-started solutions,
+     * minimum of total delta-v is close to Hohmann transfer and not below it
+     *
+     * @param ephemerides of two circular orbits, grid of departure times and times of flight
+     * @return delta-v of the grid
+     */
+    double mu = 398600.4415, radius1 = 7000, radius2 = 12000;
+    double n1 = std::sqrt(mu / (radius1 * radius1 * radius1)), n2 = std::sqrt(mu / (radius2 * radius2 * radius2));
+    auto circular = [](double radius, double n) {
+        return [=](double t) {
+            return std::pair(Vec3<double>(radius * cos(n * t), radius * sin(n * t), 0),
+                             Vec3<double>(-n * radius * sin(n * t), n * radius * cos(n * t), 0));
+        };
+    };
+    auto departure_ephemeris = circular(radius1, n1), arrival_ephemeris = circular(radius2, n2);
+
+    double synodic = 2 * M_PI / (n1 - n2), a_trans = (radius1 + radius2) / 2;
+    double hohmann_tof = M_PI * std::sqrt(a_trans * a_trans * a_trans / mu);
+    std::vector<double> departure(64), tof(96);
+    for (std::size_t i = 0; i < departure.size(); i++) departure[i] = synodic * i / departure.size();
+    for (std::size_t j = 0; j < tof.size(); j++) tof[j] = hohmann_tof * (0.5 + j / 95.0);
+
+    Porkchop_options options;
+    options.n_threads = 4;
+    auto grid = Porkchop(departure_ephemeris, arrival_ephemeris, departure, tof, mu, options);
+    ASSERT_EQ(grid.size(), departure.size() * tof.size());
+
+    double best = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < departure.size(); i++) {
+        for (std::size_t j = 0; j < tof.size(); j++) {
+            const auto &cell = grid[i * tof.size() + j];
+            auto [r1, v_dep] = departure_ephemeris(departure[i]);
+            auto [r2, v_arr] = arrival_ephemeris(departure[i] + tof[j]);
+            auto cold = Lambert(r1, r2, tof[j], mu);
+            if (!cold.converged) {
+                ASSERT_TRUE(std::isnan(cell.delta_v1));
+                continue;
+            }
+            ASSERT_NEAR(cell.delta_v1, norm(cold.v1 - v_dep), 1e-7);
+            ASSERT_NEAR(cell.delta_v2, norm(v_arr - cold.v2), 1e-7);
+            best = std::min(best, cell.delta_v1 + cell.delta_v2);
+        }
+    }
+
+    COE<double> initial{radius1, radius1, 0, 0, 0, 0, 0, 0, 0, 0, mu, 1};
+    COE<double> final{radius2, radius2, 0, 0, 0, 0, 0, 0, 0, 0, mu, 1};
+    double hohmann = Hohmann_transfer(initial, final);
+    ASSERT_GE(best, hohmann - 1e-9);
+    ASSERT_LE(best, 1.05 * hohmann);
+}
+
+/// Kepler propagation ///
+TEST(ORBITAL_MANEUVERS, KEPLER_EQUATION) {
+    /**
+     * Solutions of Kepler's equation for elliptic, hyperbolic and parabolic orbits
+     *
+     * @param mean anomaly, eccentricity
+     * @return eccentric, hyperbolic and true anomalies
+     */
+    for (double e = 0; e < 0.9995; e += 0.003) {
+        for (double M = -10; M <= 10; M += 0.01) {
+            double E = Eccentric_anomaly(M, e);
+            ASSERT_NEAR(E - e * sin(E), M, 1e-13 * std::max(1.0, std::abs(M)));
+        }
+    }
+    for (double e: {1.0001, 1.01, 1.5, 3.0, 30.0}) {
+        for (double M = -100; M <= 100; M += 0.37) {
+            double H = Hyperbolic_anomaly(M, e);
+            ASSERT_NEAR(e * sinh(H) - H, M, 1e-12 * std::max(1.0, std::abs(M)));
+        }
+    }
+    for (double e: {0.0, 0.3, 0.95, 1.0, 1.2, 4.0}) {
+        for (double nu = -2.5; nu <= 2.5; nu += 0.05) {
+            if (1 + e * cos(nu) <= 0.1) continue; // beyond asymptotes of hyperbola
+            double expected = e < 1 && nu < 0 ? nu + 2 * M_PI : nu;
+            ASSERT_NEAR(True_anomaly(Mean_anomaly(nu, e), e), expected, 1e-10);
+        }
+    }
+}
+
+TEST(ORBITAL_MANEUVERS, KEPLER_PROPAGATION) {
+    /**
+     * Propagated RV vectors are connected with the initial ones by Lambert's problem with the same time of flight,
+     * full period returns the orbit to the initial point
+     *
+     * @param Keplerian elements, time step
+     * @return Keplerian elements after time step
+     */
+    double mu = 398600.4415;
+    double a = 20000, e = 0.5;
+    COE<double> elliptic{a * (1 - e * e), a, e, 0.9, 1.2, 2.1, 0.4, 10, 10, 10, mu, 4};
+    COE<double> hyperbolic{25000, -20000, 1.5, 0.5, 0.3, 1.0, 0.3, 10, 10, 10, mu, 4};
+    COE<double> circular{9000, 9000, 0, 1.1, 0.7, 10, 10, 2.5, 10, 10, mu, 2};
+    double period = 2 * M_PI * std::sqrt(a * a * a / mu);
+
+    for (auto [elem, dt]: {std::pair(elliptic, 0.4 * period), std::pair(hyperbolic, 3000.0),
+                           std::pair(circular, 1500.0)}) {
+        auto [r1, v1] = COE2RV(elem);
+        auto [r2, v2] = COE2RV(Kepler_propagation(elem, dt));
+        auto solution = Lambert(r1, r2, dt, mu);
+        ASSERT_TRUE(solution.converged);
+        ASSERT_NEAR(norm(solution.v1 - v1), 0, 1e-8 * norm(v1));
+        ASSERT_NEAR(norm(solution.v2 - v2), 0, 1e-8 * norm(v2));
+    }
+
+    COE<double> back = Kepler_propagation(elliptic, 3 * period);
+    ASSERT_NEAR(back.nu, elliptic.nu, 1e-10);
+}
+
+TEST(ORBITAL_MANEUVERS, KEPLER_PROPAGATION_BATCH) {
+    /**
+     * Batch propagation of many orbits to many epochs agrees with one by one propagation for every instruction set,
+     * columns of an epoch go to batch COE2RV
+     *
+     * @param Keplerian elements columns, time steps
+     * @return true anomalies, RV vectors columns
+     */
+    double mu = 398600.4415;
+    std::size_t n = 501;
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> radius(6600, 50000), ecc(0, 0.99), angle(0, 2 * M_PI), incl(0, M_PI);
+
+    std::vector<double> p(n), a(n), e(n), i(n), W(n), w(n), nu(n);
+    std::vector<int> flag(n, 4);
+    for (std::size_t k = 0; k < n; k++) {
+        e[k] = k % 50 == 0 ? 1.3 : ecc(gen); // some hyperbolic orbits in between
+        a[k] = e[k] < 1 ? radius(gen) : -radius(gen);
+        p[k] = a[k] * (1 - e[k] * e[k]);
+        i[k] = incl(gen);
+        W[k] = angle(gen);
+        w[k] = angle(gen);
+        nu[k] = e[k] < 1 ? angle(gen) : 0.5;
+    }
+    COE_columns<const double> elem{p, a, e, i, W, w, nu, flag};
+    std::vector<double> dt{0, 60, 3600, 86400, 1e6};
+
+    for (Simd_level level: {Simd_level::scalar, Simd_level::avx2, Simd_level::avx512}) {
+        if (level > supported_simd_level()) continue;
+        std::vector<double> propagated(n * dt.size());
+        Kepler_propagation(elem, dt, propagated, mu, level);
+
+        for (std::size_t j = 0; j < dt.size(); j++) {
+            std::vector<double> x(n), y(n), z(n), vx(n), vy(n), vz(n);
+            COE2RV(Epoch_columns(elem, propagated, j), RV_columns<double>{x, y, z, vx, vy, vz}, mu);
+            for (std::size_t k = 0; k < n; k++) {
+                COE<double> expected = Kepler_propagation(get_COE(elem, k, mu), dt[j]);
+                auto [r, v] = COE2RV(expected);
+                ASSERT_NEAR(std::remainder(propagated[j * n + k] - expected.nu, 2 * M_PI), 0, 1e-9);
+                ASSERT_NEAR(norm(Vec3<double>{x[k], y[k], z[k]} - r), 0, 1e-9 * norm(r));
+                ASSERT_NEAR(norm(Vec3<double>{vx[k], vy[k], vz[k]} - v), 0, 1e-9 * norm(v));
+            }
+        }
+    }
+}
+
+/// Numerical propagation ///
+TEST(ORBITAL_MANEUVERS, NUMERICAL_PROPAGATION) {
+    /**
+     * Without J2 and drag numerical propagation agrees with Kepler propagation forwards and backwards, with J2 energy
+     * is conserved and node drifts with secular rate, drag lowers the orbit, exhausted max_steps is reported
+     *
+     * @param RV vectors, time step, force model, integrator parameters
+     * @return Numerical_solution
+     */
+    double mu = 398600.4415;
+    Force_model<double> two_body{.J2 = 0};
+    double a = 20000, e = 0.5;
+    COE<double> elliptic{a * (1 - e * e), a, e, 0.9, 1.2, 2.1, 0.4, 10, 10, 10, mu, 4};
+    COE<double> hyperbolic{25000, -20000, 1.5, 0.5, 0.3, 1.0, 0.3, 10, 10, 10, mu, 4};
+    for (auto [elem, dt]: {std::pair(elliptic, 30000.0), std::pair(hyperbolic, 3000.0), std::pair(elliptic, -7000.0)}) {
+        auto [r0, v0] = COE2RV(elem);
+        auto [r, v] = COE2RV(Kepler_propagation(elem, dt));
+        auto solution = Numerical_propagation(r0, v0, dt, two_body);
+        ASSERT_TRUE(solution.converged);
+        ASSERT_NEAR(norm(solution.r - r), 0, 1e-7 * norm(r));
+        ASSERT_NEAR(norm(solution.v - v), 0, 1e-7 * norm(v));
+
+        auto back = Numerical_propagation(solution.r, solution.v, -dt, two_body);
+        ASSERT_NEAR(norm(back.r - r0), 0, 1e-7 * norm(r0));
+    }
+
+    Force_model<double> earth;
+    double i = 0.9;
+    COE<double> leo{7000, 7000, 0, i, 1.0, 0, 0.3, 10, 10, 10, mu, 4};
+    auto [r0, v0] = COE2RV(leo);
+    double days = 86400;
+    auto solution = Numerical_propagation(r0, v0, days, earth);
+    ASSERT_TRUE(solution.converged);
+    auto energy = [&](const Vec3<double> &r, const Vec3<double> &v) { // with J2 potential
+        double r_ = norm(r), sin2 = r[2] * r[2] / (r_ * r_);
+        return scalar(v, v) / 2 - mu / r_ * (1 - earth.J2 * (earth.R / r_) * (earth.R / r_) * (1.5 * sin2 - 0.5));
+    };
+    ASSERT_NEAR(energy(solution.r, solution.v), energy(r0, v0), 1e-9 * std::abs(energy(r0, v0)));
+    double W_rate = -1.5 * std::sqrt(mu / (7000.0 * 7000 * 7000)) * earth.J2 * (earth.R / 7000) * (earth.R / 7000) *
+                    std::cos(i);
+    Vec3<double> h = cross_product(solution.r, solution.v);
+    double W = std::atan2(h[0], -h[1]);
+    ASSERT_NEAR(std::remainder(W - leo.W - W_rate * days, 2 * M_PI), 0, 0.03 * std::abs(W_rate * days));
+
+    Force_model<double> drag{.drag = 0.02};
+    auto low = Numerical_propagation(r0, v0, 6000.0, drag);
+    auto high = Numerical_propagation(r0, v0, 6000.0, earth);
+    ASSERT_LT(RV2COE(low.r, low.v, mu).a, RV2COE(high.r, high.v, mu).a);
+
+    auto failed = Numerical_propagation(r0, v0, days, earth, Integrator_options<double>{.max_steps = 10});
+    ASSERT_FALSE(failed.converged);
+    ASSERT_EQ(failed.steps + failed.rejected, 10);
+}
+
+TEST(ORBITAL_MANEUVERS, NUMERICAL_PROPAGATION_BATCH) {
+    /**
+     * Batch propagation of LEO and GEO orbits in lockstep agrees with one by one propagation for every instruction
+     * set, orbits, that did not converge, are NaN
+     *
+     * @param RV vectors columns, time step, force model
+     * @return RV vectors columns, Propagation_statistics
+     */
+    double mu = 398600.4415;
+    std::size_t n = 37;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> ecc(0, 0.1), angle(0, 2 * M_PI), incl(0, M_PI);
+    std::vector<double> x0(n), y0(n), z0(n), vx0(n), vy0(n), vz0(n);
+    for (std::size_t k = 0; k < n; k++) {
+        double a = k % 3 == 0 ? 42164 : 6900 + 10 * k, e = ecc(gen);
+        COE<double> elem{a * (1 - e * e), a, e, incl(gen), angle(gen), angle(gen), angle(gen), 10, 10, 10, mu, 4};
+        auto [r, v] = COE2RV(elem);
+        x0[k] = r[0], y0[k] = r[1], z0[k] = r[2], vx0[k] = v[0], vy0[k] = v[1], vz0[k] = v[2];
+    }
+    RV_columns<const double> rv0{x0, y0, z0, vx0, vy0, vz0};
+    Force_model<double> model{.drag = 0.01};
+    double dt = 5000;
+
+    for (Simd_level level: {Simd_level::scalar, Simd_level::avx2, Simd_level::avx512}) {
+        if (level > supported_simd_level()) continue;
+        std::vector<double> x(n), y(n), z(n), vx(n), vy(n), vz(n);
+        auto statistics = Numerical_propagation(rv0, dt, RV_columns<double>{x, y, z, vx, vy, vz}, model, {}, level);
+        ASSERT_EQ(statistics.failed, 0);
+        for (std::size_t k = 0; k < n; k++) {
+            auto expected = Numerical_propagation(Vec3<double>{x0[k], y0[k], z0[k]},
+                                                  Vec3<double>{vx0[k], vy0[k], vz0[k]}, dt, model);
+            ASSERT_NEAR(norm(Vec3<double>{x[k], y[k], z[k]} - expected.r), 0, 1e-9 * norm(expected.r));
+            ASSERT_NEAR(norm(Vec3<double>{vx[k], vy[k], vz[k]} - expected.v), 0, 1e-9 * norm(expected.v));
+        }
+    }
+
+    std::vector<double> x(n), y(n), z(n), vx(n), vy(n), vz(n);
+    auto statistics = Numerical_propagation(rv0, dt, RV_columns<double>{x, y, z, vx, vy, vz}, model,
+                                            Integrator_options<double>{.max_steps = 20});
+    ASSERT_GT(statistics.failed, 0);
+    for (std::size_t k = 0; k < n; k++) ASSERT_EQ(std::isnan(x[k]), k % 3 != 0); // GEO needs fewer steps
+}
+
+/// Dense matrices ///
+TEST(ORBITAL_MANEUVERS, DENSE_MULTIPLY) {
+    /**
+     * Blocked matrix product agrees with the naive triple loop for sizes, that are not multiples of the blocks,
+     * for transposed views and alpha, beta of fused multiply-add, and does not allocate after the first call
+     *
+     * @param random matrices
+     * @return products
+     */
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> value(-1, 1);
+    auto random_matrix = [&](int h, int w) {
+        Dense<double> m{h, w};
+        for (int i = 0; i < h; i++) for (int j = 0; j < w; j++) m(i, j) = value(gen);
+        return m;
+    };
+
+    for (auto [m, k, n]: {std::tuple(1, 1, 1), std::tuple(3, 5, 2), std::tuple(17, 300, 29), std::tuple(131, 67, 2100)}) {
+        Dense<double> a = random_matrix(m, k), b = random_matrix(k, n), bt = b.Transpose(), c = random_matrix(m, n);
+        Dense<double> ab{m, n}, expected{m, n};
+        for (int i = 0; i < m; i++) {
+            for (int j = 0; j < n; j++) {
+                for (int p = 0; p < k; p++) ab(i, j) += a(i, p) * b(p, j);
+                expected(i, j) = 0.5 * ab(i, j) - 2 * c(i, j);
+            }
+        }
+
+        multiply_add(a, bt.transposed(), c, 0.5, -2.0);
+        Dense<double> product = a * b;
+        for (int i = 0; i < m; i++) {
+            for (int j = 0; j < n; j++) {
+                ASSERT_NEAR(c(i, j), expected(i, j), 1e-12 * k);
+                ASSERT_NEAR(product(i, j), ab(i, j), 1e-12 * k);
+            }
+        }
+    }
+
+    Dense<double> a = random_matrix(64, 64), b = random_matrix(64, 64), c{64, 64};
+    multiply_into(a, b, c);
+    std::size_t before = allocation_count();
+    multiply_into(a, b, c);
+    multiply_add(a.transposed(), b, c, 1.0, 1.0);
+    ASSERT_EQ(allocation_count() - before, 0);
+}
+
+TEST(ORBITAL_MANEUVERS, DENSE_FIXED_SIZE) {
+    /**
+     * Fixed-size matrices give the same results as dynamic ones and are accepted by multiply_add
+     *
+     * @param 6x6 and 6x3 matrices
+     * @return products, sums, transposition
+     */
+    Dense<double, 6, 6> a;
+    Dense<double, 6, 3> b;
+    Dense<double> a_dynamic{6, 6}, b_dynamic{6, 3};
+    for (int i = 0; i < 6; i++) {
+        for (int j = 0; j < 6; j++) a(i, j) = a_dynamic(i, j) = std::sin(i + 2.0 * j);
+        for (int j = 0; j < 3; j++) b(i, j) = b_dynamic(i, j) = std::cos(3.0 * i - j);
+    }
+    static_assert(sizeof(Dense<double, 6, 6>) == 36 * sizeof(double));
+
+    Dense<double, 6, 3> product = a * b;
+    Dense<double> product_dynamic = a_dynamic * b_dynamic;
+    Dense<double, 3, 6> product_t = product.Transpose();
+    Dense<double, 6, 6> sum = a + Dense<double, 6, 6>::identity() * 2.0 - a;
+    for (int i = 0; i < 6; i++) {
+        for (int j = 0; j < 3; j++) {
+            ASSERT_NEAR(product(i, j), product_dynamic(i, j), 1e-14);
+            ASSERT_EQ(product_t(j, i), product(i, j));
+        }
+        for (int j = 0; j < 6; j++) ASSERT_NEAR(sum(i, j), i == j ? 2 : 0, 1e-15);
+    }
+
+    Dense<double, 6, 6> covariance = Dense<double, 6, 6>::identity(), propagated;
+    Dense<double, 6, 6> tmp;
+    multiply_into(a, covariance, tmp);
+    multiply_into(tmp, a.transposed(), propagated);
+    Dense<double, 6, 6> expected = a * a.Transpose();
+    for (int i = 0; i < 6; i++) for (int j = 0; j < 6; j++) ASSERT_NEAR(propagated(i, j), expected(i, j), 1e-14);
+}
+
+/// QR decomposition ///
+TEST(ORBITAL_MANEUVERS, QR_LEAST_SQUARES) {
+    /**
+     * Blocked QR gives the same R as unblocked one, reflections agree with Dense::eval_norm_vec,
+     * residual of the least squares solution is orthogonal to the columns of the matrix
+     *
+     * @param random overdetermined system 300 x 70
+     * @return solution
+     */
+    std::mt19937 gen(12);
+    std::uniform_real_distribution<double> value(-1, 1);
+    int m = 300, n = 70;
+    Dense<double> a{m, n}, b{m, 2};
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++) a(i, j) = value(gen);
+        for (int j = 0; j < 2; j++) b(i, j) = value(gen);
+    }
+
+    QR_decomposition<double> blocked = QR_factorization(a, 16), unblocked = QR_factorization(a, 1);
+    for (int i = 0; i < n; i++) {
+        for (int j = i; j < n; j++) ASSERT_NEAR(blocked.qr(i, j), unblocked.qr(i, j), 1e-12);
+    }
+
+    Dense<double> v = a.get_column(0).eval_norm_vec(0);
+    for (int i = 1; i < m; i++) ASSERT_NEAR(blocked.qr(i, 0), v(i, 0) / v(0, 0), 1e-12);
+
+    Dense<double> x = Least_squares(blocked, b);
+    Dense<double> residual = a * x;
+    for (int i = 0; i < m; i++) for (int j = 0; j < 2; j++) residual(i, j) -= b(i, j);
+    Dense<double> normal = a.Transpose() * residual;
+    for (int i = 0; i < n; i++) for (int j = 0; j < 2; j++) ASSERT_NEAR(normal(i, j), 0, 1e-11);
+}
+
+TEST(ORBITAL_MANEUVERS, QR_SOLVE_AND_INVERSE) {
+    /**
+     * Square solve reproduces known solution, inverse of fixed-size 6x6 matrix gives identity
+     *
+     * @param random 100 x 100 system, 6x6 matrix
+     * @return solution, inverse
+     */
+    std::mt19937 gen(13);
+    std::uniform_real_distribution<double> value(-1, 1);
+    int n = 100;
+    Dense<double> a{n, n}, x_true{n, 1};
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) a(i, j) = value(gen);
+        x_true(i, 0) = value(gen);
+    }
+    Dense<double> x = Linear_solve(a, a * x_true);
+    for (int i = 0; i < n; i++) ASSERT_NEAR(x(i, 0), x_true(i, 0), 1e-10);
+
+    Dense<double, 6, 6> stm;
+    for (int i = 0; i < 6; i++) for (int j = 0; j < 6; j++) stm(i, j) = std::sin(i + 2.0 * j) + (i == j ? 3 : 0);
+    Dense<double, 6, 6> identity = stm * Inverse(stm);
+    for (int i = 0; i < 6; i++) for (int j = 0; j < 6; j++) ASSERT_NEAR(identity(i, j), i == j ? 1 : 0, 1e-14);
+}
+
+/// State transition matrix ///
+TEST(ORBITAL_MANEUVERS, STATE_TRANSITION_MATRIX) {
+    /**
+     * Propagated state agrees with Kepler_propagation, STM agrees with central differences of propagation
+     * for elliptic, hyperbolic and circular orbits, elements and RV versions agree, no heap allocations
+     *
+     * @param Keplerian elements, time step
+     * @return RV vectors after time step and STM
+     */
+    double mu = 398600.4415;
+    double a = 20000, e = 0.5;
+    COE<double> elliptic{a * (1 - e * e), a, e, 0.9, 1.2, 2.1, 0.4, 10, 10, 10, mu, 4};
+    COE<double> hyperbolic{25000, -20000, 1.5, 0.5, 0.3, 1.0, 0.3, 10, 10, 10, mu, 4};
+    COE<double> circular{9000, 9000, 0, 1.1, 0.7, 10, 10, 2.5, 10, 10, mu, 2};
+    double period = 2 * M_PI * std::sqrt(a * a * a / mu);
+
+    for (auto [elem, dt]: {std::pair(elliptic, 1.4 * period), std::pair(elliptic, -0.3 * period),
+                           std::pair(hyperbolic, 3000.0), std::pair(circular, 1500.0), std::pair(circular, 1e-3)}) {
+        auto [r0, v0] = COE2RV(elem);
+        auto [r_expected, v_expected] = COE2RV(Kepler_propagation(elem, dt));
+        STM_solution<double> solution = State_transition_matrix(elem, dt);
+        STM_solution<double> solution_rv = State_transition_matrix(r0, v0, dt, mu);
+        ASSERT_NEAR(norm(solution.r - r_expected), 0, 1e-9 * norm(r_expected));
+        ASSERT_NEAR(norm(solution.v - v_expected), 0, 1e-9 * norm(v_expected));
+        ASSERT_NEAR(norm(solution_rv.r - r_expected), 0, 1e-9 * norm(r_expected));
+
+        for (int j = 0; j < 6; j++) {
+            double h = j < 3 ? 1e-3 : 1e-6;
+            Vec3<double> r_plus = r0, v_plus = v0, r_minus = r0, v_minus = v0;
+            (j < 3 ? r_plus : v_plus)[j % 3] += h;
+            (j < 3 ? r_minus : v_minus)[j % 3] -= h;
+            STM_solution<double> plus = State_transition_matrix(r_plus, v_plus, dt, mu);
+            STM_solution<double> minus = State_transition_matrix(r_minus, v_minus, dt, mu);
+            for (int i = 0; i < 6; i++) {
+                double derivative = ((i < 3 ? plus.r : plus.v)[i % 3] - (i < 3 ? minus.r : minus.v)[i % 3]) / (2 * h);
+                double scale = std::abs(derivative) + (i < 3 ? 1 : 1e-3) * (j < 3 ? 1 : 1e3);
+                ASSERT_NEAR(solution.stm(i, j), derivative, 1e-5 * scale);
+                ASSERT_NEAR(solution_rv.stm(i, j), solution.stm(i, j), 1e-8 * scale);
+            }
+        }
+    }
+
+    std::size_t before = allocation_count();
+    STM_solution<double> solution = State_transition_matrix(elliptic, 1000.0);
+    ASSERT_EQ(allocation_count() - before, 0);
+    ASSERT_TRUE(std::isfinite(solution.stm(5, 5)));
+}
+
+TEST(ORBITAL_MANEUVERS, COVARIANCE_PROPAGATION) {
+    /**
+     * Batch covariance propagation agrees with STM P STM^T of Dense products
+     *
+     * @param STMs of elliptic orbit, diagonal covariance
+     * @return propagated covariance
+     */
+    double mu = 398600.4415;
+    COE<double> elem{15000, 20000, 0.5, 0.9, 1.2, 2.1, 0.4, 10, 10, 10, mu, 4};
+    std::vector<Dense<double, 6, 6>> stm, covariance(8), result(8);
+    for (int k = 0; k < 8; k++) {
+        stm.push_back(State_transition_matrix(elem, 700.0 * k).stm);
+        for (int i = 0; i < 6; i++) covariance[k](i, i) = i < 3 ? 1 + k : 1e-6;
+        covariance[k](0, 4) = covariance[k](4, 0) = 1e-4;
+    }
+    Covariance_propagation<double>(stm, covariance, result);
+    for (int k = 0; k < 8; k++) {
+        Dense<double, 6, 6> expected = stm[k] * covariance[k] * stm[k].Transpose();
+        for (int i = 0; i < 6; i++) {
+            for (int j = 0; j < 6; j++) ASSERT_NEAR(result[k](i, j), expected(i, j), 1e-12 * std::abs(expected(i, j)) + 1e-15);
+        }
+    }
+}
+
+/// Maneuver planner ///
+TEST(ORBITAL_MANEUVERS, MANEUVER_PLANNER) {
+    /**
+     * Planner picks Hohmann or bi-elliptic transfer for coplanar circular orbits, and the optimal split of plane
+     * change for LEO - GEO transfer, which is not worse than a dense sweep of the split
+     *
+     * @param Keplerian elements
+     * @return Transfer_plan
+     */
+    double mu = 398600.4415;
+    COE<double> leo{6678.137, 6678.137, 0, 28.5 * M_PI / 180, 0.3, 10, 10, 0, 10, 10, mu, 2};
+    COE<double> geo{42164.137, 42164.137, 0, 28.5 * M_PI / 180, 0.3, 10, 10, 0, 10, 10, mu, 2};
+    COE<double> far = geo;
+    far.a = far.p = 15 * leo.a;
+
+    Transfer_plan<double> plan = Plan_transfer(leo, geo);
+    ASSERT_GE(plan.delta_v, 0);
+    ASSERT_EQ(plan.strategy, Transfer_strategy::Hohmann);
+    ASSERT_NEAR(plan.delta_v, Hohmann_transfer(leo, geo), 1e-12);
+    plan = Plan_transfer(leo, far);
+    ASSERT_EQ(plan.strategy, Transfer_strategy::Bi_elliptic);
+    ASSERT_LT(plan.delta_v, Hohmann_transfer(leo, far));
+
+    geo.i = 0;
+    geo.flag = 1;
+    plan = Plan_transfer(leo, geo);
+    ASSERT_EQ(plan.strategy, Transfer_strategy::Combined_plane_change);
+    ASSERT_GT(plan.split, 0.01);
+    ASSERT_LT(plan.split, 0.2);
+    ASSERT_NEAR(plan.delta_v, 4.231, 1e-3);
+
+    double alpha = leo.i, a_trans = (leo.a + geo.a) / 2;
+    double v1 = std::sqrt(mu / leo.a), v2 = std::sqrt(mu / geo.a);
+    double vt1 = std::sqrt(2 * mu / leo.a - mu / a_trans), vt2 = std::sqrt(2 * mu / geo.a - mu / a_trans);
+    for (int k = 0; k <= 1000; k++) {
+        double s = k / 1000.0;
+        double delta_v = std::sqrt(v1 * v1 + vt1 * vt1 - 2 * v1 * vt1 * std::cos(s * alpha)) +
+                         std::sqrt(v2 * v2 + vt2 * vt2 - 2 * v2 * vt2 * std::cos((1 - s) * alpha));
+        ASSERT_GE(delta_v, plan.delta_v - 1e-9);
+    }
+}
+
+TEST(ORBITAL_MANEUVERS, MANEUVER_PLANNER_PRUNING) {
+    /**
+     * Pruning by lower bounds does not change the plans, and prunes some of the searches
+     *
+     * @param random coplanar elliptic and non-coplanar circular orbits
+     * @return Transfer_plan with and without pruning
+     */
+    std::mt19937 gen(14);
+    const Orbit_ranges ranges{.ecc_min = 0, .incl_min = 0, .incl_max = M_PI};
+    Planner_options<double> exhaustive;
+    exhaustive.prune = false;
+    Planner_statistics statistics;
+    for (int k = 0; k < 200; k++) {
+        COE<double> elem1 = random_elliptic_orbit(gen, ranges), elem2 = random_elliptic_orbit(gen, ranges);
+        for (COE<double> *elem: {&elem1, &elem2}) {
+            if (k % 2 == 0) { // elliptic equatorial
+                elem->i = elem->W = 0;
+                elem->flag = 3;
+            } else { // circular inclined
+                elem->e = 0;
+                elem->p = elem->a;
+                elem->flag = 2;
+            }
+        }
+        Transfer_plan<double> pruned = Plan_transfer(elem1, elem2, {}, &statistics);
+        Transfer_plan<double> full = Plan_transfer(elem1, elem2, exhaustive);
+        ASSERT_GE(pruned.delta_v, 0);
+        ASSERT_GE(full.delta_v, 0);
+        ASSERT_NEAR(pruned.delta_v, full.delta_v, 1e-9 * full.delta_v);
+    }
+    ASSERT_EQ(statistics.plans, 200);
+    ASSERT_GT(statistics.pruned, 0);
+    ASSERT_LE(statistics.pruned, statistics.searches);
+}
+
+/// Combined transfer ///
+TEST(ORBITAL_MANEUVERS, COMBINED_TRANSFER) {
+    /**
+     * Optimal split of plane change is not worse than a dense sweep of the split and both single-burn plane changes,
+     * LEO - GEO transfer agrees with the planner, batch variant agrees with the scalar one
+     *
+     * @param Keplerian elements, random elliptic inclined orbits
+     * @return Split_transfer
+     */
+    double mu = 398600.4415;
+    COE<double> leo{6678.137, 6678.137, 0, 28.5 * M_PI / 180, 0.3, 10, 10, 0, 10, 10, mu, 2};
+    COE<double> geo{42164.137, 42164.137, 0, 0, 0, 10, 10, 10, 0, 10, mu, 1};
+    Split_transfer<double> leo_geo = Combined_transfer(leo, geo);
+    ASSERT_NEAR(leo_geo.delta_v, Plan_transfer(leo, geo).delta_v, 1e-9);
+    ASSERT_NEAR(leo_geo.delta_v, leo_geo.delta_v1 + leo_geo.delta_v2, 1e-12);
+
+    std::mt19937 gen(15);
+    const Orbit_ranges ranges{.ecc_min = 0, .incl_min = 0, .incl_max = M_PI};
+    std::vector<Prepared_orbit<double>> initial, final;
+    for (int k = 0; k < 100; k++) {
+        for (auto *orbits: {&initial, &final}) orbits->emplace_back(random_elliptic_orbit(gen, ranges, mu));
+    }
+    std::vector<Split_transfer<double>> batch = Combined_transfer(initial, final);
+    for (std::size_t k = 0; k < initial.size(); k++) {
+        Split_transfer<double> res = Combined_transfer(initial[k], final[k]);
+        ASSERT_GE(res.split, 0);
+        ASSERT_LE(res.split, 1);
+        ASSERT_NEAR(batch[k].delta_v, res.delta_v, 1e-9 * res.delta_v);
+        auto [ascending, descending] = detail::Node_burns(initial[k], final[k]);
+        for (const auto &burns: {ascending, descending}) {
+            for (int j = 0; j <= 1000; j++) {
+                auto [delta_v1, delta_v2] = burns.delta_v(j / 1000.0);
+                ASSERT_GE(delta_v1 + delta_v2, res.delta_v - 1e-9);
+            }
+        }
+    }
+}
+
+/// Low-thrust transfers ///
+TEST(ORBITAL_MANEUVERS, LOW_THRUST) {
+    /**
+     * Edelbaum delta-v of coplanar transfer is the difference of circular velocities, of plane change on the same
+     * radius is v sqrt(2 - 2 cos(pi / 2 * alpha)), also for planes 1e-7 rad apart. Q-law transfers between circular orbits reach the target and cost
+     * close to Edelbaum delta-v, transfers of a batch are the same as one by one
+     *
+     * @param Keplerian elements of initial and final orbits, thruster
+     * @return delta-v, Low_thrust_transfer
+     */
+    double mu = 398600.4415;
+    auto circular = [&](double a, double i, double W) { return COE<double>{a, a, 0, i, W, 0, 0, 0, 0.3, 10, mu, 2}; };
+    ASSERT_NEAR(Edelbaum_transfer(circular(7000, 0.5, 1), circular(8000, 0.5, 1)),
+                std::sqrt(mu / 7000) - std::sqrt(mu / 8000), 1e-12);
+    ASSERT_NEAR(Edelbaum_transfer(circular(7000, M_PI / 2, 0), circular(7000, M_PI / 2, M_PI / 2)),
+                std::sqrt(mu / 7000) * std::sqrt(2 - 2 * std::cos(M_PI * M_PI / 4)), 1e-12);
+    Prepared_orbit<double> from(circular(7000, 0.5, 1)), to(circular(9000, 0.7, 2));
+    ASSERT_NEAR(Edelbaum_transfer(from, to), Edelbaum_transfer(from.elem, to.elem), 1e-12);
+    const double close = std::sqrt(mu / 7000) * 2 * std::sin(M_PI / 4 * 1e-7);
+    ASSERT_NEAR(Edelbaum_transfer(circular(7000, 0.5, 1), circular(7000, 0.5 + 1e-7, 1)), close, 1e-6 * close);
+    ASSERT_NEAR(Edelbaum_transfer(Prepared_orbit<double>(circular(7000, 0.5, 1)),
+                                  Prepared_orbit<double>(circular(7000, 0.5 + 1e-7, 1))), close, 1e-6 * close);
+
+    Thruster<double> thruster{.thrust = 1, .mass = 1000, .Isp = 3000};
+    std::vector<Low_thrust_scenario<double>> scenarios{
+            {circular(7000, 0.5, 1), circular(8000, 0.5, 1), thruster},
+            {circular(7000, 0.5, 1), circular(7500, 0.6, 1.1), thruster},
+            {circular(8000, 2.5, 1), circular(7000, 2.4, 1), thruster}, // retrograde
+            {circular(7000, 0.5, 1), circular(42164, 0.1, 1), thruster}};
+    Qlaw_options<double> options;
+    options.n_threads = 2;
+    auto transfers = Qlaw_transfer(scenarios, options);
+    for (std::size_t j = 0; j < scenarios.size(); j++) {
+        const auto &[initial, final, thruster_] = scenarios[j];
+        auto transfer = Qlaw_transfer(initial, final, thruster_, options);
+        ASSERT_TRUE(transfer.converged);
+        ASSERT_EQ(transfer.delta_v, transfers[j].delta_v);
+        ASSERT_NEAR(transfer.delta_v, Edelbaum_transfer(initial, final), 0.05 * Edelbaum_transfer(initial, final));
+        ASSERT_NEAR(transfer.time, (1 - std::exp(-transfer.delta_v * 1000 / (thruster.Isp * 9.80665))) *
+                                   thruster.mass / (thruster.thrust / (thruster.Isp * 9.80665)), 1e-6 * transfer.time);
+
+        COE<double> reached = EQ2COE(transfer.final);
+        ASSERT_NEAR(reached.a, final.a, 2e-3 * final.a);
+        ASSERT_NEAR(reached.e, 0, 2e-3);
+        ASSERT_NEAR(reached.i, final.i, 5e-3);
+    }
+
+    options.max_time = 86400;
+    ASSERT_FALSE(Qlaw_transfer(scenarios[3].initial, scenarios[3].final, thruster, options).converged);
+}
+
+/// Sequencing ///
+TEST(ORBITAL_MANEUVERS, SEQUENCING) {
+    /**
+     * Branch-and-bound finds the optimal order of a small set (checked by all permutations), large neighborhood
+     * search improves the greedy order, does not depend on the number of threads and finds the sorted order for
+     * costs |a_i - a_j|. Every leg at every epoch is evaluated once
+     *
+     * @param orbits, cost function, options
+     * @return Sequence
+     */
+    double mu = 398600.4415;
+    std::mt19937 gen(29);
+    std::uniform_real_distribution<double> radius(6900, 8000), angle(0, 2 * M_PI), incl(0.8, 1.0), ecc(0, 0.01);
+    auto random_orbits = [&](std::size_t n) {
+        std::vector<COE<double>> orbits;
+        for (std::size_t k = 0; k < n; k++) {
+            double a = radius(gen), e = ecc(gen);
+            orbits.push_back({a * (1 - e * e), a, e, incl(gen), angle(gen), angle(gen), angle(gen), 10, 10, 10, mu, 4});
+        }
+        return orbits;
+    };
+    Sequencing_options<double> options;
+    options.leg_time = 5 * 86400;
+    options.n_threads = 1;
+
+    auto small = random_orbits(8);
+    auto exact = Sequence_targets(small, options);
+    ASSERT_TRUE(exact.optimal);
+    Cost_oracle<double, COE<double>, Drifting_transfer_cost<double>> oracle(small, {}, options.leg_time,
+                                                                          options.epoch_bins);
+    std::vector<std::size_t> order{0, 1, 2, 3, 4, 5, 6, 7};
+    double best = std::numeric_limits<double>::infinity();
+    do best = std::min(best, oracle.cost(order)); while (std::next_permutation(order.begin() + 1, order.end()));
+    ASSERT_NEAR(exact.delta_v, best, 1e-12);
+
+    auto large = random_orbits(40);
+    Sequencing_options<double> greedy_options = options;
+    greedy_options.beam_width = 1;
+    greedy_options.rounds = 0;
+    auto greedy = Sequence_targets(large, greedy_options);
+    auto sequence = Sequence_targets(large, options);
+    options.n_threads = 3;
+    auto parallel = Sequence_targets(large, options);
+    ASSERT_LT(sequence.delta_v, greedy.delta_v);
+    ASSERT_EQ(sequence.order, parallel.order);
+    ASSERT_EQ(sequence.order[0], 0);
+    std::vector<std::size_t> sorted = sequence.order;
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t k = 0; k < sorted.size(); k++) ASSERT_EQ(sorted[k], k);
+    Cost_oracle<double, COE<double>, Drifting_transfer_cost<double>> check(large, {}, options.leg_time,
+                                                                         options.epoch_bins);
+    ASSERT_NEAR(sequence.delta_v, check.cost(sequence.order), 1e-12);
+    ASSERT_LE(sequence.statistics.evaluations, 40 * 40 * options.epoch_bins);
+    ASSERT_GT(sequence.statistics.hit_rate(), 0.9);
+
+    std::vector<double> a(60);
+    for (double &a_: a) a_ = radius(gen);
+    a[0] = 6800;
+    auto line = Sequence_targets(a, [](double from, double to, double) { return std::abs(to - from); }, options);
+    ASSERT_NEAR(line.delta_v, *std::max_element(a.begin(), a.end()) - a[0], 1e-9);
+}
+
+/// Cost matrix ///
+TEST(ORBITAL_MANEUVERS, TRANSFER_COST_MATRIX) {
+    /**
+     * Tiled parallel cost matrix agrees with the double loop, every pair is evaluated exactly once, two-impulse costs
+     * are not negative
+     *
+     * @param catalogs of Keplerian elements
+     * @return delta-v matrix
+     */
+    std::mt19937 gen(7);
+    auto random_catalog = [&](std::size_t n) {
+        std::vector<COE<double>> catalog(n);
+        for (auto &elem: catalog) elem = random_elliptic_orbit(gen);
+        return catalog;
+    };
+    std::vector<COE<double>> initial = random_catalog(37), final = random_catalog(53);
+
+    Cost_matrix_options options;
+    options.tile_rows = 8;
+    options.tile_cols = 16;
+    options.n_threads = 4;
+    std::vector<double> hohmann = Transfer_cost_matrix(initial, final, Maneuver::Hohmann, options);
+    std::vector<double> edelbaum = Transfer_cost_matrix(initial, final, Maneuver::Edelbaum, options);
+    std::vector<double> two_impulse = Transfer_cost_matrix(initial, final, Maneuver::Two_impulse, options);
+
+    std::vector<int> visits(initial.size() * final.size(), 0);
+    std::mutex visits_mutex;
+    Thread_pool pool(4);
+    Transfer_cost_matrix(initial, final, Maneuver::Two_impulse, [&](const Cost_tile<double> &tile) {
+        std::lock_guard lock(visits_mutex);
+        for (std::size_t r = 0; r < tile.rows; r++) {
+            for (std::size_t c = 0; c < tile.cols; c++) {
+                std::size_t row = tile.row_begin + r, col = tile.col_begin + c;
+                visits[row * final.size() + col]++;
+                const Prepared_orbit<double> from(initial[row]), to(final[col]);
+                ASSERT_NEAR(tile.cost[r * tile.cols + c], Two_impulse_burns(from, to), 1e-12);
+            }
+        }
+    }, pool, options);
+
+    for (std::size_t row = 0; row < initial.size(); row++) {
+        for (std::size_t col = 0; col < final.size(); col++) {
+            ASSERT_NEAR(hohmann[row * final.size() + col], Hohmann_transfer(initial[row], final[col]), 1e-12);
+            ASSERT_NEAR(edelbaum[row * final.size() + col], Edelbaum_transfer(initial[row], final[col]), 1e-9);
+            ASSERT_GE(two_impulse[row * final.size() + col], 0);
+            ASSERT_EQ(visits[row * final.size() + col], 1);
+        }
+    }
+}
+
+/// Catalog stream ///
+TEST(ORBITAL_MANEUVERS, CATALOG_STREAM) {
+    /**
+     * Streaming conversion of OEM file gives the same elements as batch RV2COE on the same RV vectors, in order of
+     * the file and across chunk boundaries, TLE gives the elements of the set, column files hold all records
+     *
+     * @param OEM file with header, comments and covariance, TLE file of ISS
+     * @return Keplerian elements columns
+     */
+    const double mu = 398600.4415;
+    const std::string dir = std::filesystem::temp_directory_path().string();
+    std::mt19937 gen(16);
+    std::uniform_real_distribution<double> coordinate(-9000, 9000), velocity(-7, 7);
+    std::vector<double> x(100), y(100), z(100), vx(100), vy(100), vz(100);
+    {
+        std::FILE *oem = std::fopen((dir + "/catalog_stream.oem").c_str(), "w");
+        ASSERT_NE(oem, nullptr);
+        std::fprintf(oem, "CCSDS_OEM_VERS = 2.0\nMETA_START\nOBJECT_NAME = TEST\nMETA_STOP\nCOMMENT data\n");
+        for (int k = 0; k < 100; k++) {
+            x[k] = coordinate(gen), y[k] = coordinate(gen), z[k] = coordinate(gen);
+            vx[k] = velocity(gen), vy[k] = velocity(gen), vz[k] = velocity(gen);
+            std::fprintf(oem, "2024-01-01T00:%02d:00.000 %.17g %.17g %.17g\t%.17g %.17g %.17g\n", k % 60, x[k], y[k],
+                         z[k], vx[k], vy[k], vz[k]);
+            if (k == 50) std::fprintf(oem, "COVARIANCE_START\n1.0e-3\n1.0e-4 2.0e-3\nCOVARIANCE_STOP\n");
+        }
+        std::fclose(oem);
+    }
+    std::vector<double> p(100), a(100), e(100), i(100), W(100), w(100), nu(100);
+    std::vector<int> flag(100);
+    RV2COE<double>({x, y, z, vx, vy, vz}, {p, a, e, i, W, w, nu, flag}, mu);
+
+    Thread_pool pool(4);
+    std::size_t next = 0;
+    std::size_t records = Convert_catalog(Mapped_file(dir + "/catalog_stream.oem"), Catalog_format::OEM, mu,
+                                          [&](const Catalog_chunk<double> &chunk) {
+        for (std::size_t k = 0; k < chunk.size; k++, next++) {
+            ASSERT_EQ(chunk.p[k], p[next]);
+            ASSERT_EQ(chunk.e[k], e[next]);
+            ASSERT_EQ(chunk.W[k], W[next]);
+            ASSERT_EQ(chunk.w[k], w[next]);
+            ASSERT_EQ(chunk.nu[k], nu[next]);
+            ASSERT_EQ(chunk.flag[k], flag[next]);
+        }
+    }, pool, 300);
+    ASSERT_EQ(records, 100);
+    ASSERT_EQ(next, 100);
+
+    {
+        std::FILE *tle = std::fopen((dir + "/catalog_stream.tle").c_str(), "w");
+        ASSERT_NE(tle, nullptr);
+        std::fprintf(tle, "ISS (ZARYA)\n"
+                          "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927\n"
+                          "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537\n");
+        std::fclose(tle);
+    }
+    {
+        COE_column_files<double> files(dir + "/catalog_stream");
+        records = Convert_catalog(Mapped_file(dir + "/catalog_stream.tle"), Catalog_format::TLE, mu,
+                                  [&](const Catalog_chunk<double> &chunk) {
+            ASSERT_EQ(chunk.size, 1);
+            ASSERT_EQ(chunk.flag[0], 2); // e < 0.1 is circular for RV2COE
+            ASSERT_NEAR(chunk.i[0], 51.6416 * M_PI / 180, 1e-9);
+            ASSERT_NEAR(chunk.W[0], 247.4627 * M_PI / 180, 1e-9);
+            ASSERT_NEAR(chunk.e[0], 0.0006703, 1e-9);
+            ASSERT_NEAR(chunk.a[0], 6730.96, 0.01);
+            files(chunk);
+        }, pool);
+    }
+    ASSERT_EQ(records, 1);
+    ASSERT_EQ(std::filesystem::file_size(dir + "/catalog_stream.a"), sizeof(double));
+    ASSERT_EQ(std::filesystem::file_size(dir + "/catalog_stream.flag"), sizeof(int));
+    ASSERT_THROW(Mapped_file(dir + "/catalog_stream.missing"), std::system_error);
+}
+
+/// Orbit catalog ///
+TEST(ORBITAL_MANEUVERS, ORBIT_CATALOG) {
+    /**
+     * Catalog file gives back the written columns, exactly for double storage and rounded for float one,
+     * wrong storage type, foreign files and headers with forged size are rejected
+     *
+     * @param random Keplerian elements columns of all types of orbits
+     * @return Orbit_catalog
+     */
+    const double mu = 398600.4415;
+    const std::string dir = std::filesystem::temp_directory_path().string();
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<double> value(0, 6);
+    const std::size_t n = 1000;
+    std::vector<double> p(n), a(n), e(n), i(n), W(n), w(n), nu(n);
+    std::vector<int> flag(n);
+    for (std::size_t k = 0; k < n; k++) {
+        for (std::vector<double> *column: {&p, &a, &e, &i, &W, &w, &nu}) (*column)[k] = value(gen);
+        flag[k] = 1 + k % 4;
+    }
+    const COE_columns<const double> elem{p, a, e, i, W, w, nu, flag};
+    Write_orbit_catalog<double>(dir + "/catalog.orb", elem, mu, 2460000.5);
+    Write_orbit_catalog<float>(dir + "/catalog32.orb", elem, mu);
+
+    Orbit_catalog<double> catalog(dir + "/catalog.orb");
+    ASSERT_EQ(catalog.size(), n);
+    ASSERT_EQ(catalog.mu(), mu);
+    ASSERT_EQ(catalog.epoch(), 2460000.5);
+    std::vector<int> flag_buffer;
+    COE_columns<const double> columns = catalog.columns(flag_buffer);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(columns.a.data()) % 64, 0);
+    Orbit_catalog<float> catalog32(dir + "/catalog32.orb");
+    for (std::size_t k = 0; k < n; k++) {
+        ASSERT_EQ(columns.p[k], p[k]);
+        ASSERT_EQ(columns.nu[k], nu[k]);
+        ASSERT_EQ(columns.flag[k], flag[k]);
+        COE<double> expected = get_COE(elem, k, mu), actual = catalog[k];
+        ASSERT_EQ(actual.flag, expected.flag);
+        ASSERT_EQ(actual.W, expected.W);
+        ASSERT_EQ(actual.u, expected.u);
+        ASSERT_EQ(catalog32.e()[k], float(e[k]));
+        ASSERT_EQ(catalog32.flag()[k], flag[k]);
+    }
+    ASSERT_THROW(Orbit_catalog<float>(dir + "/catalog.orb"), std::runtime_error);
+    {
+        std::FILE *file = std::fopen((dir + "/catalog_foreign.orb").c_str(), "w");
+        ASSERT_NE(file, nullptr);
+        std::fprintf(file, "not a catalog, but long enough to hold a header of the catalog file, 64 bytes\n");
+        std::fclose(file);
+    }
+    ASSERT_THROW(Orbit_catalog<double>(dir + "/catalog_foreign.orb"), std::runtime_error);
+
+    // header of a valid catalog with size, for which the padded columns wrap around to 0 bytes, and no columns
+    {
+        Orbit_catalog_header header{};
+        std::FILE *in = std::fopen((dir + "/catalog.orb").c_str(), "rb");
+        ASSERT_NE(in, nullptr);
+        ASSERT_EQ(std::fread(&header, sizeof(header), 1, in), 1);
+        std::fclose(in);
+        header.size = std::numeric_limits<std::uint64_t>::max();
+        std::FILE *file = std::fopen((dir + "/catalog_forged.orb").c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        std::fwrite(&header, sizeof(header), 1, file);
+        std::fclose(file);
+    }
+    ASSERT_THROW(Orbit_catalog<double>(dir + "/catalog_forged.orb"), std::runtime_error);
+}
+
+/// Automatic differentiation ///
+TEST(ORBITAL_MANEUVERS, AUTOMATIC_DIFFERENTIATION) {
+    /**
+     * Gradients of delta-v of COE and Prepared_orbit maneuvers by dual numbers agree with central finite differences,
+     * values agree with double
+     *
+     * @param random pairs of elliptic inclined orbits
+     * @return delta-v and derivatives with respect to a, e, i, W, w, nu of both orbits
+     */
+    std::mt19937 gen(24);
+    const Orbit_ranges ranges{.radius_min = 7000, .radius_max = 30000, .ecc_min = 0.05, .ecc_max = 0.5,
+                              .incl_min = 0.2, .incl_max = 2.8, .angle_min = 0.2, .angle_max = 2 * M_PI - 0.2};
+    // element j of a, e, i, W, w, nu shifted by h, dependent elements follow
+    auto shifted = [](COE<double> elem, int j, double h) {
+        double *variables[6] = {&elem.a, &elem.e, &elem.i, &elem.W, &elem.w, &elem.nu};
+        *variables[j] += h;
+        elem.p = elem.a * (1 - elem.e * elem.e);
+        elem.u = elem.w + elem.nu;
+        elem.lam_true = elem.W + elem.w + elem.nu;
+        elem.w_true = elem.W + elem.w;
+        return elem;
+    };
+    auto check = [&](auto &&function, const COE<double> &initial, const COE<double> &final) {
+        const auto [delta_v, gradient] = Delta_v_gradient(function, initial, final);
+        ASSERT_NEAR(delta_v, function(initial, final), 1e-12 * std::abs(delta_v) + 1e-14);
+        for (int j = 0; j < 12; j++) {
+            const double h = j % 6 == 0 ? 1e-4 * (j < 6 ? initial.a : final.a) : 1e-6;
+            const double fd = j < 6 ? (function(shifted(initial, j, h), final) -
+                                       function(shifted(initial, j, -h), final)) / (2 * h) :
+                              (function(initial, shifted(final, j - 6, h)) -
+                               function(initial, shifted(final, j - 6, -h))) / (2 * h);
+            const double scale = j % 6 == 0 ? 1e-5 / (j < 6 ? initial.a : final.a) : 1e-5;
+            ASSERT_NEAR(gradient[j], fd, scale * (1 + std::abs(delta_v))) << "derivative " << j;
+        }
+    };
+
+    auto hohmann = [](const auto &a, const auto &b) { return Hohmann_transfer(a, b); };
+    auto edelbaum = [](const auto &a, const auto &b) { return Edelbaum_transfer(a, b); };
+    auto two_impulse = [](const auto &a, const auto &b) { return Two_impulse_transfer_elliptic_orbits(a, b); };
+    auto inclination = [](const auto &a, const auto &b) { return Inclination_only_transfer(a, b); };
+    auto plane_change = [](auto a, const auto &b) { return std::get<0>(General_plane_change(a, b)); };
+    auto speed = [](const auto &a, const auto &b) { return norm(COE2RV(a).second - COE2RV(b).second); };
+    // maneuvers of Prepared_orbit, that the planner and the cost matrix use
+    auto prepared = [](auto &&maneuver) {
+        return [maneuver](const auto &a, const auto &b) {
+            using T = std::decay_t<decltype(a.a)>;
+            return maneuver(Prepared_orbit<T>(a), Prepared_orbit<T>(b));
+        };
+    };
+    auto burns = prepared([](const auto &a, const auto &b) { return Two_impulse_burns(a, b); });
+    auto prepared_edelbaum = prepared([](const auto &a, const auto &b) { return Edelbaum_transfer(a, b); });
+    auto prepared_plane_change = prepared([](const auto &a, const auto &b) {
+        return std::get<0>(General_plane_change(a, b));
+    });
+    for (int k = 0; k < 50; k++) {
+        const COE<double> initial = random_elliptic_orbit(gen, ranges), final = random_elliptic_orbit(gen, ranges);
+        check(hohmann, initial, final);
+        check(edelbaum, initial, final);
+        check(two_impulse, initial, final);
+        check(inclination, initial, final);
+        check(plane_change, initial, final);
+        check(speed, initial, final);
+        check(burns, initial, final);
+        check(prepared_edelbaum, initial, final);
+        check(prepared_plane_change, initial, final);
+    }
+
+    // derivatives of elements, found from RV vectors, recover the seeded variables
+    const COE<double> elem = random_elliptic_orbit(gen, ranges);
+    const auto [r, v] = COE2RV(COE_variables<6>(elem, 0));
+    const COE<Dual<double, 6>> back = RV2COE(r, v, Dual<double, 6>(elem.mu));
+    const Dual<double, 6> variables[6] = {back.a, back.e, back.i, back.W, back.w, back.nu};
+    for (int j = 0; j < 6; j++)
+        for (int c = 0; c < 6; c++) ASSERT_NEAR(variables[j].grad[c], j == c, 1e-9);
+}
+
+/// Constant evaluation ///
+TEST(ORBITAL_MANEUVERS, CONSTANT_EVALUATION) {
+    /**
+     * Reference orbits give delta-v and RV vectors at compile time, which agree with run-time results,
+     * and a table of them is a constant
+     *
+     * @param Keplerian elements of LEO, SSO, GEO and Molniya orbits
+     * @return delta-v, RV vectors
+     */
+    constexpr double mu = 398600.4415, R = 6378.137;
+    constexpr COE<double> leo{R + 191.3441, R + 191.3441, 0, 0, 10, 10, 10, 10, 0, 10, mu, 1};
+    constexpr COE<double> sso{R + 700, R + 700, 0, 1.7202, 0.4, 10, 10, 1.2, 10, 10, mu, 2};
+    constexpr COE<double> geo{R + 35781.34857, R + 35781.34857, 0, 0, 10, 10, 10, 10, 2.5, 10, mu, 1};
+    constexpr COE<double> moon{R + 376310, R + 376310, 0, 0, 10, 10, 10, 10, 0, 10, mu, 1};
+    constexpr double e = 0.74, a = 26554;
+    constexpr COE<double> molniya{a * (1 - e * e), a, e, 1.1071, 5.2, 4.7124, 3.5, 10, 10, 10, mu, 4};
+
+    constexpr double hohmann = Hohmann_transfer(leo, geo);
+    static_assert(hohmann > 3.935224 - 1e-6 && hohmann < 3.935224 + 1e-6);
+    constexpr double bi_elliptic = Bi_elliptic_transfer_circular_orbits(leo, moon, R + 503873);
+    static_assert(bi_elliptic > 3.904057 - 1e-6 && bi_elliptic < 3.904057 + 1e-6);
+
+    // radius and energy of RV vectors found at compile time
+    constexpr auto molniya_rv = COE2RV(molniya);
+    constexpr double r = norm(molniya_rv.first), v = norm(molniya_rv.second);
+    constexpr double cos_nu = constexpr_math::cos(molniya.nu);
+    static_assert(constexpr_math::abs(r - molniya.p / (1 + e * cos_nu)) < 1e-9 * r);
+    static_assert(constexpr_math::abs(v * v / 2 - mu / r + mu / (2 * a)) < 1e-12 * mu / a);
+    static_assert(constexpr_math::abs(molniya_rv.first[2] - r * constexpr_math::sin(molniya.i) *
+                                      constexpr_math::sin(molniya.w + molniya.nu)) < 1e-9 * r);
+
+    static constexpr std::array<COE<double>, 5> orbits{leo, sso, geo, moon, molniya};
+    static constexpr auto table = [] {
+        std::array<std::pair<Vec3<double>, Vec3<double>>, 5> rv{};
+        for (std::size_t k = 0; k < orbits.size(); k++) rv[k] = COE2RV(orbits[k]);
+        return rv;
+    }();
+
+    // the same functions at run time call std functions
+    for (std::size_t k = 0; k < orbits.size(); k++) {
+        const COE<double> elem = orbits[k];
+        const auto [r_runtime, v_runtime] = COE2RV(elem);
+        for (int c = 0; c < 3; c++) {
+            ASSERT_NEAR(table[k].first[c], r_runtime[c], 1e-14 * norm(r_runtime));
+            ASSERT_NEAR(table[k].second[c], v_runtime[c], 1e-14 * norm(v_runtime));
+        }
+    }
+    COE<double> leo_ = leo;
+    ASSERT_NEAR(hohmann, Hohmann_transfer(leo_, geo), 1e-15 * hohmann);
+    ASSERT_NEAR(bi_elliptic, Bi_elliptic_transfer_circular_orbits(leo_, moon, R + 503873), 1e-15 * bi_elliptic);
+
+    constexpr float hohmann_float = Hohmann_transfer(COE_cast<float>(leo), COE_cast<float>(geo));
+    ASSERT_NEAR(hohmann_float, Hohmann_transfer(COE_cast<float>(leo_), COE_cast<float>(geo)), 1e-6);
+}
+
+/// Float precision ///
+TEST(ORBITAL_MANEUVERS, FLOAT_PRECISION) {
+    /**
+     * Maneuvers in float agree with double within bounds of float precision on a random population, plane change
+     * between close planes keeps its precision, float SIMD COE2RV agrees with scalar float COE2RV
+     *
+     * @param random pairs of elliptic inclined orbits, pairs with planes 1e-4 rad apart
+     * @return Precision_report
+     */
+    std::mt19937 gen(18);
+    std::uniform_real_distribution<double> angle(0, 2 * M_PI);
+    std::vector<COE<double>> initial, final, close;
+    for (int k = 0; k < 1000; k++) {
+        initial.push_back(random_elliptic_orbit(gen));
+        final.push_back(random_elliptic_orbit(gen));
+        close.push_back(initial.back());
+        close.back().i += 1e-4;
+        close.back().nu = angle(gen);
+    }
+
+    auto hohmann = [](auto &a, auto &b) { return Hohmann_transfer(a, b); };
+    auto two_impulse = [](auto &a, auto &b) { return Two_impulse_transfer_elliptic_orbits(a, b); };
+    auto plane_change = [](auto &a, auto &b) { return std::get<0>(General_plane_change(a, b)); };
+    auto combined = [](auto &a, auto &b) { return Combined_transfer(a, b).delta_v; };
+    ASSERT_LT(Compare_precision<float>(initial, final, hohmann).max_abs_error, 1e-5); // km/s
+    ASSERT_LT(Compare_precision<float>(initial, final, two_impulse).max_abs_error, 1e-4);
+    ASSERT_LT(Compare_precision<float>(initial, final, plane_change).max_rel_error, 1e-5);
+    ASSERT_LT(Compare_precision<float>(initial, close, plane_change).max_rel_error, 1e-2); // acos in float: ~1
+    ASSERT_LT(Compare_precision<float>(initial, final, combined).max_rel_error, 1e-4);
+
+    const std::size_t n = 1003;
+    std::vector<float> p(n), a(n), e(n), i(n), W(n), w(n), nu(n);
+    std::vector<int> flag(n, 4);
+    for (std::size_t k = 0; k < n; k++) {
+        COE<float> elem = COE_cast<float>(random_elliptic_orbit(gen));
+        p[k] = elem.p, a[k] = elem.a, e[k] = elem.e, i[k] = elem.i, W[k] = elem.W, w[k] = elem.w, nu[k] = elem.nu;
+    }
+    std::vector<std::vector<float>> rv(6, std::vector<float>(n)), rv_simd(6, std::vector<float>(n));
+    const COE_columns<const float> elem{p, a, e, i, W, w, nu, flag};
+    COE2RV<float>(elem, {rv[0], rv[1], rv[2], rv[3], rv[4], rv[5]}, 398600.4415f);
+    COE2RV_simd<float>(elem, {rv_simd[0], rv_simd[1], rv_simd[2], rv_simd[3], rv_simd[4], rv_simd[5]}, 398600.4415f);
+    for (std::size_t k = 0; k < n; k++) {
+        for (int c = 0; c < 3; c++) ASSERT_NEAR(rv_simd[c][k], rv[c][k], 1e-5 * p[k]);
+        for (int c = 3; c < 6; c++) ASSERT_NEAR(rv_simd[c][k], rv[c][k], 1e-5 * std::sqrt(398600.4415 / p[k]) * 3);
+    }
+}
+
+/// Heap allocations ///
+TEST(ORBITAL_MANEUVERS, ZERO_ALLOCATIONS_PER_DELTA_V) {
+    /**
+     * Conversions and maneuvers work on stack-allocated Vec3, so a delta-v evaluation does no heap allocations
+     *
+     * @param Keplerian elements
+     * @return number of allocations
+     */
+    COE<double> elem1;
+    elem1.nu = 10 * M_PI / 180;
+    elem1.e = 0.2;
+    elem1.p = 10320 * (1 - elem1.e);
+    elem1.a = 10320 / (1 + elem1.e);
+    elem1.i = 30 * M_PI / 180;
+    elem1.flag = 4;
+    elem1.w = 15 * M_PI / 180;
+    elem1.W = 45 * M_PI / 180;
+    elem1.mu = 398600.4415;
+
+    COE<double> elem2 = elem1;
+    elem2.nu = 50 * M_PI / 180;
+    elem2.p = 10320 * 18.98 * (1 - elem1.e);
+    elem2.a = 10320 * 18.98 / (1 + elem1.e);
+    elem2.i = 45 * M_PI / 180;
+
+    Vec3<double> r{6524.834, 6862.875, 6448.296};
+    Vec3<double> v{4.901327, 5.533756, -1.976341};
+
+    std::size_t before = allocation_count();
+    double sum = 0;
+    COE<double> elem = RV2COE(r, v, elem1.mu);
+    sum += elem.a;
+    auto [r1, v1] = COE2RV(elem1);
+    sum += r1[0] + v1[0];
+    sum += Hohmann_transfer(elem1, elem2);
+    sum += Bi_elliptic_transfer_circular_orbits(elem1, elem2, 3 * elem2.a);
+    sum += Bi_elliptic_transfer_elliptic_orbits(elem1, elem2, 2 * 10320 * 18.98);
+    sum += Two_impulse_transfer_elliptic_orbits(elem1, elem2);
+    sum += Inclination_only_transfer(elem1, elem2);
+    auto [delta_v, r2, v2] = General_plane_change(elem1, elem2);
+    sum += delta_v;
+    std::size_t after = allocation_count();
+
+    ASSERT_EQ(after - before, 0);
+    ASSERT_TRUE(std::isfinite(sum));
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();